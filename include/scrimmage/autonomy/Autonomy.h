@@ -40,6 +40,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace scrimmage {
 
@@ -47,8 +48,30 @@ class Autonomy : public EntityPlugin {
  public:
     Autonomy();
 
+    /// @brief Copy for clone(). The copy has its own desired state.
+    Autonomy(const Autonomy &other);
+
     std::string type() override;
     virtual bool step_autonomy(double t, double dt);
+
+    /**
+     * @brief Whether step_autonomy_batch() steps several autonomies at once.
+     *
+     * SimControl groups the autonomies that support batching by type and
+     * calls step_autonomy_batch() on one autonomy of each group instead of
+     * calling step_autonomy() on every autonomy. The groups step before the
+     * other autonomies.
+     */
+    virtual bool supports_batch() { return false; }
+
+    /**
+     * @brief Step all of the autonomies, which have the same type as this
+     * one and whose loop timers have fired.
+     *
+     * The default calls step_autonomy() on each autonomy.
+     */
+    virtual bool step_autonomy_batch(const std::vector<Autonomy *> &autonomies,
+                                     double t, double dt);
     virtual bool posthumous(double t);
     virtual void init();
     bool ready() override { return true; }
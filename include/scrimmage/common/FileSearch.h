@@ -33,10 +33,12 @@
 #ifndef INCLUDE_SCRIMMAGE_COMMON_FILESEARCH_H_
 #define INCLUDE_SCRIMMAGE_COMMON_FILESEARCH_H_
 
+#include <cstdint>
 #include <unordered_map>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace boost {
 template <class T> class optional;
@@ -63,7 +65,43 @@ class FileSearch {
         std::unordered_map<std::string, std::list<std::string>> &out,
         bool verbose = false);
 
+    /**
+     * @brief Set the directory of the on-disk file index
+     * (default: ~/.scrimmage/index). An empty directory disables the index.
+     *
+     * The files found under a search path are saved in the index with the
+     * modification times of the directories that were searched. Later
+     * searches, including the ones of other processes, use the index instead
+     * of searching the directories again until one of the directories is
+     * changed.
+     */
+    void set_index_dir(const std::string &index_dir);
+
  protected:
+    // The cached files for env_var and ext, searched for on the first call
+    std::unordered_map<std::string, std::list<std::string>> &
+    cached_files(const std::string &env_var, const std::string &ext,
+                 bool verbose);
+
+    // A directory that was searched and its modification time in nanoseconds
+    // (-1 if it didn't exist)
+    struct IndexDir {
+        std::string path;
+        int64_t mtime;
+        bool root;
+    };
+
+    std::string index_filename(const std::string &key,
+                               const std::string &ext);
+    bool load_index(const std::string &key, const std::string &ext,
+                    bool print_missing,
+                    std::unordered_map<std::string, std::list<std::string>> &files);
+    void save_index(const std::string &key, const std::string &ext,
+                    const std::vector<IndexDir> &dirs,
+                    const std::list<std::string> &paths);
+
+    std::string index_dir_ = "~/.scrimmage/index";
+
     // cache_[env_var][ext][filename] = list of full paths to files with that filename
     std::unordered_map<std::string,
         std::unordered_map<std::string,
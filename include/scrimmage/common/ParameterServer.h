@@ -38,6 +38,8 @@
 #include <string>
 #include <unordered_map>
 #include <set>
+#include <vector>
+#include <utility>
 #include <tuple>
 #include <memory>
 #include <iostream>
@@ -58,8 +60,12 @@ class ParameterServer {
     bool register_param(const std::string &name, T &variable,
                         std::function<void(const T &value)> callback,
                         PluginPtr owner) {
-        auto it = params_[name][typeid(T).name()].emplace(
+        auto &param_set = params_[name][typeid(T).name()];
+        auto it = param_set.emplace(
             std::make_shared<Parameter<T>>(variable, callback, owner));
+        if (it.second) {
+            owned_params_[owner.get()].emplace_back(&param_set, *it.first);
+        }
         return it.second; // return false if the param already exists
     }
 
@@ -111,6 +117,12 @@ class ParameterServer {
     // Value: Set of ParameterBasePtr
     std::unordered_map<std::string,
         std::unordered_map<std::string, std::set<ParameterBasePtr>>> params_;
+
+    // The parameters registered by each plugin, so that unregistering a
+    // plugin's parameters doesn't search every parameter set. The set
+    // pointers stay valid because unordered_map doesn't move its values.
+    std::unordered_map<Plugin *, std::vector<std::pair<
+        std::set<ParameterBasePtr> *, ParameterBasePtr>>> owned_params_;
 };
 using ParameterServerPtr = std::shared_ptr<ParameterServer>;
 } // namespace scrimmage
@@ -34,6 +34,7 @@
 #define INCLUDE_SCRIMMAGE_COMMON_RTREE_H_
 
 #include <scrimmage/common/ID.h>
+#include <scrimmage/common/SpatialIndex.h>
 
 #include <Eigen/Dense>
 
@@ -42,15 +43,18 @@
 #include <memory>
 #include <functional>
 #include <utility>
+#include <unordered_map>
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/geometry/index/detail/exception.hpp>
 #include <boost/geometry/core/cs.hpp>
-#include <boost/geometry/index/parameters.hpp> // for dynamic_rstar definition
 #include <boost/geometry/geometries/point.hpp> // for model::point
 #include <boost/geometry/index/indexable.hpp>
+#include <boost/geometry/index/equal_to.hpp>
 
 namespace boost { namespace geometry { namespace index {
+// boost/geometry/index/parameters.hpp
+class dynamic_rstar;
 // boost/geometry/index/rtree.hpp
 template <typename T1, typename T2, typename T3, typename T4, typename T5> class rtree;
 }}}
@@ -63,16 +67,41 @@ typedef boost::geometry::index::rtree<
     point_id_t,
     boost::geometry::index::dynamic_rstar,
     boost::geometry::index::indexable<point_id_t>,
-    std::equal_to<point_id_t>,
+    boost::geometry::index::equal_to<point_id_t>,
     std::allocator<point_id_t>> rtree_t;
 
 typedef std::shared_ptr<rtree_t> rtreePtr;
 
 class RTree {
  public:
+    /**
+     * @brief How update() synchronizes the tree with the entity positions.
+     *
+     * REBUILD packs a new tree from all of the entries in a single pass.
+     * MOVE keeps the existing tree and only relocates entries whose position
+     * changed, removing entries that are no longer present.
+     */
+    enum class UpdateMode {REBUILD, MOVE};
+
     void init(const unsigned int& size);
 
+    /**
+     * @brief Replace the boost rtree with another neighbor index.
+     *
+     * All of the updates and queries are forwarded to the given index. Passing
+     * nullptr restores the boost rtree.
+     */
+    void set_index(const SpatialIndexPtr &index);
+    SpatialIndexPtr index() const;
+
+    void set_update_mode(const UpdateMode &mode);
+    UpdateMode update_mode() const;
+
     void add(const Eigen::Vector3d &pos, const ID &id);
+    void remove(const ID &id);
+    void update(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries);
+    unsigned int size() const;
+
     void nearest_n_neighbors(const Eigen::Vector3d &pos,
                              std::vector<ID> &neighbors, unsigned int n,
                              int self_id = -1, int team_id = -1) const;
@@ -81,9 +110,21 @@ class RTree {
                             int self_id = -1, int team_id = -1) const;
  protected:
     void clear();
+    void insert(const point_id_t &entry);
+    void erase(const point_id_t &entry);
+    bool has_team(int team_id) const;
+
+    struct Entry {
+        point_id_t value;
+        unsigned int stamp = 0;
+    };
 
     rtreePtr rtree_ = nullptr;
-    std::map<int, rtreePtr> rtree_team_;
+    SpatialIndexPtr index_ = nullptr;
+    std::unordered_map<int, Entry> entries_;
+    std::unordered_map<int, int> team_counts_;
+    UpdateMode update_mode_ = UpdateMode::REBUILD;
+    unsigned int stamp_ = 0;
     int size_ = 0;
 };
 
@@ -62,6 +62,9 @@ class Random {
     std::shared_ptr<std::default_random_engine> gener()
     { return gener_; }
 
+    /// @brief Copy the seed, generator and distribution states of other.
+    void copy_state(const Random &other);
+
  protected:
     uint32_t seed_;
     std::shared_ptr<std::default_random_engine> gener_;
@@ -0,0 +1,135 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_COMMON_RINGBUFFER_H_
+#define INCLUDE_SCRIMMAGE_COMMON_RINGBUFFER_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace scrimmage {
+
+/*! \brief A growable FIFO queue stored in a single contiguous array.
+ *
+ * The capacity is always a power of two so that wrapping is a mask instead
+ * of a modulo. Popped slots are reset so that shared_ptr elements release
+ * their payload immediately, but the storage itself is kept and reused on
+ * the next push, which means a queue that reaches a steady state never
+ * allocates again.
+ */
+template <class T>
+class RingBuffer {
+ public:
+    RingBuffer() = default;
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return buf_.size(); }
+
+    T &front() { return buf_[head_]; }
+    const T &front() const { return buf_[head_]; }
+
+    T &operator[](std::size_t i) { return buf_[(head_ + i) & mask()]; }
+    const T &operator[](std::size_t i) const { return buf_[(head_ + i) & mask()]; }
+
+    void push_back(const T &value) {
+        reserve_one();
+        buf_[(head_ + size_) & mask()] = value;
+        ++size_;
+    }
+
+    void push_back(T &&value) {
+        reserve_one();
+        buf_[(head_ + size_) & mask()] = std::move(value);
+        ++size_;
+    }
+
+    void pop_front() {
+        buf_[head_] = T();
+        head_ = (head_ + 1) & mask();
+        --size_;
+    }
+
+    /*! \brief Remove the n oldest elements (or all of them if n > size()). */
+    void drop_front(std::size_t n) {
+        if (n >= size_) {
+            clear();
+            return;
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            pop_front();
+        }
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < size_; i++) {
+            buf_[(head_ + i) & mask()] = T();
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+    /*! \brief Move every element, oldest first, onto the end of out and
+     * leave the buffer empty. */
+    template <class Container>
+    void drain(Container &out) {
+        for (std::size_t i = 0; i < size_; i++) {
+            out.push_back(std::move(buf_[(head_ + i) & mask()]));
+            buf_[(head_ + i) & mask()] = T();
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+ protected:
+    std::size_t mask() const { return buf_.size() - 1; }
+
+    void reserve_one() {
+        if (size_ < buf_.size()) {
+            return;
+        }
+        std::vector<T> bigger(buf_.empty() ? 8 : buf_.size() * 2);
+        for (std::size_t i = 0; i < size_; i++) {
+            bigger[i] = std::move(buf_[(head_ + i) & mask()]);
+        }
+        buf_.swap(bigger);
+        head_ = 0;
+    }
+
+    std::vector<T> buf_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_COMMON_RINGBUFFER_H_
@@ -0,0 +1,104 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_COMMON_SPATIALHASH_H_
+#define INCLUDE_SCRIMMAGE_COMMON_SPATIALHASH_H_
+
+#include <scrimmage/common/ID.h>
+#include <scrimmage/common/SpatialIndex.h>
+
+#include <Eigen/Dense>
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <unordered_map>
+
+namespace scrimmage {
+
+/**
+ * @brief Uniform grid (cell list) neighbor index.
+ *
+ * Entities are hashed into cubic cells of side length cell_size. A range
+ * query only visits the cells overlapping the query sphere, so queries are
+ * cheapest when cell_size is close to the query radius. Building the grid is
+ * a single hash insertion per entity.
+ */
+class SpatialHash : public SpatialIndex {
+ public:
+    explicit SpatialHash(double cell_size = 100.0);
+
+    void set_cell_size(double cell_size);
+    double cell_size() const;
+
+    void init(const unsigned int &size) override;
+    void add(const Eigen::Vector3d &pos, const ID &id) override;
+    void remove(const ID &id) override;
+    void update(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries) override;
+    unsigned int size() const override;
+
+    void nearest_n_neighbors(const Eigen::Vector3d &pos,
+                             std::vector<ID> &neighbors, unsigned int n,
+                             int self_id = -1, int team_id = -1) const override;
+    void neighbors_in_range(const Eigen::Vector3d &pos,
+                            std::vector<ID> &neighbors, double dist,
+                            int self_id = -1, int team_id = -1) const override;
+
+ protected:
+    struct Item {
+        Eigen::Vector3d pos;
+        ID id;
+    };
+    typedef std::vector<Item> Cell;
+
+    int64_t coord(double x) const;
+    uint64_t key(int64_t x, int64_t y, int64_t z) const;
+    void insert(const Eigen::Vector3d &pos, const ID &id);
+    void clear();
+
+    // Key: packed cell coordinates. The cells are kept after being emptied so
+    // that their storage is reused by the next update.
+    std::unordered_map<uint64_t, Cell> cells_;
+
+    // Key: entity ID, Value: key of the cell containing the entity
+    std::unordered_map<int, uint64_t> id_to_cell_;
+
+    double cell_size_ = 100.0;
+    double inv_cell_size_ = 0.01;
+    unsigned int size_ = 0;
+};
+
+typedef std::shared_ptr<SpatialHash> SpatialHashPtr;
+}  // namespace scrimmage
+
+#endif // INCLUDE_SCRIMMAGE_COMMON_SPATIALHASH_H_
@@ -0,0 +1,75 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_COMMON_SPATIALINDEX_H_
+#define INCLUDE_SCRIMMAGE_COMMON_SPATIALINDEX_H_
+
+#include <scrimmage/common/ID.h>
+
+#include <Eigen/Dense>
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace scrimmage {
+
+/**
+ * @brief Interface for the neighbor queries used by RTree.
+ *
+ * An implementation can be installed with RTree::set_index() to replace the
+ * boost rtree that RTree uses by default. The queries have the same semantics
+ * as the RTree queries: self_id is excluded from the results and team_id
+ * restricts the results to a single team (-1 disables either filter).
+ */
+class SpatialIndex {
+ public:
+    virtual ~SpatialIndex() {}
+
+    virtual void init(const unsigned int &size) = 0;
+    virtual void add(const Eigen::Vector3d &pos, const ID &id) = 0;
+    virtual void remove(const ID &id) = 0;
+    virtual void update(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries) = 0;
+    virtual unsigned int size() const = 0;
+
+    virtual void nearest_n_neighbors(const Eigen::Vector3d &pos,
+                                     std::vector<ID> &neighbors, unsigned int n,
+                                     int self_id = -1, int team_id = -1) const = 0;
+    virtual void neighbors_in_range(const Eigen::Vector3d &pos,
+                                    std::vector<ID> &neighbors, double dist,
+                                    int self_id = -1, int team_id = -1) const = 0;
+};
+
+typedef std::shared_ptr<SpatialIndex> SpatialIndexPtr;
+}  // namespace scrimmage
+
+#endif // INCLUDE_SCRIMMAGE_COMMON_SPATIALINDEX_H_
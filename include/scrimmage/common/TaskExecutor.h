@@ -0,0 +1,117 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_COMMON_TASKEXECUTOR_H_
+#define INCLUDE_SCRIMMAGE_COMMON_TASKEXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scrimmage {
+
+/**
+ * @brief Fork-join executor for data parallel loops.
+ *
+ * parallel_for splits an index range into chunks and deals them out to
+ * per-thread deques. Each thread takes chunks from the front of its own
+ * deque and, once that is empty, steals from the back of the others. The
+ * deques are single atomic words, so taking a chunk never locks. The calling
+ * thread works alongside the pool and returns once every chunk is done.
+ */
+class TaskExecutor {
+ public:
+    /// func(begin, end) processes the indices in [begin, end)
+    typedef std::function<void(size_t, size_t)> RangeFunc;
+
+    /// @param num_threads total number of threads, including the caller
+    explicit TaskExecutor(int num_threads = 1);
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor &) = delete;
+    TaskExecutor &operator=(const TaskExecutor &) = delete;
+
+    int num_threads() const;
+
+    /**
+     * @brief Run func over [0, size) and wait for it to finish.
+     *
+     * @param grain the number of indices per chunk. The default gives each
+     * thread several chunks so that uneven work can be stolen.
+     *
+     * Calls from inside a running func execute serially on the calling
+     * thread.
+     */
+    void parallel_for(size_t size, const RangeFunc &func, size_t grain = 0);
+
+ protected:
+    // A deque of chunk indices packed as (begin << 32 | end). Padded so that
+    // the ranges of neighboring deques are at least a cache line apart.
+    // (operator new[] doesn't honor alignas(64) before C++17.)
+    struct Deque {
+        std::atomic<uint64_t> range{0};
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    void worker(int index);
+    void run_chunks(int index, const RangeFunc &func, size_t size, size_t grain);
+    bool pop(int index, uint64_t &chunk);
+    bool steal(int index, uint64_t &chunk);
+
+    int num_threads_ = 1;
+    std::vector<std::thread> threads_;
+    std::unique_ptr<Deque[]> deques_;
+
+    std::mutex job_mutex_;
+
+    // The current job, published under mutex_
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    uint64_t epoch_ = 0;
+    bool stop_ = false;
+    const RangeFunc *func_ = nullptr;
+    size_t size_ = 0;
+    size_t grain_ = 1;
+
+    std::atomic<uint64_t> chunks_left_{0};
+    std::atomic<int> active_workers_{0};
+};
+
+typedef std::shared_ptr<TaskExecutor> TaskExecutorPtr;
+} // namespace scrimmage
+
+#endif // INCLUDE_SCRIMMAGE_COMMON_TASKEXECUTOR_H_
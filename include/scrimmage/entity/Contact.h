@@ -80,6 +80,7 @@ class Contact {
     std::unordered_map<std::string, MessageBasePtr> &properties() {return properties_;}
     void set_id(const ID &id);
     ID &id();
+    const ID &id() const;
 
     void set_state(StatePtr &state);
     StatePtr &state();
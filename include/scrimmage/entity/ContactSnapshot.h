@@ -0,0 +1,87 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_ENTITY_CONTACTSNAPSHOT_H_
+#define INCLUDE_SCRIMMAGE_ENTITY_CONTACTSNAPSHOT_H_
+
+#include <scrimmage/entity/Contact.h>
+#include <scrimmage/math/Quaternion.h>
+
+#include <Eigen/Dense>
+
+#include <memory>
+#include <vector>
+
+namespace scrimmage {
+
+/**
+ * @brief Read-only copy of the contact states, stored as arrays.
+ *
+ * SimControl refreshes the snapshot before the autonomies and before the
+ * sensors run and leaves it untouched while they run. Plugins can read it
+ * from any thread without locking and without creating entries in the
+ * ContactMap. Contacts are stored in increasing ID order.
+ */
+class ContactSnapshot {
+ public:
+    /// @brief Copy the states of all contacts with a valid state
+    void update(const ContactMap &contacts);
+
+    size_t size() const { return ids_.size(); }
+
+    /// @brief Index of the contact with the given entity ID, -1 if absent
+    int index(int id) const {
+        return id >= 0 && id < static_cast<int>(id_to_index_.size()) ?
+            id_to_index_[id] : -1;
+    }
+
+    const std::vector<int> &ids() const { return ids_; }
+    const std::vector<int> &team_ids() const { return team_ids_; }
+    const std::vector<Eigen::Vector3d> &pos() const { return pos_; }
+    const std::vector<Eigen::Vector3d> &vel() const { return vel_; }
+    const std::vector<Quaternion> &quat() const { return quat_; }
+
+ protected:
+    std::vector<int> ids_;
+    std::vector<int> team_ids_;
+    std::vector<Eigen::Vector3d> pos_;
+    std::vector<Eigen::Vector3d> vel_;
+    std::vector<Quaternion> quat_;
+
+    // Indexed by entity ID. Entity IDs are assigned sequentially, so the
+    // table stays close to the number of contacts.
+    std::vector<int> id_to_index_;
+};
+
+using ContactSnapshotPtr = std::shared_ptr<const ContactSnapshot>;
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_ENTITY_CONTACTSNAPSHOT_H_
@@ -84,6 +84,23 @@ class Entity : public std::enable_shared_from_this<Entity> {
               std::function<void(std::map<std::string, std::string>&)> param_override_func,
               const int& debug_level = 0);
 
+    /**
+     * @brief Copy this entity's plugins with EntityPlugin::clone() into an
+     * entity that isn't part of the simulation. Returns nullptr if one of the
+     * plugins can't be cloned.
+     */
+    EntityPtr make_prototype();
+
+    /**
+     * @brief Initialize the entity from a prototype of the same entity block
+     * made by make_prototype(). Only the ID and the initial state are read
+     * from info; the plugins are copied from the prototype and their
+     * init_instance() is called instead of init().
+     */
+    bool init_from_prototype(const EntityPtr &prototype,
+                             std::map<std::string, std::string> &info,
+                             int id);
+
     void print_plugins(std::ostream &out) const;
 
     bool parse_visual(std::map<std::string, std::string> &info,
@@ -176,6 +193,7 @@ class Entity : public std::enable_shared_from_this<Entity> {
     bool active();
 
     ContactMapPtr &contacts() { return contacts_; }
+    ContactSnapshotPtr &contact_snapshot() { return contact_snapshot_; }
     RTreePtr &rtree() { return rtree_; }
 
     PluginManagerPtr & plugin_manager() {
@@ -226,15 +244,18 @@ class Entity : public std::enable_shared_from_this<Entity> {
     std::unordered_map<std::string, SensorPtr> sensors_;
 
     bool active_ = true;
+    bool connect_entity_ = true;
     bool visual_changed_ = false;
     std::unordered_map<std::string, Service> services_;
 
     ContactMapPtr contacts_;
+    ContactSnapshotPtr contact_snapshot_;
     RTreePtr rtree_;
 
     double radius_ = 1;
 
     void print(const std::string &msg);
+    void init_state(std::map<std::string, std::string> &info);
     PluginManagerPtr plugin_manager_;
     FileSearchPtr file_search_;
     PubSubPtr pubsub_;
@@ -41,6 +41,8 @@
 #include <scrimmage/pubsub/PubSub.h>
 #include <scrimmage/pubsub/Subscriber.h>
 
+#include <boost/any.hpp>
+
 #include <unordered_set>
 #include <unordered_map>
 #include <memory>
@@ -70,6 +72,13 @@ using TimePtr = std::shared_ptr<Time>;
 class EntityPlugin : public Plugin {
  public:
     EntityPlugin();
+
+    /**
+     * @brief Copy the plugin for clone(). The copy doesn't have a parent,
+     * subscribers or shapes, and its VariableIO has its own input and output
+     * vectors, which the new entity connects.
+     */
+    EntityPlugin(const EntityPlugin &other);
     virtual ~EntityPlugin();
 
     virtual bool ready() { return true; }
@@ -77,6 +86,40 @@ class EntityPlugin : public Plugin {
     void close_plugin(const double &t);
     virtual void close(double /*t*/) {}
 
+    /**
+     * @brief Save the plugin's internal state for SimControl::snapshot().
+     *
+     * SimControl already saves the entity states, the motion model state
+     * vector, the desired states, the VariableIO outputs and the pub/sub
+     * queues. Plugins that keep other state between steps (e.g., PID
+     * integrators or metric counters) override this and restore_state().
+     * The returned value is passed back to restore_state() unchanged.
+     */
+    virtual boost::any save_state() { return boost::any(); }
+    virtual void restore_state(const boost::any &/*state*/) {}
+
+    /**
+     * @brief Copy the plugin for another entity of the same entity block.
+     *
+     * SimControl initializes the first entity of an entity block with init()
+     * and, if all of the entity's plugins can be cloned, generates the other
+     * entities of the block from copies of its plugins instead of loading,
+     * parsing and initializing each plugin again. The copy keeps the values
+     * that init() parsed from the parameters. The new entity sets the copy's
+     * parent, state and VariableIO connections and then calls
+     * init_instance(). Plugins support cloning by returning a copy of
+     * themselves, e.g., std::make_shared<MyPlugin>(*this). The default
+     * returns nullptr, i.e., the plugin can't be cloned.
+     */
+    virtual std::shared_ptr<EntityPlugin> clone() { return nullptr; }
+
+    /**
+     * @brief Initialize the parts of a cloned plugin that belong to its
+     * entity: subscribers, publishers, registered parameters and anything
+     * computed from the entity's initial state.
+     */
+    virtual void init_instance() {}
+
     virtual void set_parent(EntityPtr parent);
     virtual EntityPtr parent();
 
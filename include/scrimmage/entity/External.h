@@ -346,6 +346,7 @@ class External {
     void update_time(double t);
 
     std::list<InterfacePtr> outgoing_interfaces_;
+    std::shared_ptr<ContactSnapshot> contact_snapshot_;
 };
 
 } // namespace scrimmage
@@ -67,6 +67,9 @@ class Contact;
 using ContactMap = std::unordered_map<int, Contact>;
 using ContactMapPtr = std::shared_ptr<ContactMap>;
 
+class ContactSnapshot;
+using ContactSnapshotPtr = std::shared_ptr<const ContactSnapshot>;
+
 class FileSearch;
 using FileSearchPtr = std::shared_ptr<FileSearch>;
 
@@ -0,0 +1,127 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_LOG_ASYNCLOGWRITER_H_
+#define INCLUDE_SCRIMMAGE_LOG_ASYNCLOGWRITER_H_
+
+#include <atomic>
+#include <condition_variable> // NOLINT
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex> // NOLINT
+#include <thread> // NOLINT
+#include <vector>
+
+namespace google { namespace protobuf {
+class MessageLite;
+}}
+
+namespace scrimmage {
+
+/*! \brief Moves log serialization onto a dedicated writer thread.
+ *
+ * The simulation thread push()es messages into a bounded single-producer,
+ * single-consumer ring. The writer thread pops them in order and calls the
+ * write function with the message and the target it was pushed with (e.g.,
+ * a Log::FileType). A message must not be modified after it has been pushed.
+ *
+ * When the ring is full, the BLOCK policy waits for the writer to catch up
+ * so that nothing is lost, and the DROP policy discards the new message and
+ * counts it in dropped().
+ */
+class AsyncLogWriter {
+ public:
+    using MessagePtr = std::shared_ptr<const google::protobuf::MessageLite>;
+    using WriteFunc = std::function<bool(const google::protobuf::MessageLite &,
+                                         int target)>;
+
+    enum class Policy {BLOCK, DROP};
+
+    AsyncLogWriter(WriteFunc write, std::size_t capacity, Policy policy);
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter &) = delete;
+    AsyncLogWriter &operator=(const AsyncLogWriter &) = delete;
+
+    /*! \brief Queue a message for writing. Only one thread may push. Returns
+     * false if the message was dropped. */
+    bool push(const MessagePtr &msg, int target);
+
+    /*! \brief Block until every queued message has been written. */
+    void flush();
+
+    /*! \brief Write the remaining messages and join the writer thread. */
+    void stop();
+
+    std::size_t dropped() const { return dropped_; }
+    std::size_t failed() const { return failed_; }
+
+ protected:
+    struct Item {
+        MessagePtr msg;
+        int target;
+    };
+
+    void run();
+
+    WriteFunc write_;
+    Policy policy_;
+    std::vector<Item> ring_;
+    std::size_t mask_ = 0;
+
+    // head_ is only written by the writer thread and tail_ only by the
+    // producer, so they are padded onto separate cache lines. (new doesn't
+    // honor alignas(64) before C++17.)
+    std::atomic<std::size_t> head_;
+    char head_padding_[64 - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> tail_;
+    char tail_padding_[64 - sizeof(std::atomic<std::size_t>)];
+
+    // Only used to sleep when the ring is empty (writer) or full (producer)
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::atomic<bool> writer_waiting_;
+    std::atomic<bool> producer_waiting_;
+    bool stop_ = false;
+
+    std::size_t dropped_ = 0;
+    std::atomic<std::size_t> failed_;
+
+    std::thread thread_;
+};
+
+using AsyncLogWriterPtr = std::shared_ptr<AsyncLogWriter>;
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_LOG_ASYNCLOGWRITER_H_
@@ -0,0 +1,156 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_LOG_CHUNKEDLOG_H_
+#define INCLUDE_SCRIMMAGE_LOG_CHUNKEDLOG_H_
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google { namespace protobuf {
+class MessageLite;
+}}
+
+namespace scrimmage {
+
+/*! \brief A group of consecutive records in a log file. */
+struct LogChunk {
+    double t_begin = 0;
+    double t_end = 0;
+    uint64_t offset = 0;       // byte offset of the chunk in the file
+    uint64_t end_offset = 0;   // byte offset just past the chunk
+    uint32_t num_records = 0;
+};
+
+/*! \brief Writes time-stamped protobuf messages in compressed chunks.
+ *
+ * File layout (all integers little-endian):
+ *
+ *     "SCRLOG01"
+ *     chunk*:  "CHNK", num_records (u32), raw_size (u64),
+ *              compressed_size (u64), record times (f64 * num_records),
+ *              zlib compressed records
+ *     index:   "INDX", num_chunks (u64),
+ *              (t_begin (f64), t_end (f64), offset (u64), num_records (u32))*
+ *     footer:  index offset (u64), "SCRIDX01"
+ *
+ * Decompressed, a chunk holds the same varint-delimited messages as the
+ * original stream format. Sim time must not decrease between records.
+ */
+class ChunkedLogWriter {
+ public:
+    ChunkedLogWriter() = default;
+    ~ChunkedLogWriter();
+
+    bool open(const std::string &filename, unsigned int records_per_chunk);
+    bool write(const google::protobuf::MessageLite &message, double time);
+
+    /*! \brief Write the last partial chunk and the index. */
+    bool close();
+
+ protected:
+    bool write_chunk();
+
+    std::ofstream out_;
+    unsigned int records_per_chunk_ = 100;
+    std::string raw_;
+    std::string compressed_;
+    std::vector<double> times_;
+    std::vector<LogChunk> chunks_;
+};
+
+/*! \brief Streams time-stamped protobuf messages out of a log file.
+ *
+ * Reads both the chunked format written by ChunkedLogWriter and the plain
+ * varint-delimited stream format of older logs. Only the chunk index and
+ * one decompressed chunk are held in memory. For old logs, open() scans the
+ * file once to build an index of uncompressed chunks. Record times are read
+ * from field 1 of each message, which is the time of Frame and Shapes.
+ */
+class ChunkedLogReader {
+ public:
+    static bool is_chunked(const std::string &filename);
+
+    bool open(const std::string &filename);
+    void close();
+
+    bool chunked() const { return chunked_; }
+    const std::vector<LogChunk> &chunks() const { return chunks_; }
+    uint64_t num_records() const { return num_records_; }
+    double start_time() const;
+    double end_time() const;
+
+    /*! \brief Position the reader on the first record with time >= t. Returns
+     * false if there is no such record. Uses a binary search over the chunk
+     * index, so only one chunk is read. */
+    bool seek(double t);
+
+    /*! \brief Position the reader on the record with the given index. */
+    bool seek_record(uint64_t index);
+
+    /*! \brief Read the next record into message. Returns false at the end of
+     * the log or on a read error. */
+    bool next(google::protobuf::MessageLite &message, double *time = nullptr);
+
+    /*! \brief Index of the record that the next call to next() returns. */
+    uint64_t record_index() const;
+
+ protected:
+    bool build_chunked_index();
+    bool scan_chunks(uint64_t begin);
+    bool scan_stream();
+    bool load_chunk(size_t chunk);
+
+    std::string filename_;
+    std::ifstream in_;
+    bool chunked_ = false;
+    std::vector<LogChunk> chunks_;
+    std::vector<uint64_t> first_record_;  // index of each chunk's first record
+    uint64_t num_records_ = 0;
+
+    // The loaded chunk
+    size_t chunk_ = 0;
+    bool chunk_loaded_ = false;
+    std::string raw_;
+    std::string compressed_;
+    std::vector<double> times_;
+    std::vector<uint64_t> offsets_;  // record starts in raw_
+    size_t record_ = 0;
+};
+
+using ChunkedLogReaderPtr = std::shared_ptr<ChunkedLogReader>;
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_LOG_CHUNKEDLOG_H_
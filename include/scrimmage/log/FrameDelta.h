@@ -0,0 +1,106 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_LOG_FRAMEDELTA_H_
+#define INCLUDE_SCRIMMAGE_LOG_FRAMEDELTA_H_
+
+#include <scrimmage/proto/Frame.pb.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace scrimmage {
+
+/*! \brief Turns full frames into a keyframe followed by delta frames.
+ *
+ * Contact states are rounded to a fixed precision so that contacts that
+ * only jitter below the precision are not resent. A delta frame carries
+ * the contacts whose rounded contents changed since they were last sent
+ * and the ids of contacts that disappeared. Every keyframe_interval frames
+ * a full keyframe is written so that readers can join or seek mid-stream.
+ */
+class FrameDeltaEncoder {
+ public:
+    void set_keyframe_interval(unsigned int interval);
+    void set_precision(double precision);
+
+    /*! \brief Make the next encoded frame a keyframe. */
+    void reset();
+
+    std::shared_ptr<scrimmage_proto::Frame> encode(const scrimmage_proto::Frame &frame);
+
+ protected:
+    unsigned int keyframe_interval_ = 100;
+    double precision_ = 1e-3;
+    unsigned int frames_since_keyframe_ = 0;
+    bool need_keyframe_ = true;
+
+    // serialized contact as last sent, by contact id
+    std::unordered_map<int, std::string> sent_;
+    std::unordered_set<int> present_;
+    std::string buffer_;
+};
+
+/*! \brief Rebuilds full frames from the output of FrameDeltaEncoder.
+ *
+ * Frames without the delta flag pass through unchanged, so the decoder can
+ * be used on any frame stream. Until the first keyframe arrives, decoded
+ * frames only hold the contacts that have changed since the decoder joined
+ * the stream.
+ */
+class FrameDeltaDecoder {
+ public:
+    void reset();
+    bool synced() const { return synced_; }
+
+    std::shared_ptr<scrimmage_proto::Frame>
+    decode(const std::shared_ptr<scrimmage_proto::Frame> &frame);
+
+ protected:
+    bool synced_ = false;
+    std::vector<int> order_;
+    std::unordered_map<int, scrimmage_proto::Contact> contacts_;
+};
+
+/*! \brief Round the state of every contact in the frame to precision. */
+void quantize(scrimmage_proto::Frame &frame, double precision);
+
+/*! \brief Fold the frame that follows into a frame that has not been sent
+ * yet, so that decoding the result gives the same contacts as decoding both.
+ * A keyframe simply replaces the earlier frame. */
+void merge_frames(scrimmage_proto::Frame &into, const scrimmage_proto::Frame &next);
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_LOG_FRAMEDELTA_H_
@@ -34,6 +34,8 @@
 #define INCLUDE_SCRIMMAGE_LOG_LOG_H_
 
 #include <scrimmage/log/Frame.h>
+#include <scrimmage/log/AsyncLogWriter.h>
+#include <scrimmage/log/ChunkedLog.h>
 
 #include <list>
 #include <fstream>
@@ -63,6 +65,7 @@ class Log {
     using ZeroCopyOutputStreamPtr = std::shared_ptr<google::protobuf::io::ZeroCopyOutputStream>;
 
     Log();
+    ~Log();
 
     enum FileType {
         FRAMES = 0,
@@ -114,6 +117,10 @@ class Log {
 
     bool save_shapes(const scrimmage_proto::Shapes &shapes);
 
+    /*! \brief Save shapes without copying them when writing asynchronously.
+     * The shapes must not be modified afterwards. */
+    bool save_shapes(const std::shared_ptr<scrimmage_proto::Shapes> &shapes);
+
     bool save_utm_terrain(const std::shared_ptr<scrimmage_proto::UTMTerrain> &utm_terrain);
 
     bool save_contact_visual(const std::shared_ptr<scrimmage_proto::ContactVisual> &contact_visual);
@@ -128,6 +135,20 @@ class Log {
 
     void set_enable_log(bool enable);
 
+    /*! \brief Serialize and write frames, shapes, and contact visuals on a
+     * writer thread instead of the calling thread. Must be called before
+     * init(). Frames passed to save_frame() must not be modified after the
+     * call. When the queue of queue_size messages is full, the caller waits,
+     * or the message is dropped if drop_when_full is true. */
+    void set_async(bool async, size_t queue_size = 128,
+                   bool drop_when_full = false);
+
+    /*! \brief Write frames and shapes in the compressed, indexed chunk format
+     * of ChunkedLogWriter instead of one long stream. Must be called before
+     * init(). Both formats can be parsed, and ChunkedLogReader can stream
+     * either of them. */
+    void set_chunked(bool chunked, unsigned int records_per_chunk = 100);
+
     void init_network(NetworkPtr network);
 
  protected:
@@ -136,6 +157,21 @@ class Log {
     bool enable_log_ = true;
     Mode mode_ = Mode::READ;
 
+    bool async_ = false;
+    size_t async_queue_size_ = 128;
+    bool async_drop_when_full_ = false;
+    AsyncLogWriterPtr writer_;
+
+    bool chunked_ = false;
+    unsigned int records_per_chunk_ = 100;
+    std::shared_ptr<ChunkedLogWriter> frames_chunked_;
+    std::shared_ptr<ChunkedLogWriter> shapes_chunked_;
+
+    bool save(FileType type,
+              const std::shared_ptr<const google::protobuf::MessageLite> &message);
+    bool write(FileType type, const google::protobuf::MessageLite &message);
+    bool parse_chunked(const std::string &filename, FileType type);
+
     bool open_file(std::string name, int &fd);
 
     std::string frames_name_ = "frames.bin";
@@ -0,0 +1,132 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_LOG_PLAYBACKREADER_H_
+#define INCLUDE_SCRIMMAGE_LOG_PLAYBACKREADER_H_
+
+#include <scrimmage/log/ChunkedLog.h>
+#include <scrimmage/log/FrameDelta.h>
+#include <scrimmage/proto/Frame.pb.h>
+#include <scrimmage/proto/Shape.pb.h>
+
+#include <condition_variable> // NOLINT
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex> // NOLINT
+#include <string>
+#include <thread> // NOLINT
+#include <vector>
+
+namespace scrimmage {
+
+/*! \brief One frame of a log and the shapes that go with it. */
+struct PlaybackStep {
+    uint64_t index = 0;
+    std::shared_ptr<scrimmage_proto::Frame> frame;
+
+    // shapes logged after the previous frame, up to the time of this frame
+    std::vector<std::shared_ptr<scrimmage_proto::Shapes>> shapes;
+};
+
+/*! \brief Streams frames and shapes from a log on a reader thread.
+ *
+ * Only the chunk indices, one chunk of each file, and a bounded read-ahead
+ * queue of steps are held in memory. Delta frames are decoded, so every
+ * step holds a full frame. Seeking uses the chunk index and then backs up
+ * to the nearest keyframe, so jumping anywhere in the log, backwards
+ * included, never rereads the log from the start.
+ */
+class PlaybackReader {
+ public:
+    explicit PlaybackReader(size_t read_ahead = 64);
+    ~PlaybackReader();
+
+    /*! \brief Open the frames file and, if it exists, the shapes file, and
+     * start the reader thread on the first frame. */
+    bool open(const std::string &frames_filename,
+              const std::string &shapes_filename = "");
+    void close();
+
+    uint64_t num_frames() const { return num_frames_; }
+    double start_time() const { return start_time_; }
+    double end_time() const { return end_time_; }
+
+    /*! \brief Time between the first two frames. */
+    double dt() const { return dt_; }
+
+    /*! \brief Wait for the next step. Returns false at the end of the log. */
+    bool next(PlaybackStep &step);
+
+    /*! \brief Continue from the first frame with time >= t. */
+    void seek(double t);
+
+    /*! \brief Continue from the frame with the given index. */
+    void seek_frame(uint64_t index);
+
+ protected:
+    void read_loop();
+    bool read_step(PlaybackStep &step);
+    bool position(uint64_t index);
+
+    size_t read_ahead_;
+    uint64_t num_frames_ = 0;
+    double start_time_ = 0;
+    double end_time_ = 0;
+    double dt_ = 0.1;
+
+    // Only used by the reader thread once it is started
+    ChunkedLogReader frames_;
+    ChunkedLogReader shapes_;
+    bool has_shapes_ = false;
+    FrameDeltaDecoder decoder_;
+    uint64_t index_ = 0;
+    std::shared_ptr<scrimmage_proto::Frame> next_frame_;
+    std::shared_ptr<scrimmage_proto::Shapes> next_shapes_;
+    double shapes_after_ = 0;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable reader_cv_;
+    std::condition_variable consumer_cv_;
+    std::deque<PlaybackStep> queue_;
+    bool stop_ = false;
+    bool eof_ = false;
+
+    enum class Seek {NONE, TIME, INDEX};
+    Seek seek_ = Seek::NONE;
+    double seek_time_ = 0;
+    uint64_t seek_index_ = 0;
+};
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_LOG_PLAYBACKREADER_H_
@@ -49,7 +49,13 @@ class MotionModel : public EntityPlugin {
  public:
     typedef std::vector<double> vector_t;
 
+    /// @brief Integration schemes used by ode_step()
+    enum class Integrator {RK4, RK45, SEMI_IMPLICIT_EULER};
+
     MotionModel();
+
+    /// @brief Copy for clone(). The copy has its own integrator workspace.
+    MotionModel(const MotionModel &other);
     std::string type() override;
 
     virtual bool init(std::map<std::string, std::string> &info,
@@ -70,10 +76,82 @@ class MotionModel : public EntityPlugin {
     }
     void close(double t) override;
 
+    /**
+     * @brief Whether step_batch() steps several models at once.
+     *
+     * When the batch_motion mission option is enabled, SimControl groups the
+     * motion models that support batching by type and calls step_batch() on
+     * one model of each group instead of calling step() on every model.
+     */
+    virtual bool supports_batch() { return false; }
+
+    /**
+     * @brief Step all of the models, which have the same type as this one.
+     *
+     * The default calls step() on each model.
+     */
+    virtual bool step_batch(const std::vector<MotionModel *> &models,
+                            double time, double dt);
+
+    /**
+     * @brief Select the integrator from the plugin parameters.
+     *
+     * Reads "integrator" (rk4, rk45 or semi_implicit_euler, default rk4)
+     * and, for rk45, the "integrator_abs_tol" and "integrator_rel_tol" error
+     * tolerances. Returns false for an unknown integrator, or for
+     * semi_implicit_euler if the model doesn't set semi_implicit_indices_.
+     */
+    bool set_integrator(std::map<std::string, std::string> &params);
+    void set_integrator(Integrator integrator);
+    Integrator integrator() const { return integrator_; }
+
+    /**
+     * @brief Drop the integrator state that was computed from the old x_.
+     * Call it after writing full_state_vector() from outside the model,
+     * e.g., when a snapshot is restored.
+     */
+    void reset_integrator();
+
  protected:
+    /// @brief Integrate x_ over dt with the selected integrator
     void ode_step(double dt);
     virtual void model(const vector_t &x , vector_t &dxdt , double t);
 
+    /**
+     * @brief RK4 step of a fixed-size state, e.g., std::array or
+     * Eigen::Matrix<double, N, 1>. The stages live on the stack, so nothing
+     * is allocated.
+     *
+     * sys(x, dxdt, t) computes the derivative of x.
+     */
+    template <class StateT, class System>
+    static void ode_step(System &&sys, StateT &x, double t, double dt) {
+        StateT k1, k2, k3, k4, tmp;
+        const size_t n = x.size();
+        auto stage = [&](const StateT &k, double h) {
+            for (size_t i = 0; i < n; i++) tmp[i] = x[i] + h * k[i];
+        };
+        sys(x, k1, t);
+        stage(k1, dt / 2);
+        sys(tmp, k2, t + dt / 2);
+        stage(k2, dt / 2);
+        sys(tmp, k3, t + dt / 2);
+        stage(k3, dt);
+        sys(tmp, k4, t + dt);
+        for (size_t i = 0; i < n; i++) {
+            x[i] += dt / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+        }
+    }
+
+    /**
+     * @brief Indices of x_ that semi-implicit Euler updates first, typically
+     * the velocities. The other states are then updated with the derivative
+     * evaluated at the new values. Models that support semi-implicit Euler
+     * set them in their constructor. Without indices, semi-implicit Euler is
+     * explicit Euler.
+     */
+    std::vector<int> semi_implicit_indices_;
+
     StatePtr state_;
     vector_t x_;
 
@@ -81,6 +159,13 @@ class MotionModel : public EntityPlugin {
     Eigen::Vector3d ext_moment_;
     double mass_;
     double g_;
+
+    // Persistent stepper state so that ode_step() doesn't allocate
+    struct ODEWorkspace;
+    std::shared_ptr<ODEWorkspace> ode_workspace_;
+    Integrator integrator_ = Integrator::RK4;
+    double abs_tol_ = 1e-6;
+    double rel_tol_ = 1e-6;
 };
 
 using MotionModelPtr = std::shared_ptr<MotionModel>;
@@ -34,6 +34,8 @@
 #define INCLUDE_SCRIMMAGE_NETWORK_INTERFACE_H_
 
 #include <scrimmage/fwd_decl.h>
+#include <scrimmage/log/FrameDelta.h>
+#include <scrimmage/network/ShmChannel.h>
 #include <scrimmage/network/ScrimmageServiceImpl.h>
 #include <scrimmage/proto/Frame.pb.h>
 #include <scrimmage/proto/Visual.pb.h>
@@ -45,10 +47,13 @@
 #include <grpc++/grpc++.h>
 #endif
 
+#include <atomic>
+#include <condition_variable> // NOLINT
 #include <list>
 #include <mutex> // NOLINT
 #include <string>
 #include <memory>
+#include <thread> // NOLINT
 
 namespace scrimmage {
 class Interface {
@@ -56,9 +61,15 @@ class Interface {
     typedef enum Mode {
         shared = 0,
         client = 1,
-        server = 2
+        server = 2,
+        // like client and server, but frames and shapes go through shared
+        // memory on the same host
+        shm_client = 3,
+        shm_server = 4
     } Mode_t;
 
+    ~Interface();
+
     void set_mode(Mode_t mode) { mode_ = mode; }
     void set_ip(std::string &ip) { ip_ = ip; }
     void set_port(int port) { port_ = port; }
@@ -146,9 +157,48 @@ class Interface {
 
     unsigned int max_queue_size_ = 100;
 
+    // Delta frames are expanded as they arrive so that frames dropped from
+    // a full queue do not break the chain
+    FrameDeltaDecoder frame_decoder_;
+
+    // shm_client publishes full frames, so readers can start at any frame
+    void shm_read_loop();
+    ShmChannelPtr shm_frames_;
+    ShmChannelPtr shm_shapes_;
+    FrameDeltaDecoder shm_decoder_;
+    std::thread shm_thread_;
+    std::atomic<bool> shm_stop_{false};
+    uint32_t shm_frame_slots_ = 16;
+    uint32_t shm_frame_size_ = 4 << 20;
+    uint32_t shm_shapes_slots_ = 64;
+    uint32_t shm_shapes_size_ = 1 << 20;
+
 #if ENABLE_GRPC
     std::unique_ptr<scrimmage_proto::ScrimmageService::Stub> scrimmage_stub_;
     std::unique_ptr<grpc::Server> server_;
+
+    // In client mode, frames, shapes, sim info, and contact visuals are
+    // handed to a sender thread that writes them to one long-lived stream
+    // per message type. While the receiver lags, newer messages are folded
+    // into the ones that are still waiting.
+    void send_loop();
+
+    std::thread send_thread_;
+    std::mutex send_mutex_;
+    std::condition_variable send_cv_;
+    bool send_stop_ = false;
+    std::shared_ptr<scrimmage_proto::Frame> pending_frame_;
+    bool pending_frame_owned_ = false;
+    std::shared_ptr<scrimmage_proto::Shapes> pending_shapes_;
+    std::shared_ptr<scrimmage_proto::SimInfo> pending_sim_info_;
+    std::list<std::shared_ptr<scrimmage_proto::ContactVisual>> pending_contact_visuals_;
+    bool send_done_ = false;
+
+    // Contexts of the open streams, so that the destructor can cancel a
+    // write that is blocked on a receiver that stopped reading
+    std::mutex stream_mutex_;
+    std::list<grpc::ClientContext *> stream_contexts_;
+    bool streams_cancelled_ = false;
 #endif
 
     // Connection timeout in seconds
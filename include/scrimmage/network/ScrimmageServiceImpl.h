@@ -78,6 +78,22 @@ class ScrimmageServiceImpl final : public scrimmage_proto::ScrimmageService::Ser
                        const google::protobuf::Empty* shape,
                        scrimmage_proto::BlankReply* reply) override;
 
+    grpc::Status SendFrameStream(grpc::ServerContext* context,
+                                 grpc::ServerReader<scrimmage_proto::Frame>* reader,
+                                 scrimmage_proto::BlankReply* reply) override;
+
+    grpc::Status SendSimInfoStream(grpc::ServerContext* context,
+                                   grpc::ServerReader<scrimmage_proto::SimInfo>* reader,
+                                   scrimmage_proto::BlankReply* reply) override;
+
+    grpc::Status SendContactVisualStream(grpc::ServerContext* context,
+                                         grpc::ServerReader<scrimmage_proto::ContactVisual>* reader,
+                                         scrimmage_proto::BlankReply* reply) override;
+
+    grpc::Status SendShapesStream(grpc::ServerContext* context,
+                                  grpc::ServerReader<scrimmage_proto::Shapes>* reader,
+                                  scrimmage_proto::BlankReply* reply) override;
+
     std::promise<void> exit_requested;
 
  protected:
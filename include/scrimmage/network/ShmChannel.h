@@ -0,0 +1,124 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_NETWORK_SHMCHANNEL_H_
+#define INCLUDE_SCRIMMAGE_NETWORK_SHMCHANNEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google { namespace protobuf {
+class MessageLite;
+}}
+
+namespace scrimmage {
+
+/*! \brief A ring of serialized protobuf messages in POSIX shared memory.
+ *
+ * One process creates the channel and writes to it. Any number of readers
+ * on the same host map it and read without system calls. Each slot is
+ * guarded by a sequence lock, so a reader that is overtaken by the writer
+ * detects it instead of blocking the writer. Messages are numbered from
+ * zero; message n lives in slot n % num_slots.
+ *
+ * Layout (little-endian, also read by python/scrimmage/shm_reader.py):
+ *
+ *     header (64 bytes): "SCRSHM01", num_slots (u32), slot_size (u32),
+ *                        count (u64), closed (u32), reserved
+ *     slot:              seq (u64), size (u32), reserved (u32),
+ *                        payload (slot_size bytes)
+ *
+ * A slot holding message n has seq 2n + 2. While it is being written, its
+ * seq is 2n + 1.
+ */
+class ShmChannel {
+ public:
+    enum class Status {OK, NOT_READY, OVERWRITTEN, ERROR};
+
+    ShmChannel() = default;
+    ShmChannel(const ShmChannel &) = delete;
+    ShmChannel &operator=(const ShmChannel &) = delete;
+    ~ShmChannel();
+
+    /*! \brief Create (or replace) the channel as its writer. slot_size is
+     * the largest message that can be written. */
+    bool create(const std::string &name, uint32_t num_slots, uint32_t slot_size);
+
+    /*! \brief Map an existing channel as a reader. */
+    bool open(const std::string &name);
+
+    /*! \brief Unmap the channel. The writer also marks it closed and
+     * removes its name. */
+    void close();
+
+    bool is_open() const { return header_ != nullptr; }
+
+    /*! \brief True if the writer has closed the channel. */
+    bool closed() const;
+
+    bool write(const google::protobuf::MessageLite &message);
+
+    /*! \brief Number of messages written so far. */
+    uint64_t count() const;
+
+    uint32_t num_slots() const;
+
+    Status read(uint64_t n, google::protobuf::MessageLite &message) const;
+
+    /*! \brief Read the newest message and, if n is given, its number. */
+    Status read_latest(google::protobuf::MessageLite &message,
+                       uint64_t *n = nullptr) const;
+
+    static std::string frames_name(int port);
+    static std::string shapes_name(int port);
+
+ protected:
+    struct Header;
+    struct Slot;
+
+    Slot *slot(uint64_t n) const;
+    bool map(int fd, size_t size);
+
+    std::string name_;
+    bool writer_ = false;
+    void *data_ = nullptr;
+    size_t size_ = 0;
+    Header *header_ = nullptr;
+    bool too_large_ = false;
+};
+
+using ShmChannelPtr = std::shared_ptr<ShmChannel>;
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_NETWORK_SHMCHANNEL_H_
@@ -34,8 +34,12 @@
 #define INCLUDE_SCRIMMAGE_PARSE_CONFIGPARSE_H_
 
 #include <map>
-#include <vector>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace rapidxml {
 template <class T> class xml_node;
@@ -59,6 +63,14 @@ class ConfigParse {
     std::string stem();
     void print_params();
 
+    /**
+     * @brief Forget the parsed files.
+     *
+     * Each file is only read and parsed the first time it is found by
+     * parse(). Later calls copy the cached params and apply their overrides.
+     */
+    static void clear_cache();
+
     friend std::ostream& operator<<(std::ostream& os, ConfigParse& cp);
 
  protected:
@@ -66,6 +78,18 @@ class ConfigParse {
     std::vector<std::string> required_;
     std::string filename_;
 
+    // The params of a parsed file without overrides. The fixed params are not
+    // replaced by overrides.
+    struct Template {
+        std::map<std::string, std::string> params;
+        std::set<std::string> fixed;
+    };
+    std::shared_ptr<const Template> load(const std::string &filename);
+
+    // Key: path of the parsed file
+    static std::mutex cache_mutex_;
+    static std::unordered_map<std::string, std::shared_ptr<const Template>> cache_;
+
     void recursive_params(rapidxml::xml_node<char> *root,
         const std::map<std::string, std::string> &overrides,
         std::map<std::string, std::string> &params,
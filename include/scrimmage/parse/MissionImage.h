@@ -0,0 +1,101 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_PARSE_MISSIONIMAGE_H_
+#define INCLUDE_SCRIMMAGE_PARSE_MISSIONIMAGE_H_
+
+#include <scrimmage/proto/MissionImage.pb.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rapidxml {
+template <class T> class xml_document;
+template <class T> class xml_node;
+}
+
+namespace scrimmage {
+
+/**
+ * @brief A mission file that was parsed ahead of time.
+ *
+ * compile() parses the XML of a mission file once and splits its text and the
+ * values of its nodes and attributes at the ${name=default} variables. Each
+ * variable name gets a slot. MissionParse::parse() rebuilds the XML document
+ * from the image without the regular expressions and the XML parser, and
+ * applies the overrides by slot index.
+ *
+ * The slot values passed to content() and build() are indexed by slot. A null
+ * value uses the default value of each variable.
+ */
+class MissionImage {
+ public:
+    /// @brief Whether content is a mission image instead of XML
+    static bool is_image(const std::string &content);
+
+    bool compile(const std::string &mission_filename, const std::string &content);
+    bool load(const std::string &content);
+    std::string serialize() const;
+    bool write(const std::string &filename) const;
+
+    const std::string &mission_filename() const;
+    int num_slots() const;
+
+    /// @brief The slot of a variable name, or -1 if the mission doesn't use it
+    int slot(const std::string &name) const;
+
+    /// @brief The mission file with the variables replaced by their values
+    std::string content(const std::vector<const std::string *> &slot_values) const;
+
+    /// @brief The mission file as it was compiled, including the variables
+    std::string source() const;
+
+    void build(rapidxml::xml_document<char> &doc,
+               const std::vector<const std::string *> &slot_values) const;
+
+ protected:
+    void split(const std::string &text, scrimmage_proto::MissionText &out);
+    bool compile_node(rapidxml::xml_node<char> *node,
+                      scrimmage_proto::MissionNode &out);
+    void build_node(rapidxml::xml_document<char> &doc,
+                    rapidxml::xml_node<char> *parent,
+                    const scrimmage_proto::MissionNode &node,
+                    const std::vector<const std::string *> &slot_values) const;
+
+    scrimmage_proto::MissionImage image_;
+
+    // Key: variable name, Value: slot
+    std::unordered_map<std::string, int> slots_;
+};
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_PARSE_MISSIONIMAGE_H_
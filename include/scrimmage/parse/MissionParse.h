@@ -51,6 +51,8 @@ namespace sp = scrimmage_proto;
 
 namespace scrimmage {
 
+class MissionImage;
+
 // Key 1: Entity Description XML ID
 // Value 1: Map of entity information
 // Key 2: entity param string
@@ -84,6 +86,29 @@ class MissionParse {
     bool create_log_dir();
     void set_overrides(const std::string &overrides);
     bool parse(const std::string &filename);
+
+    /**
+     * @brief Search for a mission file and read its content.
+     *
+     * @param [out] mission_filename the path of the mission file that was found
+     */
+    static bool read_mission_file(const std::string &filename,
+                                  std::string &mission_filename,
+                                  std::string &content);
+
+    /**
+     * @brief Make parse() use content that was already read with
+     * read_mission_file() instead of searching for and reading the file again.
+     */
+    void set_mission_content(const std::string &mission_filename,
+                             const std::string &content);
+
+    /**
+     * @brief Make parse() use a compiled mission that was already loaded,
+     * e.g., by one MissionImage::load() for many runs of the mission.
+     */
+    void set_mission_image(const std::string &mission_filename,
+                           std::shared_ptr<const MissionImage> image);
     bool write(const std::string &filename);
 
     double t0();
@@ -220,6 +245,13 @@ class MissionParse {
 
     std::map<std::string, std::string> overrides_map_;
 
+    std::string preloaded_filename_;
+    std::string preloaded_content_;
+    std::shared_ptr<const MissionImage> preloaded_image_;
+
+    // The compiled mission if the mission file is a mission image
+    std::shared_ptr<const MissionImage> mission_image_;
+
  private:
     // Holds output types specified in mission file
     std::set<std::string> output_types_;
@@ -44,6 +44,7 @@
 #include <set>
 #include <unordered_set>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -142,6 +143,9 @@ class PluginManager {
 
         std::string plugin_name_so = config_parse.params()["library"];
 
+        // batch runs share one PluginManager between threads
+        std::lock_guard<std::mutex> lock(mutex_);
+
         // first, if this has already been processed, return it
         PluginPtr plugin = make_plugin_helper(plugin_type, plugin_name_so);
         if (plugin != nullptr) {
@@ -209,6 +213,8 @@ class PluginManager {
     PluginPtr make_plugin_helper(std::string &plugin_type, std::string &plugin_name);
     bool reload_;
 
+    std::mutex mutex_;
+
     // std::list<PluginPtr> plugins_;
 };
 
@@ -32,12 +32,14 @@
 #ifndef INCLUDE_SCRIMMAGE_PLUGINS_AUTONOMY_PYAUTONOMY_PYAUTONOMY_H_
 #define INCLUDE_SCRIMMAGE_PLUGINS_AUTONOMY_PYAUTONOMY_PYAUTONOMY_H_
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <scrimmage/autonomy/Autonomy.h>
 #include <scrimmage/entity/Contact.h>
 
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace scrimmage {
 namespace autonomy {
@@ -47,11 +49,31 @@ class PyAutonomy : public scrimmage::Autonomy {
     void init(std::map<std::string, std::string> &params) override;
     bool step_autonomy(double t, double dt) override;
 
+    /**
+     * With the "batch" parameter set, the autonomies that use the same
+     * Python class step in one call to the step_autonomy_batch() method of
+     * the first one's Python object:
+     *
+     *     step_autonomy_batch(t, dt, ids, states, contacts, desired)
+     *
+     * ids holds the entity ids. states and desired have one row per entity
+     * with the columns x, y, z, vx, vy, vz, wx, wy, wz, qw, qx, qy, qz.
+     * contacts has one row per contact with the columns id, team_id followed
+     * by the same state columns. desired starts out as the current desired
+     * states and can be updated in place, or an array of the same shape can
+     * be returned instead. Returning False stops the simulation. The arrays
+     * are reused by the next step.
+     */
+    bool supports_batch() override {return batch_;}
+    bool step_autonomy_batch(const std::vector<Autonomy *> &autonomies,
+                             double t, double dt) override;
+
     std::string type() override {return std::string("PyAutonomy");}
 
     void set_contacts(scrimmage::ContactMapPtr &contacts) override {
         contacts_ = contacts;
         py_contacts_.clear();
+        if (batch_) return;
         for (auto &kv : *contacts) {
             py_contacts_[pybind11::int_(kv.second.id().id())] =
                 contact2py(kv.second);
@@ -61,6 +83,11 @@ class PyAutonomy : public scrimmage::Autonomy {
     void set_contacts_from_plugin(scrimmage::AutonomyPtr &ptr) override {
         std::shared_ptr<PyAutonomy> py_ptr =
             std::static_pointer_cast<PyAutonomy>(ptr);
+        if (py_ptr->batch_ && !batch_) {
+            // batched autonomies do not convert the contacts
+            set_contacts(py_ptr->contacts_);
+            return;
+        }
         contacts_ = py_ptr->contacts_;
         py_contacts_ = py_ptr->py_contacts_;
     }
@@ -100,6 +127,21 @@ class PyAutonomy : public scrimmage::Autonomy {
     bool serialize_msgs_ = false;
 
     std::map<scrimmage::Contact::Type, pybind11::object> py_contact_types_;
+
+    bool step_batch_group(const std::vector<PyAutonomy *> &group, double t, double dt);
+
+    bool batch_ = false;
+    std::string py_class_name_;
+
+    // The autonomy that runs the batch groups them by Python class and the
+    // first autonomy of each group keeps the arrays it passes to Python.
+    std::map<std::string, std::vector<PyAutonomy *>> batch_groups_;
+    pybind11::array_t<int> batch_ids_;
+    pybind11::array_t<double> batch_states_;
+    pybind11::array_t<double> batch_desired_;
+    pybind11::array_t<double> batch_contacts_;
+    int batch_rows_ = -1;
+    int batch_contact_rows_ = -1;
 };
 } // namespace autonomy
 } // namespace scrimmage
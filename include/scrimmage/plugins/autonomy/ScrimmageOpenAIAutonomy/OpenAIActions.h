@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace scrimmage {
 namespace autonomy {
@@ -52,6 +53,13 @@ class DLL_PUBLIC OpenAIActions {
     void create_action_space(bool combine_actors);
     void distribute_action(pybind11::object action, bool combine_actors);
 
+    /// Distributes a combined action (one learner or combine_actors) from
+    /// raw buffers. Does not touch python objects.
+    void distribute_action(const int *disc, const double *cont);
+
+    /// Number of discrete and continuous values in the combined action
+    std::pair<size_t, size_t> combined_size() const;
+
     pybind11::object action_space;
 
  protected:
@@ -40,6 +40,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 #include <memory>
 
 namespace scrimmage {
@@ -60,6 +61,13 @@ class DLL_PUBLIC OpenAIObservations {
     void create_observation_space(size_t num_entities);
     pybind11::object update_observation(size_t num_entities, bool static_obs_space = true);
 
+    /// Writes the combined observation (one learner or combine_actors) to
+    /// raw buffers. Does not touch python objects.
+    void write_observation(size_t num_entities, int *disc, double *cont);
+
+    /// Number of discrete and continuous values in the combined observation
+    std::pair<size_t, size_t> combined_size(size_t num_entities) const;
+
     std::vector<std::vector<std::shared_ptr<sensor::ScrimmageOpenAISensor>>> &ext_sensor_vec() {return ext_sensor_vec_;}
 
     void add_sensors(const std::unordered_map<std::string, SensorPtr> &sensors);
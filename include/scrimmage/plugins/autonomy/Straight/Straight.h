@@ -40,6 +40,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <tuple>
 
 namespace scrimmage {
 
@@ -52,6 +53,10 @@ class Straight : public scrimmage::Autonomy{
  public:
     void init(std::map<std::string, std::string> &params) override;
     bool step_autonomy(double t, double dt) override;
+    boost::any save_state() override;
+    void restore_state(const boost::any &state) override;
+    std::shared_ptr<EntityPlugin> clone() override;
+    void init_instance() override;
 
  protected:
     double speed_;
@@ -82,6 +87,10 @@ class Straight : public scrimmage::Autonomy{
     PublisherPtr pub_gen_ents_;
     bool gen_ents_ = false;
     double prev_gen_time_ = -1.0;
+
+    using SavedState = std::tuple<Eigen::Vector3d,
+                                  std::shared_ptr<scrimmage::interaction::BoundaryBase>,
+                                  bool, State, ContactMap, double, int>;
 };
 } // namespace autonomy
 } // namespace scrimmage
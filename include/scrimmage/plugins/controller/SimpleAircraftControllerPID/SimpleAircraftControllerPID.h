@@ -38,6 +38,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace scrimmage {
 namespace controller {
@@ -54,6 +55,9 @@ class SimpleAircraftControllerPID : public Controller {
  public:
     virtual void init(std::map<std::string, std::string> &params);
     virtual bool step(double t, double dt);
+    boost::any save_state() override;
+    void restore_state(const boost::any &state) override;
+    std::shared_ptr<EntityPlugin> clone() override;
 
  protected:
     scrimmage::PID heading_pid_;
@@ -55,6 +55,10 @@ class Boundary : public scrimmage::EntityInteraction {
               std::map<std::string, std::string> &plugin_params) override;
     bool step_entity_interaction(std::list<sc::EntityPtr> &ents,
                                  double t, double dt) override;
+    boost::any save_state() override { return boundary_published_; }
+    void restore_state(const boost::any &state) override {
+        boundary_published_ = boost::any_cast<bool>(state);
+    }
 
     static std::shared_ptr<BoundaryBase> make_boundary(const scrimmage_proto::Shape &shape);
 
@@ -36,10 +36,15 @@
 #include <scrimmage/simcontrol/EntityInteraction.h>
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/common/TaskExecutor.h>
 
+#include <cstdint>
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace scrimmage {
 namespace interaction {
@@ -54,7 +59,16 @@ class SimpleCollision : public scrimmage::EntityInteraction {
     bool collision_exists(
         std::list<scrimmage::EntityPtr> &ents, Eigen::Vector3d &p) override;
 
+    double startup_collision_range() override;
+
  protected:
+    /// Fill pairs_ with the sorted pairs of indices into alive_ that are
+    /// within collision_range_ of each other.
+    void find_candidate_pairs();
+    void find_candidate_pairs(size_t begin, size_t end,
+                              std::vector<std::pair<int, int>> &pairs) const;
+    static uint64_t cell_key(int64_t x, int64_t y, int64_t z);
+
     double collision_range_;
     double startup_collision_range_;
     bool startup_collisions_only_;
@@ -64,6 +78,23 @@ class SimpleCollision : public scrimmage::EntityInteraction {
 
     scrimmage::PublisherPtr team_collision_pub_;
     scrimmage::PublisherPtr non_team_collision_pub_;
+
+    // Broad-phase state, kept between steps to reuse the allocations
+    struct Cell {
+        int64_t x;
+        int64_t y;
+        int64_t z;
+    };
+    int num_threads_ = 1;
+    const size_t min_cells_per_thread_ = 256;
+    // Kept for the whole run so the worker threads aren't started every step
+    scrimmage::TaskExecutorPtr executor_;
+    std::vector<Entity *> alive_;
+    std::vector<Eigen::Vector3d> pos_;
+    std::unordered_map<uint64_t, std::vector<int>> cells_;
+    std::vector<Cell> occupied_;
+    std::vector<std::pair<int, int>> pairs_;
+    std::vector<std::vector<std::pair<int, int>>> thread_pairs_;
 };
 } // namespace interaction
 } // namespace scrimmage
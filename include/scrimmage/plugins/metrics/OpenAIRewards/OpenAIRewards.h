@@ -48,6 +48,8 @@ class OpenAIRewards : public scrimmage::Metrics {
     bool step_metrics(double /*t*/, double /*dt*/) override {return true;}
     void print_team_summaries() override;
     void calc_team_scores() override;
+    boost::any save_state() override;
+    void restore_state(const boost::any &state) override;
 
  protected:
     std::map<std::string, std::string> params_;
@@ -39,6 +39,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <tuple>
 
 namespace scrimmage {
 namespace metrics {
@@ -50,6 +51,8 @@ class SimpleCollisionMetrics : public scrimmage::Metrics {
     bool step_metrics(double t, double dt) override;
     void calc_team_scores() override;
     void print_team_summaries() override;
+    boost::any save_state() override;
+    void restore_state(const boost::any &state) override;
 
  protected:
     std::map<int, SimpleCollisionScore> scores_;
@@ -59,6 +62,10 @@ class SimpleCollisionMetrics : public scrimmage::Metrics {
     std::map<std::string, std::string> params_;
     bool initialized_ = false;
     std::set<int> teams_;
+
+    using SavedState = std::tuple<std::map<int, SimpleCollisionScore>,
+                                  std::map<int, SimpleCollisionScore>,
+                                  std::map<int, bool>, bool, std::set<int>>;
 };
 }  // namespace metrics
 }  // namespace scrimmage
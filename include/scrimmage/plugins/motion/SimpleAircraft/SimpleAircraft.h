@@ -61,6 +61,9 @@ class SimpleAircraft : public scrimmage::MotionModel{
 
     void teleport(scrimmage::StatePtr &state) override;
 
+    std::shared_ptr<EntityPlugin> clone() override;
+    void init_instance() override;
+
  protected:
     scrimmage::PID heading_pid_;
     scrimmage::PID alt_pid_;
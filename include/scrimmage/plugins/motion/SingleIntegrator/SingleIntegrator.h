@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace scrimmage {
 namespace motion {
@@ -46,6 +47,10 @@ class SingleIntegrator : public scrimmage::MotionModel {
               std::map<std::string, std::string> &params) override;
     bool step(double t, double dt) override;
 
+    bool supports_batch() override { return true; }
+    bool step_batch(const std::vector<MotionModel *> &models,
+                    double t, double dt) override;
+
  protected:
     bool override_heading_;
     double max_speed_ = -1;
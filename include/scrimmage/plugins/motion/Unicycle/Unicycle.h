@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace scrimmage {
 namespace motion {
@@ -49,7 +50,14 @@ class Unicycle : public scrimmage::MotionModel {
 
     void model(const vector_t &x , vector_t &dxdt , double t) override;
 
+    bool supports_batch() override { return true; }
+    bool step_batch(const std::vector<MotionModel *> &models,
+                    double t, double dt) override;
+
  protected:
+    void read_inputs();
+    void update_state(const Eigen::Vector3d &prev_pos, double dt);
+
     double turn_rate_max_ = 1.0;
     double pitch_rate_max_ = 1.0;
     double velocity_z_max_ = 0.0;
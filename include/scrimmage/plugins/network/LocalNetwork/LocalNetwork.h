@@ -49,6 +49,9 @@ class LocalNetwork : public scrimmage::Network {
 
     bool init(std::map<std::string, std::string> &mission_params,
                       std::map<std::string, std::string> &plugin_params) override;
+
+    using scrimmage::Network::step;
+    bool step(scrimmage::TopicTable &topics) override;
  protected:
     bool is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                               const scrimmage::EntityPluginPtr &sub_plugin) override;
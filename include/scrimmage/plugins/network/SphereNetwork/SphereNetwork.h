@@ -37,6 +37,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace scrimmage {
 namespace network {
@@ -45,12 +46,19 @@ class SphereNetwork : public scrimmage::Network {
  public:
     bool init(std::map<std::string, std::string> &mission_params,
                       std::map<std::string, std::string> &plugin_params) override;
+
+    using scrimmage::Network::step;
+    bool step(scrimmage::TopicTable &topics) override;
  protected:
     bool is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                               const scrimmage::EntityPluginPtr &sub_plugin) override;
 
     bool is_successful_transmission(const scrimmage::EntityPluginPtr &pub_plugin,
                                             const scrimmage::EntityPluginPtr &sub_plugin) override;
+
+    void find_reachable(const scrimmage::EntityPtr &pub_ent,
+                        std::vector<int> &ids) override;
+
     double range_;
     double prob_transmit_;
 
@@ -53,6 +53,8 @@ class GPS : public scrimmage::Sensor {
     GPS();
     void init(std::map<std::string, std::string> &params) override;
     bool step() override;
+    std::shared_ptr<EntityPlugin> clone() override;
+    void init_instance() override;
 
  protected:
     bool gps_found_;
@@ -43,8 +43,12 @@ namespace scrimmage {
 template <class T>
 class Message : public MessageBase {
  public:
-    Message() : MessageBase() {}
-    explicit Message(T _data) : MessageBase(), data(_data) {}
+    Message() : MessageBase() {
+        type_tag = message_type_tag<Message<T>>();
+    }
+    explicit Message(T _data) : MessageBase(), data(_data) {
+        type_tag = message_type_tag<Message<T>>();
+    }
     T data;
 };
 
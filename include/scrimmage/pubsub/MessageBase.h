@@ -35,9 +35,25 @@
 
 #include <string>
 #include <memory>
+#include <typeinfo>
 
 namespace scrimmage {
 
+class EntityPlugin;
+
+/*! \brief Identifies the concrete Message<T> type of a message without RTTI.
+ *
+ * Each type gets the address of its own function-local static, so comparing
+ * two tags is a single pointer comparison.
+ */
+using MessageTypeTag = const void *;
+
+template <class T>
+MessageTypeTag message_type_tag() {
+    static const char tag = 0;
+    return &tag;
+}
+
 class MessageBase {
  public:
     virtual ~MessageBase() {}       // http://stackoverflow.com/a/5831797
@@ -46,7 +62,15 @@ class MessageBase {
     double time;
     std::string serialized_data;
 
-    std::string debug_info = "";
+    // Set by Message<T>, nullptr for messages that are not a Message<T>.
+    MessageTypeTag type_tag = nullptr;
+
+    // Filled in by Publisher::publish(). Only turned into a string by
+    // debug_info() when a subscriber cannot cast the message.
+    const std::type_info *publisher_type = nullptr;
+    std::weak_ptr<EntityPlugin> publisher_plugin;
+
+    std::string debug_info() const;
 };
 
 using MessageBasePtr = std::shared_ptr<MessageBase>;
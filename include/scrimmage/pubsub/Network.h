@@ -36,6 +36,7 @@
 #include <scrimmage/fwd_decl.h>
 #include <scrimmage/entity/EntityPlugin.h>
 #include <scrimmage/common/CSV.h>
+#include <scrimmage/pubsub/TopicTable.h>
 
 #include <map>
 #include <list>
@@ -52,6 +53,15 @@ class Network : public EntityPlugin {
 
     virtual bool init(std::map<std::string, std::string> &/*mission_params*/,
                       std::map<std::string, std::string> &/*plugin_params*/);
+
+    /*! \brief Called by SimControl every step. The default builds name keyed
+     * device maps from the table and calls the map overload, so networks
+     * that override that overload keep working. Networks that don't should
+     * override this to call step_topics() and skip the conversion. */
+    virtual bool step(TopicTable &topics);
+
+    /*! \brief Step using name keyed device maps. The default converts the
+     * maps to a temporary TopicTable and calls step_topics(). */
     virtual bool step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
                       std::map<std::string, std::list<NetworkDevicePtr>> &subs);
     std::string type() override;
@@ -81,8 +91,19 @@ class Network : public EntityPlugin {
     // Key 1: Publisher Entity ID
     // Key 2: Subscriber Entity ID
     // Value : Whether the publisher can reach the subscriber with a message
+    // Cleared every step. Kept for networks that manage their own cache;
+    // reachable_ids() is the cheaper alternative.
     std::unordered_map<int, std::unordered_map<int, bool>> reachable_map_;
 
+    /*! \brief Sorted IDs of the entities that pub_ent can reach during the
+     * current step. The list is built by find_reachable() the first time a
+     * publisher entity is seen in a step and reused for every subscriber. */
+    const std::vector<int> &reachable_ids(const EntityPtr &pub_ent);
+
+    /*! \brief Fill ids with the entities reachable from pub_ent. Only called
+     * through reachable_ids(). The default reaches no one. */
+    virtual void find_reachable(const EntityPtr &pub_ent, std::vector<int> &ids);
+
     virtual bool is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                               const scrimmage::EntityPluginPtr &sub_plugin);
 
@@ -91,6 +112,9 @@ class Network : public EntityPlugin {
 
     virtual double get_transmission_delay();
 
+    /*! \brief Deliver the messages of all topics in the table. */
+    bool step_topics(TopicTable &topics);
+
     bool network_init(std::map<std::string, std::string> &/*mission_params*/,
                       std::map<std::string, std::string> &/*plugin_params*/);
 
@@ -98,6 +122,22 @@ class Network : public EntityPlugin {
     // Key: Topic String
     std::map<std::string, unsigned int> pub_counts_;
     std::map<std::string, unsigned int> sub_counts_;
+
+    // Index: topic id. Points into pub_counts_ / sub_counts_, or nullptr if
+    // the topic isn't monitored.
+    std::vector<unsigned int *> pub_count_ptrs_;
+    std::vector<unsigned int *> sub_count_ptrs_;
+    const TopicTable *count_ptrs_table_ = nullptr;
+    size_t count_ptrs_num_topics_ = 0;
+    void update_count_ptrs(TopicTable &topics);
+
+    // Storage for reachable_ids(). Rows are reused between steps.
+    std::unordered_map<int, size_t> reachable_index_;
+    std::vector<std::vector<int>> reachable_rows_;
+    size_t num_reachable_rows_ = 0;
+    int last_reachable_id_ = -1;
+    size_t last_reachable_row_ = 0;
+
     bool monitor_all_pubs_ = false;
     bool monitor_all_subs_ = false;
 
@@ -33,11 +33,13 @@
 #ifndef INCLUDE_SCRIMMAGE_PUBSUB_NETWORKDEVICE_H_
 #define INCLUDE_SCRIMMAGE_PUBSUB_NETWORKDEVICE_H_
 
+#include <scrimmage/common/RingBuffer.h>
 #include <scrimmage/pubsub/MessageBase.h>
 #include <scrimmage/pubsub/Message.h>
 
 #include <type_traits>
 #include <list>
+#include <vector>
 #include <memory>
 #include <string>
 #include <mutex> // NOLINT
@@ -62,6 +64,7 @@ class NetworkDevice {
     void set_topic(const std::string &topic);
 
     void set_msg_list(const std::list<MessageBasePtr> &msg_list);
+    std::list<MessageBasePtr> get_msg_list();
     void clear_msg_list();
 
     unsigned int msg_list_size() {
@@ -83,6 +86,9 @@ class NetworkDevice {
     void add_msg(MessageBasePtr msg);
 
     /* added for delay handling */
+    std::list<MessageBasePtr> &undelivered_msg_list() {
+        return undelivered_msg_list_;
+    }
     void add_undelivered_msg(MessageBasePtr msg, const bool& is_stochastic_delay = false);
     auto deliver_undelivered_msg(std::list<MessageBasePtr>::iterator it);
     int deliver_undelivered_msg(const double& time_now,
@@ -91,45 +97,46 @@ class NetworkDevice {
 
     template <class T = MessageBase,
               class = std::enable_if_t<std::is_same<T, MessageBase>::value, void>>
-    std::list<MessageBasePtr> pop_msgs() {
+    std::vector<MessageBasePtr> pop_msgs() {
+        std::vector<MessageBasePtr> msgs;
         mutex_.lock();
-        std::list<MessageBasePtr> msg_list_cast;
-
-        auto it = msg_list_.begin();
-        while (it != msg_list_.end()) {
-            msg_list_cast.push_back(*it);
-            it = msg_list_.erase(it);
-        }
+        msgs.reserve(msg_list_.size());
+        msg_list_.drain(msgs);
         mutex_.unlock();
-        return msg_list_cast;
+        return msgs;
     }
 
     template <class T,
               class = std::enable_if_t<!std::is_same<T, MessageBase>::value &&
                                        std::is_base_of<MessageBase, T>::value, void>>
-    std::list<std::shared_ptr<T>> pop_msgs() {
+    std::vector<std::shared_ptr<T>> pop_msgs() {
+        const MessageTypeTag tag = message_type_tag<T>();
+        std::vector<std::shared_ptr<T>> msgs;
         mutex_.lock();
-        std::list<std::shared_ptr<T>> msg_list_cast;
-
-        auto it = msg_list_.begin();
-        while (it != msg_list_.end()) {
-            auto msg_cast = std::dynamic_pointer_cast<T>(*it);
-            if (msg_cast) {
-                msg_list_cast.push_back(msg_cast);
-                } else {
+        msgs.reserve(msg_list_.size());
+
+        while (!msg_list_.empty()) {
+            MessageBasePtr &msg = msg_list_.front();
+            // A tag match guarantees that msg is (or derives from) T, see
+            // Subscriber::accept()
+            if (msg->type_tag == tag) {
+                msgs.push_back(std::static_pointer_cast<T>(msg));
+            } else if (auto msg_cast = std::dynamic_pointer_cast<T>(msg)) {
+                msgs.push_back(msg_cast);
+            } else {
                 print_str(std::string("WARNING: could not cast message on topic \"")
                           + topic_);
             }
-            it = msg_list_.erase(it);
+            msg_list_.pop_front();
         }
         mutex_.unlock();
-        return msg_list_cast;
+        return msgs;
     }
 
     template <class T,
               class = std::enable_if_t<!std::is_same<T, MessageBase>::value &&
                                        !std::is_base_of<MessageBase, T>::value, void>>
-    std::list<std::shared_ptr<Message<T>>> pop_msgs() {
+    std::vector<std::shared_ptr<Message<T>>> pop_msgs() {
         return pop_msgs<Message<T>>();
     }
 
@@ -179,7 +186,7 @@ class NetworkDevice {
     bool enable_queue_size_ = false;
     EntityPluginPtr plugin_;
     void print_str(const std::string &msg);
-    std::list<MessageBasePtr> msg_list_;
+    RingBuffer<MessageBasePtr> msg_list_;
     std::mutex mutex_;
 
     /* added for delay handling */
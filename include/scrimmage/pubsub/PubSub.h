@@ -34,11 +34,14 @@
 #define INCLUDE_SCRIMMAGE_PUBSUB_PUBSUB_H_
 
 #include <scrimmage/pubsub/Subscriber.h>
+#include <scrimmage/pubsub/TopicTable.h>
 
 #include <map>
 #include <list>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace boost {
 template <class T> class optional;
@@ -64,8 +67,20 @@ class PubSub {
     TopicMap &pubs() { return pub_map_; }
     TopicMap &subs() { return sub_map_; }
 
+    /*! \brief The devices of one network indexed by topic id, used by
+     * Network::step(). */
+    TopicTable &topic_table(const std::string &network_name) {
+        return topic_tables_[network_name];
+    }
+
+    /*! \brief Return the integer id of a topic, interning it if needed. */
+    int topic_id(const std::string &topic);
+
     void add_network_name(const std::string &str);
 
+    /*! \brief Remove all publishers, subscribers, and networks. */
+    void clear();
+
     boost::optional<std::list<NetworkDevicePtr>> find_devices(const std::string &network_name,
                                                               const std::string &topic_name,
                                                               TopicMap &devs);
@@ -91,6 +106,7 @@ class PubSub {
             std::make_shared<Subscriber<T, CallbackFunc>>(
                 topic, max_queue_size, enable_queue_size, plugin, callback);
         sub_map_[network_name][topic].push_back(sub);
+        topic_tables_[network_name].add_sub(topic_id(topic), topic, sub);
         return sub;
     }
 
@@ -98,9 +114,29 @@ class PubSub {
                            const unsigned int& max_queue_size,
                            const bool& enable_queue_size, EntityPluginPtr plugin);
 
+    /*! \brief The publishers, subscribers, and queued messages saved by
+     * snapshot(). */
+    struct Snapshot {
+        TopicMap pubs;
+        TopicMap subs;
+        std::map<std::string, TopicTable> topic_tables;
+        // Key  : device
+        // Value: queued and undelivered (delayed) messages
+        std::map<NetworkDevicePtr, std::pair<std::list<MessageBasePtr>,
+                                             std::list<MessageBasePtr>>> queues;
+    };
+
+    void snapshot(Snapshot &snap);
+
+    /*! \brief Return to the saved devices and queues. Devices created after
+     * the snapshot are dropped. */
+    void restore(const Snapshot &snap);
+
  protected:
     TopicMap pub_map_;
     TopicMap sub_map_;
+    std::map<std::string, TopicTable> topic_tables_;
+    std::unordered_map<std::string, int> topic_ids_;
     void print_str(const std::string &s);
 };
 using PubSubPtr = std::shared_ptr<PubSub>;
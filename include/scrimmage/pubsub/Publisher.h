@@ -38,6 +38,7 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <typeinfo>
 
 #include <boost/type_index.hpp>
 
@@ -54,14 +55,14 @@ class Publisher : public NetworkDevice {
 
     template <class T> void publish(const std::shared_ptr<T> &msg, bool add_debug_info = true) {
         if (add_debug_info) {
-            set_debug_info(msg, boost::typeindex::type_id<T>().pretty_name());
+            set_debug_info(msg, typeid(T));
         }
         add_msg(msg);
     }
     std::function<void(MessageBasePtr)> callback;
 
  protected:
-    void set_debug_info(MessageBasePtr msg, const std::string &type);
+    void set_debug_info(const MessageBasePtr &msg, const std::type_info &type);
 };
 
 } // namespace scrimmage
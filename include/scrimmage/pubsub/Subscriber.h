@@ -49,9 +49,20 @@ class Subscriber : public SubscriberBase {
                CallbackFunc callback)
         : SubscriberBase(topic, max_queue_size, enable_queue_size, plugin),
         callback_(callback) {
+        type_tag_ = message_type_tag<Message<T>>();
     }
 
     void accept(scrimmage::MessageBasePtr msg) override {
+        // Fast path: the tag was written by the Message<T> constructor, so a
+        // match guarantees that msg really is (or derives from) Message<T>.
+        if (msg->type_tag == type_tag_) {
+            auto msg_cast = std::static_pointer_cast<Message<T>>(msg);
+            callback_(msg_cast);
+            return;
+        }
+
+        // A plugin library built with hidden symbols gets its own copy of
+        // the tag, so fall back to the checked cast before giving up.
         auto msg_cast = std::dynamic_pointer_cast<Message<T>>(msg);
         if (msg_cast != nullptr) {
             callback_(msg_cast);
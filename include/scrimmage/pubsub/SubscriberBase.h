@@ -47,7 +47,12 @@ class SubscriberBase : public NetworkDevice {
         NetworkDevice(topic, max_queue_size, enable_queue_size, plugin) {}
     virtual void accept(scrimmage::MessageBasePtr msg) = 0;
 
+    /*! \brief The Message<T> type tag this subscriber expects, or nullptr if
+     * it accepts any type. */
+    MessageTypeTag type_tag() const { return type_tag_; }
+
  protected:
+    MessageTypeTag type_tag_ = nullptr;
     void print_err(const std::string &type, MessageBasePtr msg) const;
 };
 
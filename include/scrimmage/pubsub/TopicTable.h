@@ -0,0 +1,100 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_PUBSUB_TOPICTABLE_H_
+#define INCLUDE_SCRIMMAGE_PUBSUB_TOPICTABLE_H_
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scrimmage {
+
+class NetworkDevice;
+using NetworkDevicePtr = std::shared_ptr<NetworkDevice>;
+
+/*! \brief The publishers and subscribers of one network, indexed by topic id.
+ *
+ * Topic ids are handed out by PubSub when a topic is first advertised or
+ * subscribed to, so Network::step() can walk the table without any string
+ * lookups. topic_order() lists the ids in topic name order, which keeps
+ * message delivery (and random number draws) in the same order as the
+ * name-keyed maps.
+ */
+class TopicTable {
+ public:
+    struct Topic {
+        std::string name;
+        std::vector<NetworkDevicePtr> pubs;
+        std::vector<NetworkDevicePtr> subs;
+    };
+
+    void add_pub(int topic_id, const std::string &name, const NetworkDevicePtr &dev) {
+        topic(topic_id, name).pubs.push_back(dev);
+    }
+
+    void add_sub(int topic_id, const std::string &name, const NetworkDevicePtr &dev) {
+        topic(topic_id, name).subs.push_back(dev);
+    }
+
+    std::vector<Topic> &topics() { return topics_; }
+    const std::vector<int> &topic_order() const { return order_; }
+
+    void clear() {
+        topics_.clear();
+        order_.clear();
+    }
+
+ protected:
+    Topic &topic(int topic_id, const std::string &name) {
+        if (topic_id >= static_cast<int>(topics_.size())) {
+            topics_.resize(topic_id + 1);
+        }
+        Topic &t = topics_[topic_id];
+        if (t.pubs.empty() && t.subs.empty()) {
+            auto it = std::lower_bound(order_.begin(), order_.end(), name,
+                [&](int id, const std::string &n) { return topics_[id].name < n; });
+            if (it == order_.end() || *it != topic_id) {
+                t.name = name;
+                order_.insert(it, topic_id);
+            }
+        }
+        return t;
+    }
+
+    std::vector<Topic> topics_;
+    std::vector<int> order_;
+};
+
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_PUBSUB_TOPICTABLE_H_
@@ -0,0 +1,150 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_SIMCONTROL_BATCHRUNNER_H_
+#define INCLUDE_SCRIMMAGE_SIMCONTROL_BATCHRUNNER_H_
+
+#include <scrimmage/fwd_decl.h>
+#include <scrimmage/common/Random.h>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace scrimmage {
+class MissionImage;
+class SimControl;
+
+/**
+ * A parameter varied by a batch. In a ranges file, each child element of the
+ * root describes one mission variable ${name=default}, e.g.:
+ *
+ *     <max_speed low="15" high="25" type="float" count="3"/>
+ *     <gain vec="0.5,1,2"/>
+ */
+struct ParameterRange {
+    std::string name;
+    std::string type = "float"; // "float" or "int"
+    double low = 0;
+    double high = 0;
+    int count = 0; // number of values for the grid method
+    std::vector<std::string> vec; // discrete values, used instead of low/high
+};
+
+/**
+ * @brief Runs many variations of one mission concurrently in one process.
+ *
+ * The mission file is read once and each run parses it with its own
+ * overrides in its own SimControl. The SimControls share one PluginManager,
+ * so each plugin library is searched for and opened once. Each run's team
+ * scores and metrics are appended to one summary csv as the run finishes.
+ */
+class BatchRunner {
+ public:
+    BatchRunner();
+
+    bool init(const std::string &mission_file);
+
+    bool parse_ranges(const std::string &ranges_file);
+    void set_ranges(const std::vector<ParameterRange> &ranges);
+
+    /// @brief "lhs" (latin hypercube, num_runs samples) or "grid" (every
+    /// combination of count values per parameter)
+    void set_method(const std::string &method);
+    void set_num_runs(int num_runs);
+    void set_num_repeats(int num_repeats);
+
+    /// @brief Number of runs executing at once, including the calling thread.
+    void set_num_threads(int num_threads);
+
+    /// @brief Run i uses seed + i. The default seed is time based.
+    void set_seed(uint32_t seed);
+
+    /// @brief Overrides of the form "key=value,key2=value2" for every run.
+    void set_overrides(const std::string &overrides);
+    void set_job_number(int job_number);
+
+    /// @brief Defaults to batch_summary.csv in the mission's root log dir.
+    void set_summary_file(const std::string &summary_file);
+
+    /// @brief Generate the parameter values of each run.
+    bool generate_runs();
+    std::vector<std::map<std::string, std::string>> &runs();
+
+    /// @brief Returns false if any run failed.
+    bool run();
+
+    /// @brief Stop the running simulations and skip the remaining runs.
+    void force_exit();
+
+ protected:
+    bool run_one(size_t index);
+    void write_summary(size_t index, bool status, SimControl &simcontrol);
+    std::string format(const ParameterRange &range, double value);
+
+    std::string mission_filename_;
+    std::string mission_content_;
+    // The mission if it was compiled with "scrimmage --compile-mission"
+    std::shared_ptr<const MissionImage> mission_image_;
+    PluginManagerPtr plugin_manager_;
+
+    std::vector<ParameterRange> ranges_;
+    std::string method_ = "lhs";
+    int num_runs_ = 1;
+    int num_repeats_ = 1;
+    int num_threads_ = 1;
+    bool seed_set_ = false;
+    uint32_t seed_ = 0;
+    Random random_;
+    std::string overrides_;
+    int job_number_ = -1;
+
+    std::vector<std::map<std::string, std::string>> runs_;
+
+    std::atomic<bool> exit_{false};
+    std::mutex active_mutex_;
+    std::list<SimControl *> active_;
+
+    std::mutex summary_mutex_;
+    std::string summary_file_;
+    std::ofstream summary_;
+    std::list<std::string> summary_headers_;
+};
+} // namespace scrimmage
+
+#endif // INCLUDE_SCRIMMAGE_SIMCONTROL_BATCHRUNNER_H_
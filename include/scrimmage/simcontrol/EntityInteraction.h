@@ -60,6 +60,13 @@ class EntityInteraction : public EntityPlugin {
                                   Eigen::Vector3d &/*p*/)
     { return false; }
 
+    /**
+     * @brief Minimum distance between the initial position of a generated
+     * entity and the other entities. SimControl rejects closer positions with
+     * a grid before calling collision_exists(). 0 disables the check.
+     */
+    inline virtual double startup_collision_range() { return 0; }
+
  protected:
 };
 
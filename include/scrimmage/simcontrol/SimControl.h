@@ -39,13 +39,15 @@
 
 #include <scrimmage/common/Timer.h>
 #include <scrimmage/common/DelayedTask.h>
+#include <scrimmage/common/TaskExecutor.h>
 #include <scrimmage/common/FileSearch.h>
+#include <scrimmage/log/FrameDelta.h>
+#include <scrimmage/simcontrol/SpawnPlacer.h>
 #include <scrimmage/proto/Shape.pb.h>
 #include <scrimmage/proto/Visual.pb.h>
 
-#include <future> // NOLINT
+#include <functional>
 #include <memory>
-#include <deque>
 #include <vector>
 #include <set>
 #include <string>
@@ -53,7 +55,6 @@
 #include <map>
 #include <list>
 #include <mutex> // NOLINT
-#include <condition_variable> // NOLINT
 #include <unordered_map>
 
 namespace scrimmage {
@@ -145,6 +146,42 @@ class SimControl {
      */
     bool run_single_step(const int& loop_number);
 
+    /**
+     * @brief Save the simulation state, so that restore() can return to it.
+     *
+     * Call after start() and after the initial entities are generated. The
+     * snapshot holds the time, the random generator, the entity generation
+     * bookkeeping, the entity and motion model states, the pub/sub queues,
+     * and the state that plugins save through EntityPlugin::save_state().
+     * While a snapshot is held, removed entities are not closed, so that
+     * restore() can bring them back.
+     *
+     * Example API usage:
+     *
+     *  \code{.cpp}
+     *  simcontrol.start();
+     *  simcontrol.snapshot();
+     *  for (int episode = 0; episode < 100; episode++) {
+     *      int i = 0;
+     *      while (simcontrol.run_single_step(i++)) {}
+     *      simcontrol.restore();
+     *  }
+     *  \endcode
+     */
+    bool snapshot();
+
+    /**
+     * @brief Return to the state saved by snapshot().
+     *
+     * Entities generated after the snapshot are closed. The log is not
+     * rewound, so the frames of later episodes are appended to it. Returns
+     * false if there is no snapshot.
+     */
+    bool restore();
+
+    /// @brief Drop the snapshot and close the entities that it kept.
+    void clear_snapshot();
+
     /**
      * @brief Finalizes the simulation, closes logs, closes plugins.
      *
@@ -210,9 +247,16 @@ class SimControl {
     /**
      * @brief Generate an entity given the entity description ID and
      * parameters.
+     *
+     * If use_prototype is true and the clone_entities mission option is
+     * enabled, the entity is initialized from a prototype of the entity block
+     * when its plugins support cloning (see EntityPlugin::clone()). The
+     * params should then only differ from the entity block's description in
+     * the initial state.
      */
     bool generate_entity(const int &ent_desc_id,
-                         std::map<std::string, std::string> &params);
+                         std::map<std::string, std::string> &params,
+                         bool use_prototype = false);
 
     /// @brief Get the pointer to the MissionParser instance.
     MissionParsePtr mp();
@@ -260,6 +304,15 @@ class SimControl {
     /// @brief Access the metrics plugins.
     std::list<MetricsPtr> & metrics();
 
+    /**
+     * @brief Combine the team scores, team metrics and csv headers of all
+     * metrics plugins, as written to summary.csv. The team scores have to be
+     * calculated first.
+     */
+    void team_summary(std::map<int, double> &team_scores,
+                      std::map<int, std::map<std::string, double>> &team_metrics,
+                      std::list<std::string> &headers);
+
     /// @brief Access the PluginManager instance.
     PluginManagerPtr &plugin_manager();
 
@@ -269,17 +322,19 @@ class SimControl {
     struct Task {
         // FIXME: this will be much simpler once there is a
         // step function in Plugin.h
-        // In particular, we can get rid of Task::Type and
-        // more easily do entity_interaction/network plugins in multiple threads.
+        // In particular, we can get rid of Task::Type.
         enum class Type {AUTONOMY, CONTROLLER, MOTION, SENSOR};
-
-        Type type;
-        double t;
-        double dt;
-        EntityPtr ent;
-        std::promise<bool> prom;
     };
 
+    /**
+     * @brief Access the executor that runs the multi_threaded entity phases.
+     *
+     * Null unless the multi_threaded mission option is enabled. Entity
+     * interaction, network and metrics code can use it for their own
+     * parallel loops.
+     */
+    TaskExecutorPtr &executor();
+
     /**
      * @brief Set the incoming interface for communication from external
      * visualizers.
@@ -334,6 +389,7 @@ class SimControl {
     std::list<EntityPtr> ents_;
 
     ContactMapPtr contacts_;
+    std::shared_ptr<ContactSnapshot> contact_snapshot_;
 
     std::map<int, std::list<scrimmage_proto::ShapePtr>> shapes_;
 
@@ -371,18 +427,39 @@ class SimControl {
     std::mutex take_step_mutex_;
     std::mutex time_mutex_;
     std::mutex time_warp_mutex_;
-    std::mutex entity_pool_mutex_;
 
     std::set<Task::Type> entity_thread_types_;
     int num_entity_threads_ = 0;
-    bool entity_pool_stop_ = false;
-    std::deque<std::shared_ptr<Task>> entity_pool_queue_;
-    std::condition_variable_any entity_pool_condition_var_;
-    std::vector<std::thread> entity_worker_threads_;
-    void worker();
+    TaskExecutorPtr executor_;
+    std::vector<Entity *> task_ents_;
     bool run_entities();
 
-    bool add_tasks(Task::Type type, double t, double dt);
+    std::vector<std::vector<Autonomy *>> autonomy_batches_;
+
+    /// @brief Step the autonomies that support batching, one call per type
+    bool run_autonomy_batches(double t, double dt);
+
+    bool batch_motion_ = false;
+
+    SpawnPlacer spawn_placer_;
+
+    /// @brief Set the spawn placer's grid to the entities' positions
+    void reset_spawn_placer();
+
+    bool clone_entities_ = true;
+    // Key: entity description ID. A nullptr value means that the entity
+    // block's plugins can't be cloned.
+    std::unordered_map<int, EntityPtr> prototypes_;
+    std::vector<std::vector<MotionModel *>> motion_batches_;
+    std::vector<Entity *> unbatched_ents_;
+
+    /// @brief Group the entities' motion models by type for step_batch()
+    void group_motion_models();
+    bool run_motion_batches(double t, double dt);
+
+    bool run_tasks(Task::Type type, double t, double dt);
+    bool run_tasks(const std::function<bool(Entity &)> &step);
+    bool step_entity(Task::Type type, Entity &ent, double t, double dt);
 
     bool run_sensors();
     bool run_motion(EntityPtr &ent, double t, double dt);
@@ -390,6 +467,9 @@ class SimControl {
 
     std::shared_ptr<Log> log_;
 
+    bool frame_delta_ = false;
+    FrameDeltaEncoder frame_encoder_;
+
     std::set<EndConditionFlags> end_conditions_ = {EndConditionFlags::NONE};
 
     RandomPtr random_;
@@ -410,9 +490,12 @@ class SimControl {
     RTreePtr rtree_;
 
     void request_screenshot();
-    void create_rtree(const unsigned int& additional_size);
+    void create_rtree();
     void run_autonomy();
     void set_autonomy_contacts();
+
+    /// @brief Copy the contact states into the snapshot read by the plugins
+    void update_contact_snapshot();
     void run_dynamics();
     bool run_interaction_detection();
     bool run_logging();
@@ -436,6 +519,12 @@ class SimControl {
     PublisherPtr pub_custom_key_;
 
     std::list<EntityPtr> not_ready_;
+
+    struct Snapshot;
+    std::shared_ptr<Snapshot> snapshot_;
+    // Entities removed while a snapshot is held. They are closed by
+    // restore() or clear_snapshot().
+    std::list<EntityPtr> removed_ents_;
     DelayedTask screenshot_task_;
     bool prev_paused_;
 
@@ -0,0 +1,128 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#ifndef INCLUDE_SCRIMMAGE_SIMCONTROL_SPAWNPLACER_H_
+#define INCLUDE_SCRIMMAGE_SIMCONTROL_SPAWNPLACER_H_
+
+#include <scrimmage/common/ID.h>
+#include <scrimmage/common/SpatialHash.h>
+
+#include <Eigen/Dense>
+
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace scrimmage {
+
+/**
+ * @brief Chooses collision-free initial positions for generated entities.
+ *
+ * Positions are drawn from the entity block's normal distribution around the
+ * block's position. A sample is rejected if it is closer than the separation
+ * to an entity that was already placed, which is checked with a uniform grid
+ * that is updated as the entities are placed, or if the collision function
+ * (e.g., the entity interactions' collision_exists()) returns true.
+ *
+ * With the PoissonDisk method, the entities after the first one of a block
+ * are placed with Bridson's algorithm: candidates are drawn between one and
+ * two separations away from a random entity of the block that was placed
+ * before, within three standard deviations of the block's position. This
+ * fills dense blocks in a few samples per entity, where independent samples
+ * are mostly rejected. The axes without variance are kept at the block's
+ * position. If no candidate fits, independent samples are drawn.
+ */
+class SpawnPlacer {
+ public:
+    enum class Method {Variance, PoissonDisk};
+
+    SpawnPlacer();
+
+    void set_method(Method method);
+    Method method() const { return method_; }
+
+    /// @brief Minimum distance between entities. 0 disables the grid.
+    void set_separation(double separation);
+    double separation() const { return separation_; }
+
+    /// @brief Number of Poisson-disk candidates around each placed entity
+    void set_candidates(int candidates);
+    void set_max_attempts(int max_attempts);
+
+    /**
+     * @brief Replace the placed entities, e.g., with the current positions of
+     * the entities before a group of entities is generated.
+     */
+    void reset(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries);
+    void add(const Eigen::Vector3d &pos, const ID &id);
+
+    /// @brief Whether pos is closer than the separation to a placed entity
+    bool occupied(const Eigen::Vector3d &pos) const;
+
+    /**
+     * @brief Choose the initial position of an entity of a block.
+     *
+     * The position is the mean unless it is rejected or sample is true.
+     * Returns false if no position was found in max_attempts samples, or as
+     * soon as cancel returns true (e.g., the simulation was told to exit).
+     * The caller adds the entity with add() after it is created.
+     */
+    bool place(int block_id, const Eigen::Vector3d &mean,
+               const Eigen::Vector3d &stddev, bool sample,
+               std::default_random_engine &gener,
+               const std::function<bool(const Eigen::Vector3d &)> &collision,
+               const std::function<bool()> &cancel,
+               Eigen::Vector3d &pos);
+
+ protected:
+    bool place_poisson_disk(int block_id, const Eigen::Vector3d &mean,
+                            const Eigen::Vector3d &stddev,
+                            std::default_random_engine &gener,
+                            const std::function<bool(const Eigen::Vector3d &)> &rejected,
+                            const std::function<bool()> &cancel,
+                            Eigen::Vector3d &pos);
+
+    Method method_ = Method::Variance;
+    double separation_ = 0;
+    int candidates_ = 30;
+    int max_attempts_ = 1e6;
+
+    SpatialHash grid_;
+
+    // Key: entity block ID, Value: positions of the block's entities that may
+    // still have room for Poisson-disk candidates around them
+    std::unordered_map<int, std::vector<Eigen::Vector3d>> active_;
+};
+} // namespace scrimmage
+#endif // INCLUDE_SCRIMMAGE_SIMCONTROL_SPAWNPLACER_H_
@@ -88,6 +88,7 @@ class Viewer {
     int local_port_ = 50051;
     std::string remote_ip_ = "localhost";
     int remote_port_ = 50052;
+    bool shared_memory_ = false;
 };
 
 } // namespace scrimmage
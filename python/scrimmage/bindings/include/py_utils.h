@@ -38,3 +38,4 @@ void add_pubsub(pybind11::module &m);
 void add_common(pybind11::module &m);
 void add_autonomy(pybind11::module &m);
 void add_openai_env(pybind11::module &m);
+void add_vec_env(pybind11::module &m);
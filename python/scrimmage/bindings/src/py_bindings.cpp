@@ -45,6 +45,7 @@ PYBIND11_MODULE(py_bindings, m) {
     add_common(m);
     add_autonomy(m);
     add_openai_env(m);
+    add_vec_env(m);
 
     m.def("frames2pandas", &frames2pandas, "converts a protobuf frames.bin file to a pandas DataFrame");
 }
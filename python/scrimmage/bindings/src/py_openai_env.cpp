@@ -97,12 +97,14 @@ ScrimmageOpenAIEnv::ScrimmageOpenAIEnv(
         bool combine_actors,
         bool global_sensor,
         bool static_obs_space,
-        double timestep) :
+        double timestep,
+        bool fast_reset) :
     spec(py::none()),
     metadata(py::dict()),
     mission_file_(mission_file),
     enable_gui_(enable_gui),
-    static_obs_space_(static_obs_space) {
+    static_obs_space_(static_obs_space),
+    fast_reset_(fast_reset) {
 
     observations_.set_global_sensor(global_sensor);
     observations_.set_combine_actors(combine_actors);
@@ -173,12 +175,28 @@ pybind11::object ScrimmageOpenAIEnv::reset() {
     sigaction(SIGINT, &sa, NULL);
     sigaction(SIGTERM, &sa, NULL);
 
-    reset_scrimmage(enable_gui_);
+    reset_episode();
     observations_.update_observation(actions_.ext_ctrl_vec().size(),
                                      static_obs_space_);
     return observations_.observation;
 }
 
+void ScrimmageOpenAIEnv::reset_episode() {
+    if (fast_reset_ && simcontrol_ && simcontrol_->restore()) {
+        // Return to the state after the entities were generated instead of
+        // parsing the mission and loading the plugins again. Without a
+        // seed, every episode still draws different random numbers.
+        if (!seed_set_) {
+            simcontrol_->plugin()->parent()->random()->seed();
+        }
+        delayed_task_.last_updated_time = -std::numeric_limits<double>::infinity();
+        loop_number_ = 0;
+        find_learners();
+    } else {
+        reset_scrimmage(enable_gui_);
+    }
+}
+
 void ScrimmageOpenAIEnv::scrimmage_memory_cleanup() {
     // temporary fix until scrimmage uses weak pointers
     actions_.ext_ctrl_vec().clear();
@@ -186,6 +204,7 @@ void ScrimmageOpenAIEnv::scrimmage_memory_cleanup() {
 
     if (!simcontrol_) return;
 
+    simcontrol_->clear_snapshot();
     for (auto e : simcontrol_->ents()) {
         auto s = std::make_shared<sc::State>();
         if (e->motion()) {
@@ -317,6 +336,17 @@ void ScrimmageOpenAIEnv::reset_scrimmage(bool enable_gui) {
         py::print("scrimmage entity generation unsuccessful");
     }
 
+    if (fast_reset_ && !enable_gui) {
+        simcontrol_->snapshot();
+    }
+
+    find_learners();
+    observations_.create_observation_space(actions_.ext_ctrl_vec().size());
+    actions_.create_action_space(observations_.get_combine_actors());
+    set_reward_range();
+}
+
+void ScrimmageOpenAIEnv::find_learners() {
     actions_.ext_ctrl_vec().clear();
     observations_.ext_sensor_vec().clear();
     for (auto &e : simcontrol_->ents()) {
@@ -327,9 +357,6 @@ void ScrimmageOpenAIEnv::reset_scrimmage(bool enable_gui) {
             observations_.add_sensors(a->parent()->sensors());
         }
     }
-    observations_.create_observation_space(actions_.ext_ctrl_vec().size());
-    actions_.create_action_space(observations_.get_combine_actors());
-    set_reward_range();
 }
 
 void ScrimmageOpenAIEnv::close_viewer() {
@@ -346,10 +373,14 @@ void ScrimmageOpenAIEnv::close() {
 void ScrimmageOpenAIEnv::seed(pybind11::object _seed) {
     seed_set_ = true;
     seed_ = _seed.cast<int>();
+
+    // the snapshot was taken with the old seed
+    if (simcontrol_) simcontrol_->clear_snapshot();
 }
 
 void ScrimmageOpenAIEnv::filter_ext_ctrl_vec(){
-    auto no_parent = [&](auto &p){return p->parent() == nullptr;};
+    // removed entities are kept open while SimControl holds a snapshot
+    auto no_parent = [&](auto &p){return p->parent() == nullptr || !p->parent()->active();};
     actions_.ext_ctrl_vec().erase(std::remove_if(actions_.ext_ctrl_vec().begin(),
                                                  actions_.ext_ctrl_vec().end(),
                                                  no_parent),
@@ -357,7 +388,7 @@ void ScrimmageOpenAIEnv::filter_ext_ctrl_vec(){
 }
 
 void ScrimmageOpenAIEnv::filter_ext_sensor_vec(){
-    auto no_parent = [&](auto &p){return p[0]->parent() == nullptr;};
+    auto no_parent = [&](auto &p){return p[0]->parent() == nullptr || !p[0]->parent()->active();};
     observations_.ext_sensor_vec().erase(std::remove_if(observations_.ext_sensor_vec().begin(),
                                                         observations_.ext_sensor_vec().end(),
                                                         no_parent),
@@ -367,6 +398,28 @@ void ScrimmageOpenAIEnv::filter_ext_sensor_vec(){
 pybind11::tuple ScrimmageOpenAIEnv::step(pybind11::object action) {
     actions_.distribute_action(action, observations_.get_combine_actors());
 
+    bool done = advance();
+
+    observations_.update_observation(actions_.ext_ctrl_vec().size(),
+                                     static_obs_space_);
+
+    py::float_ py_reward;
+    py::bool_ py_done;
+    py::dict py_info;
+    std::tie(py_reward, py_done, py_info) = finish_step(done);
+
+    if (py_done.cast<bool>()) {
+        close_viewer();
+    }
+
+    return py::make_tuple(observations_.observation, py_reward, py_done, py_info);
+}
+
+void ScrimmageOpenAIEnv::set_action(const int *disc, const double *cont) {
+    actions_.distribute_action(disc, cont);
+}
+
+bool ScrimmageOpenAIEnv::advance() {
     delayed_task_.update(simcontrol_->t());
     bool done = !simcontrol_->run_single_step(loop_number_++) ||
         simcontrol_->end_condition_reached();
@@ -374,10 +427,19 @@ pybind11::tuple ScrimmageOpenAIEnv::step(pybind11::object action) {
         done = !simcontrol_->run_single_step(loop_number_++) ||
         simcontrol_->end_condition_reached();
     }
+    return done;
+}
 
-    observations_.update_observation(actions_.ext_ctrl_vec().size(),
-                                     static_obs_space_);
+void ScrimmageOpenAIEnv::write_observation(int *disc, double *cont) {
+    observations_.write_observation(actions_.ext_ctrl_vec().size(), disc, cont);
+}
 
+std::pair<size_t, size_t> ScrimmageOpenAIEnv::observation_size() {
+    return observations_.combined_size(actions_.ext_ctrl_vec().size());
+}
+
+std::tuple<pybind11::float_, pybind11::bool_, pybind11::dict>
+ScrimmageOpenAIEnv::finish_step(bool done) {
     py::float_ py_reward;
     py::bool_ py_done;
     py::dict py_info;
@@ -389,13 +451,7 @@ pybind11::tuple ScrimmageOpenAIEnv::step(pybind11::object action) {
     done |= py_done.cast<bool>();
     // If there aren't any RL entities left, we are done
     done |= actions_.ext_ctrl_vec().size() == 0;
-    py_done = py::bool_(done);
-
-    if (done) {
-        close_viewer();
-    }
-
-    return py::make_tuple(observations_.observation, py_reward, py_done, py_info);
+    return std::make_tuple(py_reward, py::bool_(done), py_info);
 }
 
 void ScrimmageOpenAIEnv::reset_learning_mode() {
@@ -458,7 +514,7 @@ std::tuple<pybind11::float_, pybind11::bool_, pybind11::dict> ScrimmageOpenAIEnv
 
 void add_openai_env(pybind11::module &m) {
     py::class_<ScrimmageOpenAIEnv>(m, "ScrimmageOpenAIEnv")
-        .def(py::init<std::string&, bool, bool, bool, bool, double>(),
+        .def(py::init<std::string&, bool, bool, bool, bool, double, bool>(),
             R"(Scrimmage Open AI Environment Constructor.
 
 Parameters
@@ -494,13 +550,21 @@ static_obs_space : bool
 timestep : float
     run scrimmage for multiple timesteps before outputting
     the observation and reward on env.step().
+
+fast_reset : bool
+    whether reset() returns to a snapshot taken after the first reset
+    instead of parsing the mission and loading the plugins again. The
+    entities start each episode where they were generated for the first
+    episode. Calling seed() takes a new snapshot on the next reset. Has no
+    effect when enable_gui is set.
 )",
             py::arg("mission_file"),
             py::arg("enable_gui") = false,
             py::arg("combine_actors") = false,
             py::arg("global_sensor") = false,
             py::arg("static_obs_space") = true,
-            py::arg("timestep") = -1)
+            py::arg("timestep") = -1,
+            py::arg("fast_reset") = false)
         .def("step", &ScrimmageOpenAIEnv::step,
             R"(Run scrimmage for one step.
 
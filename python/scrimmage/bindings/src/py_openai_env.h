@@ -41,6 +41,7 @@
 #include <vector>
 #include <thread> // NOLINT
 #include <tuple>
+#include <utility>
 
 namespace scrimmage {
 
@@ -60,7 +61,8 @@ class ScrimmageOpenAIEnv {
                        bool combine_actors = false,
                        bool global_sensor = false,
                        bool static_obs_space = true,
-                       double timestep = -1);
+                       double timestep = -1,
+                       bool fast_reset = false);
 
     pybind11::tuple step(pybind11::object action);
     pybind11::object reset();
@@ -85,6 +87,21 @@ class ScrimmageOpenAIEnv {
     bool get_combine_actors() {return observations_.get_combine_actors();}
     void set_combine_actors(bool combine_actors) {observations_.set_combine_actors(combine_actors);}
 
+    // Used by ScrimmageVecEnv. Except for reset_episode and finish_step,
+    // these do not touch python objects and can run without the GIL.
+
+    /// Starts a new episode without updating the observation.
+    void reset_episode();
+    void set_action(const int *disc, const double *cont);
+    /// Runs scrimmage until the next observation. Returns true when the
+    /// simulation has ended.
+    bool advance();
+    void write_observation(int *disc, double *cont);
+    /// Calculates the reward and returns (reward, done, info).
+    std::tuple<pybind11::float_, pybind11::bool_, pybind11::dict> finish_step(bool done);
+    std::pair<size_t, size_t> observation_size();
+    std::pair<size_t, size_t> action_size() {return actions_.combined_size();}
+
     pybind11::object spec;
     pybind11::object metadata;
 
@@ -99,6 +116,7 @@ class ScrimmageOpenAIEnv {
     std::string mission_file_ = "";
     bool enable_gui_ = false;
     bool static_obs_space_ = true;
+    bool fast_reset_ = false;
     scrimmage::DelayedTask delayed_task_;
 
     std::thread thread_;
@@ -116,6 +134,7 @@ class ScrimmageOpenAIEnv {
     void update_observation();
     std::tuple<pybind11::float_, pybind11::bool_, pybind11::dict> calc_reward();
     void reset_scrimmage(bool enable_gui);
+    void find_learners();
     void scrimmage_memory_cleanup();
     void reset_learning_mode();
     void filter_ext_sensor_vec();
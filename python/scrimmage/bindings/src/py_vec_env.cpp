@@ -0,0 +1,300 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include "py_vec_env.h"
+#include "py_openai_env.h"
+
+#include <scrimmage/common/TaskExecutor.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <thread> // NOLINT
+#include <tuple>
+#include <utility>
+#include <stdexcept>
+
+namespace py = pybind11;
+namespace sc = scrimmage;
+
+namespace {
+template <class T>
+T *row(T *data, size_t size, size_t i) {
+    return size == 0 ? nullptr : data + size * i;
+}
+} // namespace
+
+ScrimmageVecEnv::ScrimmageVecEnv(
+        const std::string &mission_file,
+        size_t num_envs,
+        int num_threads,
+        bool global_sensor,
+        double timestep,
+        bool fast_reset) :
+    spec(py::none()),
+    metadata(py::dict()) {
+
+    if (num_envs == 0) {
+        throw std::runtime_error("ScrimmageVecEnv needs at least one environment");
+    }
+
+    const bool enable_gui = false;
+    const bool combine_actors = true;
+    const bool static_obs_space = true;
+    for (size_t i = 0; i < num_envs; i++) {
+        envs_.emplace_back(new ScrimmageOpenAIEnv(
+            mission_file, enable_gui, combine_actors, global_sensor,
+            static_obs_space, timestep, fast_reset));
+    }
+
+    std::tie(obs_disc_size_, obs_cont_size_) = envs_[0]->observation_size();
+    std::tie(act_disc_size_, act_cont_size_) = envs_[0]->action_size();
+    for (auto &env : envs_) {
+        if (env->observation_size() != std::make_pair(obs_disc_size_, obs_cont_size_) ||
+                env->action_size() != std::make_pair(act_disc_size_, act_cont_size_)) {
+            throw std::runtime_error(
+                "ScrimmageVecEnv: the environments have different observation or action sizes");
+        }
+    }
+    reward_range = envs_[0]->reward_range;
+
+    if (num_threads <= 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::min(num_threads, static_cast<int>(num_envs));
+    executor_ = std::make_shared<sc::TaskExecutor>(num_threads);
+
+    disc_obs_ = py::array_t<int>({num_envs, obs_disc_size_});
+    cont_obs_ = py::array_t<double>({num_envs, obs_cont_size_});
+    disc_obs_data_ = disc_obs_.mutable_data();
+    cont_obs_data_ = cont_obs_.mutable_data();
+    if (obs_disc_size_ > 0 && obs_cont_size_ > 0) {
+        observation_ = py::make_tuple(disc_obs_, cont_obs_);
+    } else if (obs_cont_size_ > 0) {
+        observation_ = cont_obs_;
+    } else {
+        observation_ = disc_obs_;
+    }
+
+    rewards_ = py::array_t<double>(num_envs);
+    dones_ = py::array_t<bool>(num_envs);
+    sim_done_.resize(num_envs, 0);
+}
+
+ScrimmageVecEnv::~ScrimmageVecEnv() {}
+
+pybind11::object ScrimmageVecEnv::get_observation_space() {
+    return envs_[0]->get_observation_space();
+}
+
+pybind11::object ScrimmageVecEnv::get_action_space() {
+    return envs_[0]->get_action_space();
+}
+
+pybind11::object ScrimmageVecEnv::reset() {
+    for (size_t i = 0; i < envs_.size(); i++) {
+        envs_[i]->reset_episode();
+        write_observation(i);
+    }
+    return observation_;
+}
+
+void ScrimmageVecEnv::set_action(pybind11::object action) {
+    const size_t num_envs = envs_.size();
+    if (act_disc_size_ > 0 && act_cont_size_ > 0) {
+        py::sequence seq = action.cast<py::sequence>();
+        if (py::len(seq) != 2) {
+            throw std::runtime_error(
+                "ScrimmageVecEnv: expected a (discrete, continuous) pair of actions");
+        }
+        disc_act_ = seq[0].cast<IntArray>();
+        cont_act_ = seq[1].cast<DoubleArray>();
+    } else if (act_cont_size_ > 0) {
+        cont_act_ = action.cast<DoubleArray>();
+    } else {
+        disc_act_ = action.cast<IntArray>();
+    }
+
+    auto check_size = [&](auto &arr, size_t size) {
+        if (size > 0 && static_cast<size_t>(arr.size()) != num_envs * size) {
+            throw std::runtime_error(
+                "ScrimmageVecEnv: expected " + std::to_string(num_envs * size)
+                + " action values, got " + std::to_string(arr.size()));
+        }
+    };
+    check_size(disc_act_, act_disc_size_);
+    check_size(cont_act_, act_cont_size_);
+}
+
+void ScrimmageVecEnv::write_observation(size_t i) {
+    envs_[i]->write_observation(row(disc_obs_data_, obs_disc_size_, i),
+                                row(cont_obs_data_, obs_cont_size_, i));
+}
+
+pybind11::object ScrimmageVecEnv::copy_observation(size_t i) {
+    py::array_t<int> disc(obs_disc_size_, row(disc_obs_data_, obs_disc_size_, i));
+    py::array_t<double> cont(obs_cont_size_, row(cont_obs_data_, obs_cont_size_, i));
+    if (obs_disc_size_ > 0 && obs_cont_size_ > 0) {
+        return py::make_tuple(disc, cont);
+    } else if (obs_cont_size_ > 0) {
+        return std::move(cont);
+    } else {
+        return std::move(disc);
+    }
+}
+
+pybind11::tuple ScrimmageVecEnv::step(pybind11::object action) {
+    set_action(action);
+
+    const int *disc_act = act_disc_size_ > 0 ? disc_act_.data() : nullptr;
+    const double *cont_act = act_cont_size_ > 0 ? cont_act_.data() : nullptr;
+
+    {
+        // The environments only touch their own state and the numpy
+        // buffers, so they can run without the GIL.
+        py::gil_scoped_release release;
+        executor_->parallel_for(envs_.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                envs_[i]->set_action(row(disc_act, act_disc_size_, i),
+                                     row(cont_act, act_cont_size_, i));
+                sim_done_[i] = envs_[i]->advance();
+                write_observation(i);
+            }
+        }, 1);
+    }
+
+    // Rewards and infos are python objects, and new episodes may need to
+    // load plugins, so the rest runs serially with the GIL held.
+    auto rewards = rewards_.mutable_unchecked<1>();
+    auto dones = dones_.mutable_unchecked<1>();
+    py::list infos;
+    for (size_t i = 0; i < envs_.size(); i++) {
+        py::float_ reward;
+        py::bool_ done;
+        py::dict info;
+        std::tie(reward, done, info) = envs_[i]->finish_step(sim_done_[i]);
+
+        rewards(i) = reward.cast<double>();
+        dones(i) = done.cast<bool>();
+        if (dones(i)) {
+            info["terminal_observation"] = copy_observation(i);
+            envs_[i]->reset_episode();
+            write_observation(i);
+        }
+        infos.append(info);
+    }
+
+    return py::make_tuple(observation_, rewards_, dones_, infos);
+}
+
+void ScrimmageVecEnv::seed(pybind11::object _seed) {
+    if (_seed.is_none()) return;
+    const int seed = _seed.cast<int>();
+    for (size_t i = 0; i < envs_.size(); i++) {
+        envs_[i]->seed(py::int_(seed + static_cast<int>(i)));
+    }
+}
+
+void ScrimmageVecEnv::close() {
+    for (auto &env : envs_) {
+        env->close();
+    }
+}
+
+void add_vec_env(pybind11::module &m) {
+    py::class_<ScrimmageVecEnv>(m, "ScrimmageVecEnv")
+        .def(py::init<std::string&, size_t, int, bool, double, bool>(),
+            R"(Runs several copies of a mission in parallel.
+
+Each copy combines its learners into a single actor. step() runs the
+copies on a thread pool without the GIL and returns numpy arrays with one
+row per copy. The returned arrays are reused: they are overwritten by the
+next call to step() or reset().
+
+Parameters
+----------
+mission_file : str
+    the mission file to be run (does not need the full path, e.g. \"straight.xml\"
+
+num_envs : int
+    number of copies of the mission.
+
+num_threads : int
+    number of threads stepping the copies. 0 uses one per core.
+
+global_sensor : bool
+    whether to only use the first observation when a copy has more
+    than one learner.
+
+timestep : float
+    run scrimmage for multiple timesteps before outputting
+    the observation and reward on step().
+
+fast_reset : bool
+    whether reset() returns to a snapshot taken after the first reset
+    instead of parsing the mission and loading the plugins again. See
+    ScrimmageOpenAIEnv.
+)",
+            py::arg("mission_file"),
+            py::arg("num_envs"),
+            py::arg("num_threads") = 0,
+            py::arg("global_sensor") = false,
+            py::arg("timestep") = -1,
+            py::arg("fast_reset") = true)
+        .def("step", &ScrimmageVecEnv::step,
+            R"(Run every copy for one step.
+
+action : numpy.array
+    one row of actions per copy. When the action space is a Tuple, a
+    (discrete, continuous) pair of arrays.
+
+Returns (obs, rewards, dones, infos). obs has one row per copy (a
+(discrete, continuous) pair for Tuple observations), rewards and dones
+have one entry per copy and infos is a list of dicts. A copy that is done
+starts a new episode right away: its row of obs is the first observation
+of the new episode and info[\"terminal_observation\"] is the last
+observation of the old one.
+)")
+        .def("reset", &ScrimmageVecEnv::reset, "restart every copy")
+        .def("close", &ScrimmageVecEnv::close, "closes every copy")
+        .def("seed", &ScrimmageVecEnv::seed,
+            "Seed copy i with seed + i. Takes effect on the next reset",
+            py::arg("seed") = py::none())
+        .def_property_readonly("num_envs", &ScrimmageVecEnv::num_envs)
+        .def_property_readonly("action_space", &ScrimmageVecEnv::get_action_space)
+        .def_property_readonly("observation_space", &ScrimmageVecEnv::get_observation_space)
+        .def_readwrite("reward_range", &ScrimmageVecEnv::reward_range)
+        .def_readwrite("spec", &ScrimmageVecEnv::spec)
+        .def_readwrite("metadata", &ScrimmageVecEnv::metadata);
+}
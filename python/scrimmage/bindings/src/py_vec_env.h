@@ -0,0 +1,114 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace scrimmage {
+class TaskExecutor;
+} // namespace scrimmage
+
+class ScrimmageOpenAIEnv;
+
+/**
+ * @brief Steps several copies of a mission in parallel for vectorized RL.
+ *
+ * Each environment is a ScrimmageOpenAIEnv with combine_actors set. step()
+ * releases the GIL while the environments run on a thread pool, so the
+ * learners' plugins must not call into python from step_autonomy or from
+ * plugins created after the entities are generated.
+ *
+ * Observations, rewards and dones are written into arrays owned by this
+ * class, which are returned without copying and overwritten by the next
+ * call to step() or reset(). Copy them if they need to be kept.
+ */
+class ScrimmageVecEnv {
+ public:
+    ScrimmageVecEnv(const std::string &mission_file,
+                    size_t num_envs,
+                    int num_threads = 0,
+                    bool global_sensor = false,
+                    double timestep = -1,
+                    bool fast_reset = true);
+    ~ScrimmageVecEnv();
+
+    pybind11::tuple step(pybind11::object action);
+    pybind11::object reset();
+
+    void close();
+    void seed(pybind11::object _seed = pybind11::none());
+    size_t num_envs() {return envs_.size();}
+
+    pybind11::object get_observation_space();
+    pybind11::object get_action_space();
+
+    pybind11::object spec;
+    pybind11::object metadata;
+    pybind11::tuple reward_range;
+
+ protected:
+    void set_action(pybind11::object action);
+    void write_observation(size_t i);
+    pybind11::object copy_observation(size_t i);
+
+    std::vector<std::unique_ptr<ScrimmageOpenAIEnv>> envs_;
+    std::shared_ptr<scrimmage::TaskExecutor> executor_;
+
+    // sizes of one environment's observation and action
+    size_t obs_disc_size_ = 0;
+    size_t obs_cont_size_ = 0;
+    size_t act_disc_size_ = 0;
+    size_t act_cont_size_ = 0;
+
+    pybind11::array_t<int> disc_obs_;
+    pybind11::array_t<double> cont_obs_;
+    pybind11::object observation_;
+
+    // the observation buffers are never reallocated, so the worker threads
+    // write through these without the GIL
+    int *disc_obs_data_ = nullptr;
+    double *cont_obs_data_ = nullptr;
+
+    // the actions of the last step, converted to contiguous arrays
+    using IntArray = pybind11::array_t<int, pybind11::array::c_style | pybind11::array::forcecast>;
+    using DoubleArray = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>;
+    IntArray disc_act_;
+    DoubleArray cont_act_;
+
+    pybind11::array_t<double> rewards_;
+    pybind11::array_t<bool> dones_;
+    std::vector<char> sim_done_;
+};
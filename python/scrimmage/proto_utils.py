@@ -29,6 +29,8 @@ This file is part of SCRIMMAGE.
 @section DESCRIPTION
 A Long description goes here.
 """
+import collections
+
 from scrimmage.proto import Frame_pb2
 import google.protobuf.internal.decoder
 
@@ -49,6 +51,9 @@ def read_frames(frames_file, to_dataframe=False):
 
     The first link contains the code used below with the exception that decoder
     is _DecodeVarint32, found at the 2nd link
+
+    Delta frames (see the frame_delta mission tag) are expanded into full
+    frames.
     """
     with open(frames_file, 'rb') as f:
         data = f.read()
@@ -76,4 +81,28 @@ def read_frames(frames_file, to_dataframe=False):
 
         pos += next_pos
 
-    return frames
+    return decode_delta_frames(frames)
+
+
+def decode_delta_frames(frames):
+    """Return the frames with every delta frame replaced by a full frame."""
+    contacts = collections.OrderedDict()
+    full_frames = []
+    for frame in frames:
+        if not frame.delta:
+            contacts = collections.OrderedDict(
+                (c.id.id, c) for c in frame.contact)
+            full_frames.append(frame)
+            continue
+
+        for contact_id in frame.removed_id:
+            contacts.pop(contact_id, None)
+        for contact in frame.contact:
+            contacts[contact.id.id] = contact
+
+        full_frame = Frame_pb2.Frame()
+        full_frame.time = frame.time
+        full_frame.contact.extend(contacts.values())
+        full_frames.append(full_frame)
+
+    return full_frames
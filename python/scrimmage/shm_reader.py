@@ -0,0 +1,127 @@
+"""Read frames and shapes that SCRIMMAGE writes to shared memory.
+
+@file
+
+@section LICENSE
+
+Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+
+This file is part of SCRIMMAGE.
+
+  SCRIMMAGE is free software: you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+  License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+
+@author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+@author Eric Squires <eric.squires@gtri.gatech.edu>
+@date 31 July 2017
+@version 0.1.0
+@brief Reader for the stream_shared_memory mission option.
+@section DESCRIPTION
+Maps the channels written by scrimmage::ShmChannel (see
+include/scrimmage/network/ShmChannel.h for the layout) and parses messages
+straight out of the mapping. Example::
+
+    reader = ShmReader(Frame_pb2.Frame, 'scrimmage_50051_frames')
+    frame = reader.latest()
+"""
+import mmap
+import os
+import struct
+
+from scrimmage.proto import Frame_pb2, Shape_pb2
+
+_MAGIC = b'SCRSHM01'
+_HEADER = struct.Struct('<8sIIQI')
+_HEADER_SIZE = 64
+_SLOT = struct.Struct('<QI')
+_SLOT_HEADER_SIZE = 16
+
+
+class ShmReader(object):
+    """Reads one shared memory channel.
+
+    Messages are numbered from zero. read() returns None if a message is not
+    written yet or was already overwritten by the writer.
+    """
+
+    def __init__(self, msg_type, name, shm_dir='/dev/shm'):
+        self.msg_type = msg_type
+        with open(os.path.join(shm_dir, name.lstrip('/')), 'rb') as f:
+            self._mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, self.num_slots, self.slot_size, _, _ = \
+            _HEADER.unpack_from(self._mm, 0)
+        if magic != _MAGIC:
+            raise ValueError('not a scrimmage shared memory channel: ' + name)
+        self._stride = _SLOT_HEADER_SIZE + self.slot_size
+
+    def close(self):
+        self._mm.close()
+
+    def count(self):
+        """Return the number of messages written so far."""
+        return struct.unpack_from('<Q', self._mm, 16)[0]
+
+    def closed(self):
+        """Return True if the writer has closed the channel."""
+        return struct.unpack_from('<I', self._mm, 24)[0] != 0
+
+    def read(self, n):
+        offset = _HEADER_SIZE + (n % self.num_slots) * self._stride
+        seq, size = _SLOT.unpack_from(self._mm, offset)
+        if seq != 2 * n + 2 or size > self.slot_size:
+            return None
+
+        start = offset + _SLOT_HEADER_SIZE
+        msg = self.msg_type()
+        try:
+            msg.ParseFromString(self._mm[start:start + size])
+        except Exception:
+            msg = None
+
+        # the writer may have reused the slot while it was parsed
+        if struct.unpack_from('<Q', self._mm, offset)[0] != seq:
+            return None
+        return msg
+
+    def latest(self):
+        """Return the newest message, or None if there is none."""
+        for _ in range(3):
+            count = self.count()
+            if count == 0:
+                return None
+            msg = self.read(count - 1)
+            if msg is not None:
+                return msg
+        return None
+
+    def messages(self, start=None):
+        """Yield (n, message) for every message that can still be read,
+        starting at message start (default: the oldest one left)."""
+        count = self.count()
+        n = max(count - self.num_slots, 0) if start is None else start
+        while n < count:
+            msg = self.read(n)
+            if msg is not None:
+                yield n, msg
+            n += 1
+
+
+def frames_reader(port=50051):
+    """Return a reader for the frames written with stream_port port."""
+    return ShmReader(Frame_pb2.Frame, 'scrimmage_{}_frames'.format(port))
+
+
+def shapes_reader(port=50051):
+    """Return a reader for the shapes written with stream_port port."""
+    return ShmReader(Shape_pb2.Shapes, 'scrimmage_{}_shapes'.format(port))
@@ -39,7 +39,9 @@
 
 #include <scrimmage/common/Timer.h>
 #include <scrimmage/log/Log.h>
+#include <scrimmage/log/PlaybackReader.h>
 
+#include <cctype>
 #include <iostream>
 #include <iomanip>
 #include <ctime>
@@ -65,19 +67,13 @@ void HandleSignal(int s) {
     cout << endl << "Exiting gracefully" << endl;
 }
 
-void playback_loop(std::shared_ptr<sc::Log> log,
+void playback_loop(std::shared_ptr<sc::PlaybackReader> reader,
+                   std::shared_ptr<sc::Log> log,
                    sc::InterfacePtr in_interface,
                    sc::InterfacePtr out_interface) {
-    // Get dt from first two frames
-    double dt = 0.1;
-    if (log->frames().size() >= 2) {
-        auto it = log->frames().begin();
-        double t0 = (*it)->time();
-        ++it;
-        double t1 = (*it)->time();
-        dt = t1 - t0;
-    } else {
-        cout << "Fewer than two frames parsed. Using dt: " << dt << endl;
+    double dt = reader->dt();
+    if (reader->num_frames() < 2) {
+        cout << "Fewer than two frames in log. Using dt: " << dt << endl;
     }
 
     bool paused = true;
@@ -92,34 +88,46 @@ void playback_loop(std::shared_ptr<sc::Log> log,
 
     bool exit_loop = false;
 
-    auto it_shapes = log->shapes().begin();
+    // The terrain and contact visuals are small, so they are read up front
+    // and only sent once
     auto it_utm_terrain = log->utm_terrain().begin();
     auto it_contact_visual = log->contact_visual().begin();
 
+    const double seek_step = 10.0;
+    double time = reader->start_time();
+    uint64_t index = 0;
+
     timer.start_overall_timer();
-    for (auto it = log->frames().begin(); it != log->frames().end(); it++) {
+    sc::PlaybackStep step;
+    while (!exit_loop) {
         timer.start_loop_timer();
-        // Send all other messages up to current frame time before sending
-        // current frame
-        while (it_shapes != log->shapes().end() &&
-               (*it_shapes)->time() <= (*it)->time()) {
-            out_interface->send_shapes(**it_shapes);
-            ++it_shapes;
-        }
 
-        while (it_utm_terrain != log->utm_terrain().end() &&
-               (*it_utm_terrain)->time() <= (*it)->time()) {
-            out_interface->send_utm_terrain(*it_utm_terrain);
-            ++it_utm_terrain;
-        }
+        // At the end of the log, wait for a seek or for the user to exit
+        const bool has_step = reader->next(step);
+        if (has_step) {
+            time = step.frame->time();
+            index = step.index;
 
-        while (it_contact_visual != log->contact_visual().end() &&
-               (*it_contact_visual)->time() <= (*it)->time()) {
-            out_interface->send_contact_visual(*it_contact_visual);
-            ++it_contact_visual;
-        }
+            // Send all other messages up to current frame time before
+            // sending current frame
+            for (auto &shapes : step.shapes) {
+                out_interface->send_shapes(*shapes);
+            }
+
+            while (it_utm_terrain != log->utm_terrain().end() &&
+                   (*it_utm_terrain)->time() <= time) {
+                out_interface->send_utm_terrain(*it_utm_terrain);
+                ++it_utm_terrain;
+            }
+
+            while (it_contact_visual != log->contact_visual().end() &&
+                   (*it_contact_visual)->time() <= time) {
+                out_interface->send_contact_visual(*it_contact_visual);
+                ++it_contact_visual;
+            }
 
-        out_interface->send_frame(*it);
+            out_interface->send_frame(step.frame);
+        }
 
         // Wait loop timer.
         // Stay in loop if currently paused.
@@ -135,20 +143,36 @@ void playback_loop(std::shared_ptr<sc::Log> log,
             }
 
             bool single_step = false;
+            bool seek = false;
             // Do we have any simcontrol message updates from GUI?
             if (in_interface->gui_msg_update()) {
                 in_interface->gui_msg_mutex.lock();
                 auto &control = in_interface->gui_msg();
                 auto it = control.begin();
                 while (it != control.end()) {
+                    const std::string &key = it->custom_key();
                     if (it->inc_warp()) {
                         timer.inc_warp();
                     } else if (it->dec_warp()) {
                         timer.dec_warp();
                     } else if (it->toggle_pause()) {
                         paused = !paused;
-                    } else if (it->single_step()) {
+                    } else if (it->single_step() || key == "period") {
                         single_step = true;
+                    } else if (key == "comma") {
+                        reader->seek_frame(index > 0 ? index - 1 : 0);
+                        seek = true;
+                    } else if (key == "Left") {
+                        reader->seek(time - seek_step);
+                        seek = true;
+                    } else if (key == "Right") {
+                        reader->seek(time + seek_step);
+                        seek = true;
+                    } else if (key.size() == 1 && std::isdigit(key[0])) {
+                        double fraction = (key[0] - '0') / 10.0;
+                        reader->seek(reader->start_time() + fraction *
+                                     (reader->end_time() - reader->start_time()));
+                        seek = true;
                     }
                     control.erase(it++);
                 }
@@ -156,16 +180,15 @@ void playback_loop(std::shared_ptr<sc::Log> log,
             }
 
             scrimmage_proto::SimInfo info;
-            info.set_time((*it)->time());
+            info.set_time(time);
             info.set_desired_warp(timer.time_warp());
             info.set_actual_warp(timer.time_warp());
             out_interface->send_sim_info(info);
 
-            if (single_step) {
+            if (single_step || seek) {
                 break;
             }
-        } while (paused && !exit_loop);
-        if (exit_loop) break;
+        } while ((paused || !has_step) && !exit_loop);
     }
 }
 
@@ -183,9 +206,22 @@ int main(int argc, char *argv[]) {
         return -1;
     }
 
-    // Setup Logger
+    // Only the file names are set up here. The frames and shapes are
+    // streamed from disk while playing.
     std::shared_ptr<sc::Log> log(new sc::Log);
-    log->init(std::string(argv[1]), sc::Log::READ);
+    log->init(std::string(argv[1]), sc::Log::NONE);
+    if (fs::exists(log->utm_terrain_filename())) {
+        log->parse(log->utm_terrain_filename(), sc::Log::UTMTERRAIN);
+    }
+    if (fs::exists(log->contact_visual_filename())) {
+        log->parse(log->contact_visual_filename(), sc::Log::CONTACTVISUAL);
+    }
+
+    auto reader = std::make_shared<sc::PlaybackReader>();
+    if (!reader->open(log->frames_filename(), log->shapes_filename())) {
+        cout << "Failed to open frames file: " << log->frames_filename() << endl;
+        return -1;
+    }
 
     sc::InterfacePtr to_gui_interface(new sc::Interface);
     sc::InterfacePtr from_gui_interface(new sc::Interface);
@@ -197,9 +233,12 @@ int main(int argc, char *argv[]) {
     // std::thread server_thread(&Interface::init_network, &(*incoming_interface_),
     //                           Interface::server, "localhost", 50051);
 
-    cout << "Frames parsed: " << log->frames().size() << endl;
+    cout << "Frames in log: " << reader->num_frames() << endl;
+    cout << "Seek by pressing ';' and then: Left/Right (10 seconds back/forward),"
+         << " comma/period (one frame back/forward), 0-9 (0-90% of the log)"
+         << endl;
 
-    std::thread playback(playback_loop, log, from_gui_interface,
+    std::thread playback(playback_loop, reader, log, from_gui_interface,
                          to_gui_interface);
     playback.detach(); // todo
 
@@ -211,15 +250,7 @@ int main(int argc, char *argv[]) {
     viewer.set_incoming_interface(to_gui_interface);
     viewer.set_outgoing_interface(from_gui_interface);
 
-    double dt;
-    if (log->frames().size() >= 2) {
-        auto frame2 = *(std::next(log->frames().begin(), 1));
-        auto frame1 = log->frames().front();
-        dt = frame2->time() - frame1->time();
-    } else {
-        dt = 1.0e-6;
-    }
-    mp->set_dt(dt);
+    mp->set_dt(reader->num_frames() >= 2 ? reader->dt() : 1.0e-6);
 
     viewer.init(mp, {});
     viewer.run();
@@ -58,6 +58,7 @@ int main(int argc, char* argv[]) {
         ("local_port,p", po::value<std::string>(), "The local port where this viewer will listen.")
         ("remote_ip,r", po::value<std::string>(), "The remote IP address where SCRIMMAGE is running.")
         ("remote_port,o", po::value<std::string>(), "The remote port where SCRIMMAGE is running.")
+        ("shared_memory,s", "Read frames and shapes from shared memory written by SCRIMMAGE on this host.")
         ("pos", po::value<std::string>(), "camera position")
         ("focal_point", po::value<std::string>(), "camera focal point");
 
@@ -81,6 +82,9 @@ int main(int argc, char* argv[]) {
     set_param(vm, camera_params, "remote_port");
     set_param(vm, camera_params, "pos");
     set_param(vm, camera_params, "focal_point");
+    if (vm.count("shared_memory")) {
+        camera_params["shared_memory"] = "true";
+    }
 
     if (camera_params.count("pos") > 0 || camera_params.count("focal_point") > 0) {
         camera_params["mode"] = "FREE";
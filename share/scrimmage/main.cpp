@@ -30,6 +30,7 @@
  *
  */
 
+#include <scrimmage/parse/MissionImage.h>
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/parse/ParseUtils.h>
 #include <scrimmage/common/Utilities.h>
@@ -37,12 +38,14 @@
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/autonomy/Autonomy.h>
 #include <scrimmage/entity/Contact.h>
+#include <scrimmage/simcontrol/BatchRunner.h>
 #include <scrimmage/simcontrol/SimControl.h>
 #include <scrimmage/simcontrol/SimUtils.h>
 #include <scrimmage/network/Interface.h>
 #include <scrimmage/metrics/Metrics.h>
 
 #include <signal.h>
+#include <getopt.h>
 #include <cstdlib>
 
 #include <iostream>
@@ -94,8 +97,25 @@ int main(int argc, char *argv[]) {
     std::string seed = "";
     std::string overrides = "";
 
+    // Batch mode options
+    bool batch = false;
+    int num_runs = 1;
+    int num_repeats = 1;
+    int num_threads = 1;
+    std::string ranges_file = "";
+    std::string method = "lhs";
+
+    // Write the mission as a mission image instead of running it
+    std::string compile_file = "";
+
+    static struct option long_options[] = {
+        {"compile-mission", required_argument, nullptr, 'c'},
+        {nullptr, 0, nullptr, 0}
+    };
+
     int opt;
-    while ((opt = getopt(argc, argv, "t:j:s:o:")) != -1) {
+    while ((opt = getopt_long(argc, argv, "t:j:s:o:n:r:m:k:p:c:",
+                              long_options, nullptr)) != -1) {
         switch (opt) {
         case 't':
             task_id = std::stoi(std::string(optarg));
@@ -110,6 +130,26 @@ int main(int argc, char *argv[]) {
         case 'o':
             overrides = std::string(optarg);
             break;
+        case 'n':
+            num_runs = std::stoi(std::string(optarg));
+            batch = true;
+            break;
+        case 'r':
+            ranges_file = std::string(optarg);
+            batch = true;
+            break;
+        case 'm':
+            method = std::string(optarg);
+            break;
+        case 'k':
+            num_repeats = std::stoi(std::string(optarg));
+            break;
+        case 'p':
+            num_threads = std::stoi(std::string(optarg));
+            break;
+        case 'c':
+            compile_file = std::string(optarg);
+            break;
         case '?':
             if (optopt == 't') {
                 fprintf(stderr, "Option -%d requires an integer argument.\n", optopt);
@@ -126,9 +166,50 @@ int main(int argc, char *argv[]) {
 
     if (optind >= argc || argc < 2) {
         cout << "usage: " << argv[0] << " scenario.xml" << endl;
+        cout << "batch: " << argv[0] << " -n runs [-r ranges.xml] [-m lhs|grid]"
+             << " [-k repeats] [-p threads] scenario.xml" << endl;
+        cout << "compile: " << argv[0] << " --compile-mission scenario.bin"
+             << " scenario.xml" << endl;
         return -1;
     }
 
+    if (compile_file != "") {
+        std::string mission_filename, content;
+        sc::MissionImage image;
+        if (not sc::MissionParse::read_mission_file(argv[optind], mission_filename, content) ||
+            not image.compile(mission_filename, content) ||
+            not image.write(compile_file)) {
+            cout << "Failed to compile mission file: " << argv[optind] << endl;
+            return -1;
+        }
+        cout << "Compiled " << mission_filename << " with " << image.num_slots()
+             << " variables to " << compile_file << endl;
+        return 0;
+    }
+
+    if (batch) {
+        sc::BatchRunner batch_runner;
+        shutdown_handler = [&](int /*s*/){
+            cout << endl << "Exiting gracefully" << endl;
+            batch_runner.force_exit();
+        };
+
+        batch_runner.set_num_runs(num_runs);
+        batch_runner.set_num_repeats(num_repeats);
+        batch_runner.set_num_threads(num_threads);
+        batch_runner.set_method(method);
+        batch_runner.set_overrides(overrides);
+        if (job_id != -1) batch_runner.set_job_number(job_id);
+        if (seed_set) batch_runner.set_seed(std::stoul(seed));
+
+        if (not batch_runner.init(argv[optind])) return -1;
+        if (ranges_file != "" && not batch_runner.parse_ranges(ranges_file)) {
+            return -1;
+        }
+        if (not batch_runner.generate_runs()) return -1;
+        return batch_runner.run() ? 0 : -1;
+    }
+
     // Overwrite mission parameters from command line
     if (task_id != -1) simcontrol.mp()->set_task_number(task_id);
     if (job_id != -1) simcontrol.mp()->set_job_number(job_id);
@@ -44,6 +44,13 @@ namespace scrimmage {
 Autonomy::Autonomy() : state_(std::make_shared<State>()),
     desired_state_(std::make_shared<State>()), need_reset_(false), is_controlling_(false) {}
 
+Autonomy::Autonomy(const Autonomy &other) : EntityPlugin(other),
+    proj_(other.proj_), state_(other.state_),
+    desired_state_(std::make_shared<State>(*other.desired_state_)),
+    contacts_(other.contacts_), rtree_(other.rtree_),
+    need_reset_(other.need_reset_), logging_msg_(other.logging_msg_),
+    is_controlling_(other.is_controlling_) {}
+
 void Autonomy::set_contacts(ContactMapPtr &contacts) {
     contacts_ = contacts;
 }
@@ -73,6 +80,16 @@ void Autonomy::set_is_controlling(bool is_controlling) {is_controlling_ = is_con
 std::string Autonomy::type() { return std::string("Autonomy"); }
 
 bool Autonomy::step_autonomy(double /*t*/, double /*dt*/) { return true; }
+
+bool Autonomy::step_autonomy_batch(const std::vector<Autonomy *> &autonomies,
+                                   double t, double dt) {
+    bool success = true;
+    for (Autonomy *autonomy : autonomies) {
+        success &= autonomy->step_autonomy(t, dt);
+    }
+    return success;
+}
+
 bool Autonomy::posthumous(double /*t*/) { return true; }
 void Autonomy::init() {}
 void Autonomy::init(std::map<std::string, std::string> &/*params*/) {}
@@ -33,7 +33,15 @@
 #include <scrimmage/common/FileSearch.h>
 #include <scrimmage/parse/ParseUtils.h>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono> // NOLINT
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
+#include <thread> // NOLINT
 #include <unordered_set>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -51,8 +59,27 @@ namespace br = boost::range;
 
 namespace scrimmage {
 
+namespace {
+const char index_header[] = "scrimmage_file_index 1";
+
+// Modification time of a directory in nanoseconds, or -1 if it doesn't exist
+int64_t dir_mtime(const std::string &dir) {
+    struct stat st;
+    if (stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) return -1;
+#ifdef __APPLE__
+    return st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    return st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+}
+} // namespace
+
 void FileSearch::clear() {cache_.clear();}
 
+void FileSearch::set_index_dir(const std::string &index_dir) {
+    index_dir_ = index_dir;
+}
+
 boost::optional<std::string> FileSearch::find_mission(std::string mission,
         bool verbose) {
     if (!boost::algorithm::ends_with(mission, "xml")) {
@@ -104,9 +131,9 @@ bool FileSearch::find_file(const std::string &search,
         // files[search_filename] = list of full paths
         dbg(std::string("not an absolute path, checking recursively in ")
                 + env_var);
-        std::unordered_map<std::string, std::list<std::string>> files;
-        find_files(env_var, ext, files, verbose);
-        filenames = files[search_filename];
+        auto &files = cached_files(env_var, ext, verbose);
+        auto it = files.find(search_filename);
+        if (it != files.end()) filenames = it->second;
     } else {
         filenames.push_back(search);
     }
@@ -139,26 +166,22 @@ bool FileSearch::find_file(const std::string &search,
 void FileSearch::find_files(std::string env_var, const std::string &ext,
         std::unordered_map<std::string, std::list<std::string>> &out,
         bool verbose) {
+    out = cached_files(env_var, ext, verbose);
+}
+
+std::unordered_map<std::string, std::list<std::string>> &
+FileSearch::cached_files(const std::string &env_var, const std::string &ext,
+        bool verbose) {
     auto dbg = [&](std::string msg) {
         if (verbose) std::cout << "find_files: " << msg << std::endl;
     };
 
-    auto cache_it = cache_.find(env_var);
-    auto ext_it = cache_[env_var].find(ext);
-    if (cache_it != cache_.end()) {
-        if (ext_it != cache_it->second.end()) {
-            out = ext_it->second;
-            return;
-        } else {
-            cache_it->second[ext];
-            ext_it = cache_it->second.find(ext);
-        }
-    } else {
-        cache_[env_var][ext];
-        ext_it = cache_[env_var].find(ext);
+    auto &ext_cache = cache_[env_var];
+    auto ext_it = ext_cache.find(ext);
+    if (ext_it != ext_cache.end()) {
+        return ext_it->second;
     }
-
-    out.clear();
+    auto &files = ext_cache[ext];
 
     // Get the environment variable
     std::string env_path;
@@ -167,7 +190,7 @@ void FileSearch::find_files(std::string env_var, const std::string &ext,
         if (env_p == NULL) {
             std::cout << env_var <<
                 " environment variable not set" << std::endl;
-            return;
+            return files;
         }
 
         env_path = std::string(env_p);
@@ -202,11 +225,28 @@ void FileSearch::find_files(std::string env_var, const std::string &ext,
         it++;
     }
 
+    // The index is keyed by the absolute paths of the search directories
+    std::string index_key;
+    for (const std::string &t : tok) {
+        index_key += fs::absolute(t).string() + ":";
+    }
+    if (load_index(index_key, ext, env_path != env_var, files)) {
+        dbg(std::string("loaded from the index: ") + env_path);
+        return files;
+    }
+
+    // Save the searched directories and the files in the order that they are
+    // found for the index
+    std::vector<IndexDir> dirs;
+    std::list<std::string> paths;
+
     dbg(std::string("not found in cache, looping recursively in ") + env_path);
     for (const std::string &t : tok) {
         // Search for all files in the current directory with
         // the extension
         fs::path root = t;
+        std::string root_path = fs::absolute(root).string();
+        dirs.push_back(IndexDir{root_path, dir_mtime(root_path), true});
 
         if (fs::exists(root) && fs::is_directory(root)) {
             dbg(t);
@@ -216,11 +256,16 @@ void FileSearch::find_files(std::string env_var, const std::string &ext,
 
             while (it != endit) {
                 fs::path path = it->path();
-                if (fs::is_regular_file(*it) && path.extension() == ext) {
+                if (fs::is_directory(it->symlink_status())) {
+                    // The directory's time is read before its files are
+                    std::string dir_path = fs::absolute(path).string();
+                    dirs.push_back(IndexDir{dir_path, dir_mtime(dir_path), false});
+                } else if (fs::is_regular_file(*it) && path.extension() == ext) {
                     std::string fname = path.filename().string();
                     std::string full_path = fs::absolute(path).string();
                     dbg(std::string("   ") + fname);
-                    ext_it->second[fname].push_back(full_path);
+                    files[fname].push_back(full_path);
+                    paths.push_back(full_path);
                 }
                 ++it;
             }
@@ -228,9 +273,109 @@ void FileSearch::find_files(std::string env_var, const std::string &ext,
             std::cout << "Search path doesn't exist: " << t << std::endl;
         }
     }
+    save_index(index_key, ext, dirs, paths);
+    return files;
+}
+
+std::string FileSearch::index_filename(const std::string &key,
+                                       const std::string &ext) {
+    std::stringstream ss;
+    ss << expand_user(index_dir_) << "/files_" << std::hex
+       << std::hash<std::string>()(key + "\n" + ext) << ".txt";
+    return ss.str();
+}
+
+bool FileSearch::load_index(const std::string &key, const std::string &ext,
+        bool print_missing,
+        std::unordered_map<std::string, std::list<std::string>> &files) {
+    if (index_dir_.empty()) return false;
+
+    std::ifstream file(index_filename(key, ext));
+    std::string header, index_key, index_ext;
+    if (!file.is_open() ||
+        !std::getline(file, header) || header != index_header ||
+        !std::getline(file, index_key) || index_key != key ||
+        !std::getline(file, index_ext) || index_ext != ext) {
+        return false;
+    }
+
+    // Lines:
+    // r|d <mtime> <directory> for the searched roots and their subdirectories
+    // f <path> for the found files
+    std::unordered_map<std::string, std::list<std::string>> index_files;
+    std::list<std::string> missing_roots;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() < 3) return false;
+        if (line[0] == 'f') {
+            std::string path = line.substr(2);
+            index_files[fs::path(path).filename().string()].push_back(path);
+            continue;
+        }
+
+        std::stringstream ss(line);
+        char type;
+        int64_t mtime;
+        std::string dir;
+        if (!(ss >> type >> mtime) || (type != 'r' && type != 'd') ||
+            ss.get() != ' ' || !std::getline(ss, dir)) {
+            return false;
+        } else if (dir_mtime(dir) != mtime) {
+            // The directory was changed since the index was saved
+            return false;
+        } else if (mtime == -1 && type == 'r') {
+            missing_roots.push_back(dir);
+        }
+    }
+
+    if (print_missing) {
+        for (const std::string &dir : missing_roots) {
+            std::cout << "Search path doesn't exist: " << dir << std::endl;
+        }
+    }
+    files = std::move(index_files);
+    return true;
+}
+
+void FileSearch::save_index(const std::string &key, const std::string &ext,
+        const std::vector<IndexDir> &dirs, const std::list<std::string> &paths) {
+    if (index_dir_.empty()) return;
+
+    // A directory that is changed in the same tick of the file system's clock
+    // as it was searched keeps its time. Don't save the index until the times
+    // are older than the clock's resolution.
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    for (const IndexDir &dir : dirs) {
+        if (dir.mtime > now - 2000000000LL) return;
+    }
+
+    boost::system::error_code ec;
+    fs::create_directories(expand_user(index_dir_), ec);
+
+    // Write to a temporary file and rename it so that other processes never
+    // read a partial index
+    std::string filename = index_filename(key, ext);
+    std::stringstream tmp_ss;
+    tmp_ss << filename << "." << getpid() << "_" << std::this_thread::get_id();
+    std::string tmp_filename = tmp_ss.str();
+    std::ofstream file(tmp_filename);
+    if (!file.is_open()) return;
 
-    out = ext_it->second;
-    return;
+    file << index_header << "\n" << key << "\n" << ext << "\n";
+    for (const IndexDir &dir : dirs) {
+        file << (dir.root ? "r " : "d ") << dir.mtime << " " << dir.path << "\n";
+    }
+    for (const std::string &path : paths) {
+        file << "f " << path << "\n";
+    }
+    file.close();
+
+    if (file.fail()) {
+        fs::remove(tmp_filename, ec);
+    } else {
+        fs::rename(tmp_filename, filename, ec);
+    }
 }
 
 }  // namespace scrimmage
@@ -37,25 +37,36 @@
 
 namespace scrimmage {
 void ParameterServer::unregister_params(PluginPtr owner) {
-    // For all parameters, remove all parameters owned by this plugin
-    for (auto &kv1 : params_) {
-        for (auto &kv2 : kv1.second) {
-            remove_if_owner(kv2.second, owner);
-        }
+    // Remove all parameters owned by this plugin
+    auto it_owner = owned_params_.find(owner.get());
+    if (it_owner == owned_params_.end()) {
+        return;
     }
+    for (auto &set_param : it_owner->second) {
+        set_param.first->erase(set_param.second);
+    }
+    owned_params_.erase(it_owner);
 }
 
 bool ParameterServer::remove_if_owner(std::set<ParameterBasePtr> &param_set,
                                       PluginPtr owner) {
-    auto it_param = std::find_if(param_set.begin(),
-                                 param_set.end(),
-                                 [&](auto p) {
-                                     return p->owner() == owner;
+    auto it_owner = owned_params_.find(owner.get());
+    if (it_owner == owned_params_.end()) {
+        return false;
+    }
+    auto &owned = it_owner->second;
+    auto it_param = std::find_if(owned.begin(), owned.end(),
+                                 [&](auto &set_param) {
+                                     return set_param.first == &param_set;
                                  });
-    if (it_param != param_set.end()) {
-        param_set.erase(it_param);
-        return true;
+    if (it_param == owned.end()) {
+        return false;
+    }
+    param_set.erase(it_param->second);
+    owned.erase(it_param);
+    if (owned.empty()) {
+        owned_params_.erase(it_owner);
     }
-    return false;
+    return true;
 }
 } // namespace scrimmage
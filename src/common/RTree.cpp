@@ -42,36 +42,171 @@ namespace bgi = boost::geometry::index;
 
 namespace scrimmage {
 
+namespace {
+// Maximum number of elements in an rtree node. The node size is independent
+// of the number of entities so that the tree stays balanced and shallow as
+// the entity count grows.
+const size_t max_node_elements = 16;
+
+point to_point(const Eigen::Vector3d &pos) {
+    return point(pos(0), pos(1), pos(2));
+}
+} // namespace
+
 void RTree::init(const unsigned int& size) {
+    if (index_) {
+        index_->init(size);
+        return;
+    }
+
     if (rtree_ != nullptr) {
         clear();
+    } else {
+        rtree_ = std::make_shared<rtree_t>(bgi::dynamic_rstar(max_node_elements));
     }
 
-    // The rtree must be created with size > 0
+    // size is only a hint for the expected number of entries
     size_ = std::max(size, static_cast<unsigned int>(1));
-    rtree_ = std::make_shared<rtree_t>(bgi::dynamic_rstar(size_));
+    entries_.reserve(size_);
 }
 
 void RTree::clear() {
     rtree_->clear();
-    rtree_team_.clear();
+    entries_.clear();
+    team_counts_.clear();
+}
+
+void RTree::set_index(const SpatialIndexPtr &index) {
+    index_ = index;
+}
+
+SpatialIndexPtr RTree::index() const {
+    return index_;
+}
+
+void RTree::set_update_mode(const UpdateMode &mode) {
+    update_mode_ = mode;
+}
+
+RTree::UpdateMode RTree::update_mode() const {
+    return update_mode_;
+}
+
+void RTree::insert(const point_id_t &entry) {
+    rtree_->insert(entry);
+    team_counts_[entry.second.team_id()]++;
+    Entry &e = entries_[entry.second.id()];
+    e.value = entry;
+    e.stamp = stamp_;
+}
+
+void RTree::erase(const point_id_t &entry) {
+    rtree_->remove(entry);
+    auto it = team_counts_.find(entry.second.team_id());
+    if (it != team_counts_.end() && --(it->second) <= 0) {
+        team_counts_.erase(it);
+    }
 }
 
 void RTree::add(const Eigen::Vector3d &pos, const ID &id) {
-    point p(pos(0), pos(1), pos(2));
-    std::pair<point, ID> pair(p, id);
-    rtree_->insert(pair);
+    if (index_) {
+        index_->add(pos, id);
+        return;
+    }
+
+    if (rtree_ == nullptr) {
+        init(1);
+    }
 
-    int team_id = id.team_id();
-    auto it = rtree_team_.find(team_id);
-    if (it == rtree_team_.end()) {
-        rtreePtr rtree = std::make_shared<rtree_t>(bgi::dynamic_rstar(size_));
-        it = rtree_team_.insert(std::make_pair(team_id, rtree)).first;
+    auto it = entries_.find(id.id());
+    if (it != entries_.end()) {
+        erase(it->second.value);
     }
-    it->second->insert(pair);
+    insert(point_id_t(to_point(pos), id));
 }
 
-void results_to_neighbors(std::list<point_id_t> &results,
+void RTree::remove(const ID &id) {
+    if (index_) {
+        index_->remove(id);
+        return;
+    }
+
+    if (rtree_ == nullptr) return;
+
+    auto it = entries_.find(id.id());
+    if (it != entries_.end()) {
+        erase(it->second.value);
+        entries_.erase(it);
+    }
+}
+
+void RTree::update(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries) {
+    if (index_) {
+        index_->update(entries);
+        return;
+    }
+
+    if (rtree_ == nullptr) {
+        init(entries.size());
+    }
+    stamp_++;
+
+    if (update_mode_ == UpdateMode::REBUILD) {
+        std::vector<point_id_t> values;
+        values.reserve(entries.size());
+        entries_.clear();
+        team_counts_.clear();
+        for (auto &kv : entries) {
+            values.emplace_back(to_point(kv.first), kv.second);
+            team_counts_[kv.second.team_id()]++;
+            Entry &e = entries_[kv.second.id()];
+            e.value = values.back();
+            e.stamp = stamp_;
+        }
+
+        // The range constructor uses the packing algorithm, which builds the
+        // tree in a single pass instead of inserting elements one at a time.
+        rtree_t packed(values, bgi::dynamic_rstar(max_node_elements));
+        rtree_->swap(packed);
+        return;
+    }
+
+    // Move the entries whose position changed
+    for (auto &kv : entries) {
+        point p = to_point(kv.first);
+        auto it = entries_.find(kv.second.id());
+        if (it == entries_.end()) {
+            insert(point_id_t(p, kv.second));
+        } else if (!bg::equals(it->second.value.first, p) ||
+                   !(it->second.value.second == kv.second)) {
+            erase(it->second.value);
+            insert(point_id_t(p, kv.second));
+        } else {
+            it->second.stamp = stamp_;
+        }
+    }
+
+    // Remove the entries that were not part of this update
+    for (auto it = entries_.begin(); it != entries_.end(); /* no inc */) {
+        if (it->second.stamp != stamp_) {
+            erase(it->second.value);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+unsigned int RTree::size() const {
+    if (index_) return index_->size();
+    return rtree_ == nullptr ? 0 : rtree_->size();
+}
+
+bool RTree::has_team(int team_id) const {
+    return team_counts_.count(team_id) > 0;
+}
+
+void results_to_neighbors(std::vector<point_id_t> &results,
                           std::vector<ID> &neighbors,
                           int self_id) {
     neighbors.clear();
@@ -92,8 +227,13 @@ void results_to_neighbors(std::list<point_id_t> &results,
 void RTree::nearest_n_neighbors(const Eigen::Vector3d &pos,
                                 std::vector<ID> &neighbors, unsigned int n,
                                 int self_id, int team_id) const {
-    std::list<point_id_t> results;
-    point sought(pos(0), pos(1), pos(2));
+    if (index_) {
+        index_->nearest_n_neighbors(pos, neighbors, n, self_id, team_id);
+        return;
+    }
+
+    std::vector<point_id_t> results;
+    point sought = to_point(pos);
 
     if (self_id != -1) {
         // assume that if an id is given then it will be located at pos so
@@ -101,16 +241,18 @@ void RTree::nearest_n_neighbors(const Eigen::Vector3d &pos,
         n += 1;
     }
 
-    if (team_id == -1) {
-        rtree_->query(bgi::nearest(sought, n), std::front_inserter(results));
+    if (rtree_ == nullptr) {
+        neighbors.clear();
+        return;
+    } else if (team_id == -1) {
+        rtree_->query(bgi::nearest(sought, n), std::back_inserter(results));
+    } else if (!has_team(team_id)) {
+        neighbors.clear();
+        return;
     } else {
-        auto it = rtree_team_.find(team_id);
-        if (it == rtree_team_.end()) {
-            neighbors.clear();
-            return;
-        } else {
-            it->second->query(bgi::nearest(sought, n), std::front_inserter(results));
-        }
+        auto team_func = [&](point_id_t const& v) {return v.second.team_id() == team_id;};
+        rtree_->query(bgi::nearest(sought, n) && bgi::satisfies(team_func),
+                      std::back_inserter(results));
     }
     results_to_neighbors(results, neighbors, self_id);
 }
@@ -119,8 +261,13 @@ void RTree::neighbors_in_range(const Eigen::Vector3d &pos,
                                std::vector<ID> &neighbors,
                                double dist,
                                int self_id, int team_id) const {
+    if (index_) {
+        index_->neighbors_in_range(pos, neighbors, dist, self_id, team_id);
+        return;
+    }
+
     // see here: http://stackoverflow.com/a/22910447
-    std::list<point_id_t> results;
+    std::vector<point_id_t> results;
     double x = pos(0);
     double y = pos(1);
     double z = pos(2);
@@ -130,24 +277,29 @@ void RTree::neighbors_in_range(const Eigen::Vector3d &pos,
         point(x - dist, y - dist, z - dist), point(x + dist, y + dist, z + dist)
     );
 
-    auto dist_func = [&](point_id_t const& v) {return bg::distance(v.first, sought) < dist;};
+    // comparable_distance avoids the square root of bg::distance
+    const double dist_sq = dist * dist;
+    auto dist_func = [&](point_id_t const& v) {
+        return bg::comparable_distance(v.first, sought) < dist_sq;
+    };
 
-    if (team_id == -1) {
+    if (rtree_ == nullptr) {
+        neighbors.clear();
+        return;
+    } else if (team_id == -1) {
         rtree_->query(
             bgi::within(box) && bgi::satisfies(dist_func),
-            std::front_inserter(results)
+            std::back_inserter(results)
         );
+    } else if (!has_team(team_id)) {
+        neighbors.clear();
+        return;
     } else {
-        auto it = rtree_team_.find(team_id);
-        if (it == rtree_team_.end()) {
-            neighbors.clear();
-            return;
-        } else {
-            it->second->query(
-                bgi::within(box) && bgi::satisfies(dist_func),
-                std::front_inserter(results)
-            );
-        }
+        auto team_func = [&](point_id_t const& v) {return v.second.team_id() == team_id;};
+        rtree_->query(
+            bgi::within(box) && bgi::satisfies(team_func) && bgi::satisfies(dist_func),
+            std::back_inserter(results)
+        );
     }
 
     results_to_neighbors(results, neighbors, self_id);
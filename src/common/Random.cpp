@@ -51,6 +51,14 @@ void Random::seed(uint32_t _seed) {
     gener_->seed(seed_);
 }
 
+void Random::copy_state(const Random &other) {
+    // copy the engine itself, gener_ is shared with the plugins
+    seed_ = other.seed_;
+    *gener_ = *other.gener_;
+    rng_normal_ = other.rng_normal_;
+    rng_uniform_ = other.rng_uniform_;
+}
+
 double Random::rng_uniform() {
     return rng_uniform_(*gener_);
 }
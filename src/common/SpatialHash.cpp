@@ -0,0 +1,267 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/common/SpatialHash.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace scrimmage {
+
+namespace {
+// Number of bits used for each cell coordinate in the packed key. Cells that
+// are further apart than 2^21 cells share keys, which only adds candidates
+// that are removed by the exact distance checks.
+const int key_bits = 21;
+const uint64_t key_mask = (static_cast<uint64_t>(1) << key_bits) - 1;
+} // namespace
+
+SpatialHash::SpatialHash(double cell_size) {
+    set_cell_size(cell_size);
+}
+
+void SpatialHash::set_cell_size(double cell_size) {
+    if (cell_size <= 0) {
+        cell_size = 1.0;
+    }
+    cell_size_ = cell_size;
+    inv_cell_size_ = 1.0 / cell_size;
+    clear();
+}
+
+double SpatialHash::cell_size() const {
+    return cell_size_;
+}
+
+int64_t SpatialHash::coord(double x) const {
+    return static_cast<int64_t>(std::floor(x * inv_cell_size_));
+}
+
+uint64_t SpatialHash::key(int64_t x, int64_t y, int64_t z) const {
+    return ((static_cast<uint64_t>(x) & key_mask) << (2 * key_bits)) |
+        ((static_cast<uint64_t>(y) & key_mask) << key_bits) |
+        (static_cast<uint64_t>(z) & key_mask);
+}
+
+void SpatialHash::clear() {
+    cells_.clear();
+    id_to_cell_.clear();
+    size_ = 0;
+}
+
+void SpatialHash::init(const unsigned int &size) {
+    clear();
+    id_to_cell_.reserve(size);
+}
+
+void SpatialHash::insert(const Eigen::Vector3d &pos, const ID &id) {
+    uint64_t k = key(coord(pos(0)), coord(pos(1)), coord(pos(2)));
+    cells_[k].push_back(Item{pos, id});
+    id_to_cell_[id.id()] = k;
+    size_++;
+}
+
+void SpatialHash::add(const Eigen::Vector3d &pos, const ID &id) {
+    remove(id);
+    insert(pos, id);
+}
+
+void SpatialHash::remove(const ID &id) {
+    auto it = id_to_cell_.find(id.id());
+    if (it == id_to_cell_.end()) return;
+
+    auto it_cell = cells_.find(it->second);
+    if (it_cell != cells_.end()) {
+        Cell &cell = it_cell->second;
+        auto it_item = std::find_if(cell.begin(), cell.end(),
+            [&](const Item &item) {return item.id.id() == id.id();});
+        if (it_item != cell.end()) {
+            *it_item = cell.back();
+            cell.pop_back();
+            size_--;
+        }
+    }
+    id_to_cell_.erase(it);
+}
+
+void SpatialHash::update(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries) {
+    // Empty the cells but keep their storage. If most of the cells would stay
+    // empty (e.g., the entities spread out), drop them instead.
+    if (cells_.size() > 2 * entries.size() + 16) {
+        cells_.clear();
+    } else {
+        for (auto &kv : cells_) {
+            kv.second.clear();
+        }
+    }
+    id_to_cell_.clear();
+    id_to_cell_.reserve(entries.size());
+    size_ = 0;
+
+    for (auto &kv : entries) {
+        insert(kv.first, kv.second);
+    }
+}
+
+unsigned int SpatialHash::size() const {
+    return size_;
+}
+
+void SpatialHash::neighbors_in_range(const Eigen::Vector3d &pos,
+                                     std::vector<ID> &neighbors,
+                                     double dist,
+                                     int self_id, int team_id) const {
+    neighbors.clear();
+    if (size_ == 0 || dist < 0) return;
+
+    const double dist_sq = dist * dist;
+    auto check_cell = [&](const Cell &cell) {
+        for (const Item &item : cell) {
+            if ((team_id == -1 || item.id.team_id() == team_id) &&
+                (self_id < 0 || item.id.id() != self_id) &&
+                (item.pos - pos).squaredNorm() < dist_sq) {
+                neighbors.push_back(item.id);
+            }
+        }
+    };
+
+    const int64_t x0 = coord(pos(0) - dist), x1 = coord(pos(0) + dist);
+    const int64_t y0 = coord(pos(1) - dist), y1 = coord(pos(1) + dist);
+    const int64_t z0 = coord(pos(2) - dist), z1 = coord(pos(2) + dist);
+
+    // When the query covers more cells than exist, it is cheaper to visit
+    // every cell than to look up each cell in the query box.
+    const double num_query_cells = static_cast<double>(x1 - x0 + 1) *
+        static_cast<double>(y1 - y0 + 1) * static_cast<double>(z1 - z0 + 1);
+    if (num_query_cells >= static_cast<double>(cells_.size())) {
+        for (auto &kv : cells_) {
+            check_cell(kv.second);
+        }
+        return;
+    }
+
+    for (int64_t x = x0; x <= x1; x++) {
+        for (int64_t y = y0; y <= y1; y++) {
+            for (int64_t z = z0; z <= z1; z++) {
+                auto it = cells_.find(key(x, y, z));
+                if (it != cells_.end()) {
+                    check_cell(it->second);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::nearest_n_neighbors(const Eigen::Vector3d &pos,
+                                      std::vector<ID> &neighbors, unsigned int n,
+                                      int self_id, int team_id) const {
+    neighbors.clear();
+
+    if (self_id != -1) {
+        // assume that if an id is given then it will be located at pos so
+        // would always be in the neighborhood
+        n += 1;
+    }
+
+    if (size_ == 0 || n == 0) return;
+
+    std::vector<std::pair<double, ID>> candidates;
+    auto add_cell = [&](const Cell &cell) {
+        for (const Item &item : cell) {
+            if (team_id == -1 || item.id.team_id() == team_id) {
+                candidates.emplace_back((item.pos - pos).squaredNorm(), item.id);
+            }
+        }
+        return cell.size();
+    };
+
+    auto closer = [](const std::pair<double, ID> &a, const std::pair<double, ID> &b) {
+        return a.first < b.first;
+    };
+
+    // Visit shells of cells around the query cell. After visiting the shell
+    // at distance r (in cells), every entity within r * cell_size of pos has
+    // been visited, so the search stops once the n-th closest candidate is
+    // within that distance.
+    const int64_t cx = coord(pos(0)), cy = coord(pos(1)), cz = coord(pos(2));
+    size_t num_visited = 0;
+    for (int64_t r = 0; ; r++) {
+        const double side = static_cast<double>(2 * r + 1);
+        if (side * side * side > static_cast<double>(cells_.size())) {
+            // The shell is larger than the grid, so visit every cell.
+            candidates.clear();
+            for (auto &kv : cells_) {
+                add_cell(kv.second);
+            }
+            break;
+        }
+
+        for (int64_t x = cx - r; x <= cx + r; x++) {
+            for (int64_t y = cy - r; y <= cy + r; y++) {
+                const bool xy_edge = std::abs(x - cx) == r || std::abs(y - cy) == r;
+                // Interior cells were visited by previous shells
+                const int64_t z_step = xy_edge ? 1 : std::max<int64_t>(2 * r, 1);
+                for (int64_t z = cz - r; z <= cz + r; z += z_step) {
+                    auto it = cells_.find(key(x, y, z));
+                    if (it != cells_.end()) {
+                        num_visited += add_cell(it->second);
+                    }
+                }
+            }
+        }
+
+        if (num_visited >= size_) break;
+
+        if (candidates.size() >= n) {
+            std::nth_element(candidates.begin(), candidates.begin() + (n - 1),
+                             candidates.end(), closer);
+            const double covered = r * cell_size_;
+            if (candidates[n - 1].first <= covered * covered) break;
+        }
+    }
+
+    if (candidates.size() > n) {
+        std::nth_element(candidates.begin(), candidates.begin() + (n - 1),
+                         candidates.end(), closer);
+        candidates.resize(n);
+    }
+
+    neighbors.reserve(candidates.size());
+    for (auto &c : candidates) {
+        if (self_id < 0 || c.second.id() != self_id) {
+            neighbors.push_back(c.second);
+        }
+    }
+}
+
+} // namespace scrimmage
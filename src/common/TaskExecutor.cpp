@@ -0,0 +1,192 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/common/TaskExecutor.h>
+
+#include <algorithm>
+
+namespace scrimmage {
+
+namespace {
+// Set on pool threads and on a thread while it runs parallel_for, so that
+// nested calls run serially instead of waiting on themselves.
+thread_local bool in_executor = false;
+
+const uint64_t low_mask = 0xFFFFFFFF;
+
+uint64_t pack(uint64_t begin, uint64_t end) {
+    return (begin << 32) | end;
+}
+} // namespace
+
+TaskExecutor::TaskExecutor(int num_threads) :
+        num_threads_(std::max(1, num_threads)),
+        deques_(new Deque[std::max(1, num_threads)]) {
+    threads_.reserve(num_threads_ - 1);
+    for (int i = 1; i < num_threads_; i++) {
+        threads_.push_back(std::thread(&TaskExecutor::worker, this, i));
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (std::thread &t : threads_) {
+        t.join();
+    }
+}
+
+int TaskExecutor::num_threads() const {
+    return num_threads_;
+}
+
+void TaskExecutor::parallel_for(size_t size, const RangeFunc &func, size_t grain) {
+    if (size == 0) return;
+
+    if (grain == 0) {
+        grain = std::max<size_t>(1, size / (4 * num_threads_));
+    }
+
+    // Only one job runs at a time. Nested or concurrent calls run serially.
+    std::unique_lock<std::mutex> job_lock(job_mutex_, std::try_to_lock);
+    if (num_threads_ == 1 || size <= grain || in_executor || !job_lock.owns_lock()) {
+        func(0, size);
+        return;
+    }
+
+    // Deal the chunks out in contiguous blocks, one block per thread
+    const uint64_t num_chunks = (size + grain - 1) / grain;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int i = 0; i < num_threads_; i++) {
+            uint64_t begin = num_chunks * i / num_threads_;
+            uint64_t end = num_chunks * (i + 1) / num_threads_;
+            deques_[i].range.store(pack(begin, end), std::memory_order_relaxed);
+        }
+        chunks_left_.store(num_chunks, std::memory_order_relaxed);
+        func_ = &func;
+        size_ = size;
+        grain_ = grain;
+        epoch_++;
+    }
+    start_cv_.notify_all();
+
+    in_executor = true;
+    run_chunks(0, func, size, grain);
+    in_executor = false;
+
+    // Wait for the chunks that were stolen from this thread
+    while (chunks_left_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+
+    // Retire the job so that late workers skip it, then wait for the workers
+    // that joined it to leave before func goes out of scope.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        func_ = nullptr;
+    }
+    while (active_workers_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void TaskExecutor::worker(int index) {
+    in_executor = true;
+    uint64_t seen_epoch = 0;
+    while (true) {
+        const RangeFunc *func;
+        size_t size, grain;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&]() {return stop_ || epoch_ != seen_epoch;});
+            if (stop_) return;
+
+            seen_epoch = epoch_;
+            if (func_ == nullptr) continue;
+
+            func = func_;
+            size = size_;
+            grain = grain_;
+            active_workers_.fetch_add(1, std::memory_order_relaxed);
+        }
+        run_chunks(index, *func, size, grain);
+        active_workers_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void TaskExecutor::run_chunks(int index, const RangeFunc &func,
+                              size_t size, size_t grain) {
+    uint64_t chunk;
+    while (pop(index, chunk) || steal(index, chunk)) {
+        size_t begin = chunk * grain;
+        func(begin, std::min(begin + grain, size));
+        chunks_left_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool TaskExecutor::pop(int index, uint64_t &chunk) {
+    std::atomic<uint64_t> &range = deques_[index].range;
+    uint64_t value = range.load(std::memory_order_acquire);
+    while (true) {
+        uint64_t begin = value >> 32;
+        uint64_t end = value & low_mask;
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(value, pack(begin + 1, end),
+                                        std::memory_order_acq_rel)) {
+            chunk = begin;
+            return true;
+        }
+    }
+}
+
+bool TaskExecutor::steal(int index, uint64_t &chunk) {
+    for (int i = 1; i < num_threads_; i++) {
+        std::atomic<uint64_t> &range = deques_[(index + i) % num_threads_].range;
+        uint64_t value = range.load(std::memory_order_acquire);
+        while (true) {
+            uint64_t begin = value >> 32;
+            uint64_t end = value & low_mask;
+            if (begin >= end) break;
+            if (range.compare_exchange_weak(value, pack(begin, end - 1),
+                                            std::memory_order_acq_rel)) {
+                chunk = end - 1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+} // namespace scrimmage
@@ -55,6 +55,8 @@ void Contact::set_id(const ID &id) { id_ = id; }
 
 ID &Contact::id() { return id_; }
 
+const ID &Contact::id() const { return id_; }
+
 void Contact::set_state(StatePtr &state) { state_ = state; }
 
 StatePtr &Contact::state() { return state_; }
@@ -0,0 +1,78 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/entity/ContactSnapshot.h>
+#include <scrimmage/math/State.h>
+
+#include <algorithm>
+
+namespace scrimmage {
+
+void ContactSnapshot::update(const ContactMap &contacts) {
+    // Mark which IDs are present, then walk the IDs in order so that the
+    // arrays don't depend on the hash map's iteration order.
+    int max_id = -1;
+    for (auto &kv : contacts) {
+        if (kv.first >= 0 && kv.second.state_const()) {
+            max_id = std::max(max_id, kv.first);
+        }
+    }
+    id_to_index_.assign(max_id + 1, -1);
+    for (auto &kv : contacts) {
+        if (kv.first >= 0 && kv.second.state_const()) {
+            id_to_index_[kv.first] = 0;
+        }
+    }
+
+    ids_.clear();
+    for (int id = 0; id <= max_id; id++) {
+        if (id_to_index_[id] == 0) {
+            id_to_index_[id] = ids_.size();
+            ids_.push_back(id);
+        }
+    }
+
+    const size_t n = ids_.size();
+    team_ids_.resize(n);
+    pos_.resize(n);
+    vel_.resize(n);
+    quat_.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const Contact &contact = contacts.at(ids_[i]);
+        std::shared_ptr<const State> state = contact.state_const();
+        team_ids_[i] = contact.id().team_id();
+        pos_[i] = state->pos();
+        vel_[i] = state->vel();
+        quat_[i] = state->quat();
+    }
+}
+} // namespace scrimmage
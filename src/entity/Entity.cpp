@@ -56,7 +56,6 @@
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/range/adaptor/transformed.hpp>
-#include <boost/lexical_cast.hpp>
 
 using std::cout;
 using std::endl;
@@ -112,35 +111,7 @@ bool Entity::init(AttributeMap &overrides,
 
     radius_ = get<double>("radius", info, 1.0);
 
-    ////////////////////////////////////////////////////////////
-    // set state
-    ////////////////////////////////////////////////////////////
-    if (!state_) {
-        state_ = std::make_shared<State>();
-    }
-    state_truth_ = state_;
-
-    double x = get("x", info, 0.0);
-    double y = get("y", info, 0.0);
-    double z = get("z", info, 0.0);
-    state_->pos() << x, y, z;
-
-    double vx = get("vx", info, 0.0);
-    double vy = get("vy", info, 0.0);
-    double vz = get("vz", info, 0.0);
-    state_->vel() << vx, vy, vz;
-
-    double sp = get("speed", info, 0.0);
-    if (sp > 0 && vx == 0 && vy == 0 && vz == 0) {
-      Eigen::Vector3d relative_vel_vector = Eigen::Vector3d::UnitX()*sp;
-      Eigen::Vector3d vel_vector = state_->quat().rotate(relative_vel_vector);
-      state_->vel() << vel_vector[0], vel_vector[1], vel_vector[2];
-    }
-
-    double roll = Angles::deg2rad(get("roll", info, 0.0));
-    double pitch = Angles::deg2rad(get("pitch", info, 0.0));
-    double yaw = Angles::deg2rad(get("heading", info, 0.0));
-    state_->quat().set(roll, pitch, yaw);
+    init_state(info);
 
     EntityPtr parent = shared_from_this();
 
@@ -254,6 +225,9 @@ bool Entity::init(AttributeMap &overrides,
             motion_model_->set_param_server(param_server);
             motion_model_->set_name(info["motion_model"]);
             param_override_func(config_parse.params());
+            if (!motion_model_->set_integrator(config_parse.params())) {
+                return false;
+            }
 
             if (debug_level > 1) {
                 cout << "--------------------------------" << endl;
@@ -412,13 +386,22 @@ bool Entity::init(AttributeMap &overrides,
         autonomy_name = std::string("autonomy") + std::to_string(++autonomy_ct);
     }
 
+    // connect_entity="false" leaves the autonomies' outputs unconnected to
+    // the first controller.
+    connect_entity_ = true;
+    if (info.count("connect_entity") > 0) {
+        connect_entity_ = str2bool(info["connect_entity"]);
+    }
+    std::vector<ControllerPtr> no_controllers;
+
     // Create the autonomy plugins from the autonomy_names list.
     for (auto autonomy_name : autonomy_names) {
         auto autonomy = make_autonomy<Autonomy>(
             info[autonomy_name], plugin_manager, overrides[autonomy_name],
             parent, state_, id_to_team_map, id_to_ent_map, proj_, contacts,
             file_search, rtree, pubsub, time, param_server, plugin_tags,
-            param_override_func, controllers_,
+            param_override_func,
+            connect_entity_ ? controllers_ : no_controllers,
             debug_level);
 
         if (autonomy) {
@@ -426,14 +409,9 @@ bool Entity::init(AttributeMap &overrides,
         }
     }
 
-    bool connect_entity = true;
-    if (info.count("connect_entity") > 0) {
-        connect_entity = boost::lexical_cast<bool>(info["connect_entity"]);
-    }
-
     // Verify that at least one autonomy provides the inputs to the first
     // controller if the first controller requires some VariableIO input.
-    if (connect_entity && not controllers_.empty() &&
+    if (connect_entity_ && not controllers_.empty() &&
         controllers_.front()->vars().input_variable_index().size() > 0) {
         auto verify_io = [&](auto &autonomy) {
             return verify_io_connection(autonomy->vars(),
@@ -463,6 +441,182 @@ bool Entity::init(AttributeMap &overrides,
     return true;
 }
 
+void Entity::init_state(std::map<std::string, std::string> &info) {
+    if (!state_) {
+        state_ = std::make_shared<State>();
+    }
+    state_truth_ = state_;
+
+    double x = get("x", info, 0.0);
+    double y = get("y", info, 0.0);
+    double z = get("z", info, 0.0);
+    state_->pos() << x, y, z;
+
+    double vx = get("vx", info, 0.0);
+    double vy = get("vy", info, 0.0);
+    double vz = get("vz", info, 0.0);
+    state_->vel() << vx, vy, vz;
+
+    double sp = get("speed", info, 0.0);
+    if (sp > 0 && vx == 0 && vy == 0 && vz == 0) {
+      Eigen::Vector3d relative_vel_vector = Eigen::Vector3d::UnitX()*sp;
+      Eigen::Vector3d vel_vector = state_->quat().rotate(relative_vel_vector);
+      state_->vel() << vel_vector[0], vel_vector[1], vel_vector[2];
+    }
+
+    double roll = Angles::deg2rad(get("roll", info, 0.0));
+    double pitch = Angles::deg2rad(get("pitch", info, 0.0));
+    double yaw = Angles::deg2rad(get("heading", info, 0.0));
+    state_->quat().set(roll, pitch, yaw);
+}
+
+EntityPtr Entity::make_prototype() {
+    auto clone = [](auto &plugin) {
+        using T = typename std::decay_t<decltype(plugin)>::element_type;
+        return std::dynamic_pointer_cast<T>(plugin->clone());
+    };
+
+    EntityPtr prototype = std::make_shared<Entity>();
+    for (auto &kv : sensors_) {
+        SensorPtr sensor = clone(kv.second);
+        if (sensor == nullptr) return nullptr;
+        prototype->sensors_[kv.first] = sensor;
+    }
+
+    // The blank motion model is copied directly, since the MotionModel base
+    // class can't tell whether it is blank or a plugin without clone()
+    if (motion_model_->name() == "BLANK") {
+        prototype->motion_model_ = std::make_shared<MotionModel>(*motion_model_);
+    } else {
+        prototype->motion_model_ = clone(motion_model_);
+        if (prototype->motion_model_ == nullptr) return nullptr;
+    }
+
+    for (ControllerPtr &controller : controllers_) {
+        ControllerPtr copy = clone(controller);
+        if (copy == nullptr) return nullptr;
+        prototype->controllers_.push_back(copy);
+    }
+
+    for (AutonomyPtr &autonomy : autonomies_) {
+        AutonomyPtr copy = clone(autonomy);
+        if (copy == nullptr) return nullptr;
+        prototype->autonomies_.push_back(copy);
+    }
+
+    prototype->id_ = id_;
+    prototype->connect_entity_ = connect_entity_;
+    prototype->visual_ = std::make_shared<scrimmage_proto::ContactVisual>(*visual_);
+    prototype->mp_ = mp_;
+    prototype->health_points_ = health_points_;
+    prototype->type_ = type_;
+    prototype->proj_ = proj_;
+    prototype->radius_ = radius_;
+    prototype->contacts_ = contacts_;
+    prototype->rtree_ = rtree_;
+    prototype->plugin_manager_ = plugin_manager_;
+    prototype->file_search_ = file_search_;
+    prototype->pubsub_ = pubsub_;
+    prototype->global_services_ = global_services_;
+    prototype->param_server_ = param_server_;
+    prototype->time_ = time_;
+    return prototype;
+}
+
+bool Entity::init_from_prototype(const EntityPtr &prototype,
+                                 std::map<std::string, std::string> &info,
+                                 int id) {
+    pubsub_ = prototype->pubsub_;
+    global_services_ = prototype->global_services_;
+    time_ = prototype->time_;
+    file_search_ = prototype->file_search_;
+    plugin_manager_ = prototype->plugin_manager_;
+    contacts_ = prototype->contacts_;
+    rtree_ = prototype->rtree_;
+    proj_ = prototype->proj_;
+    param_server_ = prototype->param_server_;
+    mp_ = prototype->mp_;
+
+    id_ = prototype->id_;
+    id_.set_id(id);
+    connect_entity_ = prototype->connect_entity_;
+
+    visual_ = std::make_shared<scrimmage_proto::ContactVisual>(*prototype->visual_);
+    visual_->set_id(id);
+    type_ = prototype->type_;
+    health_points_ = prototype->health_points_;
+    radius_ = prototype->radius_;
+
+    init_state(info);
+
+    mp_->entity_params()[id] = info;
+    mp_->ent_id_to_block_id()[id] = id_.sub_swarm_id();
+
+    EntityPtr parent = shared_from_this();
+    auto clone = [&](auto &plugin) {
+        using T = typename std::decay_t<decltype(plugin)>::element_type;
+        std::shared_ptr<T> copy = std::dynamic_pointer_cast<T>(plugin->clone());
+        copy->set_parent(parent);
+        return copy;
+    };
+
+    for (auto &kv : prototype->sensors_) {
+        sensors_[kv.first] = clone(kv.second);
+    }
+
+    if (prototype->motion_model_->name() == "BLANK") {
+        motion_model_ = std::make_shared<MotionModel>(*prototype->motion_model_);
+        motion_model_->set_parent(parent);
+    } else {
+        motion_model_ = clone(prototype->motion_model_);
+    }
+    motion_model_->set_state(state_truth_);
+
+    // Connect the VariableIO of the copies the same way init() connected the
+    // prototype's plugins: each controller to the next one, the last
+    // controller to the motion model and the autonomies to the first
+    // controller. The variable indices are already in the copies.
+    for (ControllerPtr &controller : prototype->controllers_) {
+        controllers_.push_back(clone(controller));
+        controllers_.back()->set_state(state_);
+    }
+    for (size_t i = 0; i < controllers_.size(); i++) {
+        VariableIO &next = (i + 1 < controllers_.size()) ?
+            controllers_[i + 1]->vars() : motion_model_->vars();
+        controllers_[i]->vars().set_output(next.input());
+    }
+
+    for (AutonomyPtr &autonomy : prototype->autonomies_) {
+        autonomies_.push_back(clone(autonomy));
+        autonomies_.back()->set_state(state_);
+        if (connect_entity_ && not controllers_.empty()) {
+            autonomies_.back()->vars().set_output(controllers_.front()->vars().input());
+        }
+    }
+
+    // Initialize the copies in the same order as init() initializes the
+    // plugins
+    for (auto &kv : sensors_) {
+        kv.second->init_instance();
+    }
+    motion_model_->init_instance();
+    for (auto it = controllers_.rbegin(); it != controllers_.rend(); ++it) {
+        (*it)->init_instance();
+    }
+    for (AutonomyPtr &autonomy : autonomies_) {
+        autonomy->init_instance();
+    }
+
+    if (not controllers_.empty()) {
+        if (autonomies_.empty()) {
+            controllers_.front()->set_desired_state(state_);
+        } else {
+            controllers_.front()->set_desired_state(autonomies_.front()->desired_state());
+        }
+    }
+    return true;
+}
+
 bool Entity::parse_visual(std::map<std::string, std::string> &info,
                           MissionParsePtr mp,
                           std::map<std::string, std::string> &overrides) {
@@ -55,6 +55,21 @@ EntityPlugin::EntityPlugin() : parent_(std::make_shared<Entity>()),
                                loop_rate_(0.0),
                                loop_timer_(0.0) {}
 
+EntityPlugin::EntityPlugin(const EntityPlugin &other) :
+    Plugin(other),
+    transform_(std::make_shared<State>(*other.transform_)),
+    id_to_team_map_(other.id_to_team_map_),
+    id_to_ent_map_(other.id_to_ent_map_),
+    vars_(other.vars_),
+    pubsub_(other.pubsub_),
+    time_(other.time_),
+    param_server_(other.param_server_),
+    loop_rate_(other.loop_rate_),
+    loop_timer_(other.loop_timer_) {
+    vars_.set_input(std::make_shared<Eigen::VectorXd>(*vars_.input()));
+    vars_.set_output(std::make_shared<Eigen::VectorXd>(*vars_.output()));
+}
+
 EntityPlugin::~EntityPlugin() {}
 
 void EntityPlugin::set_parent(EntityPtr parent) {parent_ = parent;}
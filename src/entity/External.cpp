@@ -37,6 +37,7 @@
 #include <scrimmage/common/RTree.h>
 #include <scrimmage/common/Time.h>
 #include <scrimmage/common/GlobalService.h>
+#include <scrimmage/entity/ContactSnapshot.h>
 #include <scrimmage/entity/External.h>
 #include <scrimmage/log/Log.h>
 #include <scrimmage/metrics/Metrics.h>
@@ -53,6 +54,8 @@
 #include <iostream>
 #include <iomanip>
 #include <set>
+#include <vector>
+#include <utility>
 
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/LocalCartesian.hpp>
@@ -194,6 +197,8 @@ bool External::create_entity(const std::string &mission_file,
     entity_->set_random(random);
     entity_->contacts() = contacts;
     entity_->rtree() = rtree;
+    contact_snapshot_ = std::make_shared<ContactSnapshot>();
+    entity_->contact_snapshot() = contact_snapshot_;
     entity_->state() = std::make_shared<State>();
 
     call_update_contacts(time_->t());
@@ -403,10 +408,13 @@ bool External::call_update_contacts(double t) {
     if (update_contacts_task.update(t).first) {
         auto rtree = entity_->rtree(); // rtree is a shared_ptr
         if (!rtree) {mutex.unlock(); return false;}
-        rtree->init(entity_->contacts()->size());
+        std::vector<std::pair<Eigen::Vector3d, ID>> entries;
+        entries.reserve(entity_->contacts()->size());
         for (auto &kv : *entity_->contacts()) {
-            rtree->add(kv.second.state()->pos(), kv.second.id());
+            entries.emplace_back(kv.second.state()->pos(), kv.second.id());
         }
+        rtree->update(entries);
+        contact_snapshot_->update(*entity_->contacts());
         update_ents();
     }
     mutex.unlock();
@@ -0,0 +1,128 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/log/AsyncLogWriter.h>
+
+#include <google/protobuf/message_lite.h>
+
+namespace scrimmage {
+
+AsyncLogWriter::AsyncLogWriter(WriteFunc write, std::size_t capacity,
+                               Policy policy) :
+    write_(write), policy_(policy), head_(0), tail_(0),
+    writer_waiting_(false), producer_waiting_(false), failed_(0) {
+    // Round the capacity up to a power of two so indices wrap with a mask
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    ring_.resize(size);
+    mask_ = size - 1;
+
+    thread_ = std::thread(&AsyncLogWriter::run, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    stop();
+}
+
+bool AsyncLogWriter::push(const MessagePtr &msg, int target) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == ring_.size()) {
+        if (policy_ == Policy::DROP) {
+            ++dropped_;
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        producer_waiting_ = true;
+        not_full_.wait(lock, [&]() { return tail - head_.load() < ring_.size(); });
+        producer_waiting_ = false;
+    }
+
+    ring_[tail & mask_] = Item{msg, target};
+    tail_.store(tail + 1);
+
+    if (writer_waiting_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        not_empty_.notify_one();
+    }
+    return true;
+}
+
+void AsyncLogWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    producer_waiting_ = true;
+    not_full_.wait(lock, [&]() { return head_.load() == tail_.load(); });
+    producer_waiting_ = false;
+}
+
+void AsyncLogWriter::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    not_empty_.notify_one();
+    thread_.join();
+}
+
+void AsyncLogWriter::run() {
+    while (true) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            writer_waiting_ = true;
+            not_empty_.wait(lock, [&]() { return stop_ || head != tail_.load(); });
+            writer_waiting_ = false;
+            if (head == tail_.load()) {
+                // stopped and fully drained
+                return;
+            }
+        }
+
+        Item &item = ring_[head & mask_];
+        if (!write_(*item.msg, item.target)) {
+            ++failed_;
+        }
+        item.msg = nullptr;
+        head_.store(head + 1);
+
+        if (producer_waiting_.load()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            not_full_.notify_one();
+        }
+    }
+}
+
+} // namespace scrimmage
@@ -0,0 +1,530 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/log/ChunkedLog.h>
+
+#include <google/protobuf/message_lite.h>
+#include <google/protobuf/io/coded_stream.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+namespace io = boost::iostreams;
+
+using std::cout;
+using std::endl;
+
+namespace scrimmage {
+
+namespace {
+const char file_magic[] = "SCRLOG01";
+const char footer_magic[] = "SCRIDX01";
+const char chunk_magic[] = "CHNK";
+const char index_magic[] = "INDX";
+
+// Size of the chunks that old stream-format logs are split into
+const uint32_t stream_chunk_records = 256;
+
+template <class T>
+void write_pod(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T>
+bool read_pod(std::istream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return in.gcount() == sizeof(T);
+}
+
+bool read_magic(std::istream &in, const char *magic, size_t size) {
+    char buf[8];
+    in.read(buf, size);
+    return in.gcount() == static_cast<std::streamsize>(size)
+        && std::memcmp(buf, magic, size) == 0;
+}
+
+bool read_varint(const char *&p, const char *end, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+// The time is field 1 (a double, wire type 1). Protobuf writes fields in
+// order, so if it is present it comes first. proto3 omits a time of 0.
+double record_time(const char *p, const char *end) {
+    uint64_t tag;
+    double time = 0;
+    if (read_varint(p, end, tag) && tag == ((1 << 3) | 1) && end - p >= 8) {
+        std::memcpy(&time, p, sizeof(time));
+    }
+    return time;
+}
+
+// Fill offsets with the start of each varint-delimited record in raw
+bool find_records(const std::string &raw, std::vector<uint64_t> &offsets,
+                  std::vector<double> *times) {
+    const char *begin = raw.data();
+    const char *end = begin + raw.size();
+    const char *p = begin;
+    while (p < end) {
+        offsets.push_back(p - begin);
+        uint64_t size;
+        if (!read_varint(p, end, size) || size > static_cast<uint64_t>(end - p)) {
+            return false;
+        }
+        if (times) times->push_back(record_time(p, p + size));
+        p += size;
+    }
+    return true;
+}
+} // namespace
+
+ChunkedLogWriter::~ChunkedLogWriter() {
+    close();
+}
+
+bool ChunkedLogWriter::open(const std::string &filename,
+                            unsigned int records_per_chunk) {
+    out_.open(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!out_.is_open()) {
+        cout << "Failed to open file for writing: " << filename << endl;
+        return false;
+    }
+    records_per_chunk_ = std::max(records_per_chunk, 1u);
+    out_.write(file_magic, 8);
+    return out_.good();
+}
+
+bool ChunkedLogWriter::write(const google::protobuf::MessageLite &message,
+                             double time) {
+    if (!out_.is_open()) return false;
+
+    const size_t size = message.ByteSizeLong();
+    uint8_t header[10];
+    uint8_t *header_end =
+        google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(size, header);
+    raw_.append(reinterpret_cast<char *>(header), header_end - header);
+
+    const size_t start = raw_.size();
+    raw_.resize(start + size);
+    message.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(&raw_[start]));
+    times_.push_back(time);
+
+    if (times_.size() >= records_per_chunk_) {
+        return write_chunk();
+    }
+    return true;
+}
+
+bool ChunkedLogWriter::write_chunk() {
+    if (times_.empty()) return true;
+
+    compressed_.clear();
+    io::filtering_ostream compress;
+    compress.push(io::zlib_compressor(io::zlib::best_speed));
+    compress.push(io::back_inserter(compressed_));
+    compress.write(raw_.data(), raw_.size());
+    compress.reset();
+
+    LogChunk chunk;
+    chunk.t_begin = times_.front();
+    chunk.t_end = times_.back();
+    chunk.offset = out_.tellp();
+    chunk.num_records = times_.size();
+
+    out_.write(chunk_magic, 4);
+    write_pod(out_, chunk.num_records);
+    write_pod(out_, static_cast<uint64_t>(raw_.size()));
+    write_pod(out_, static_cast<uint64_t>(compressed_.size()));
+    out_.write(reinterpret_cast<const char *>(times_.data()),
+               times_.size() * sizeof(double));
+    out_.write(compressed_.data(), compressed_.size());
+
+    chunk.end_offset = out_.tellp();
+    chunks_.push_back(chunk);
+
+    raw_.clear();
+    times_.clear();
+    return out_.good();
+}
+
+bool ChunkedLogWriter::close() {
+    if (!out_.is_open()) return true;
+
+    bool success = write_chunk();
+
+    uint64_t index_offset = out_.tellp();
+    out_.write(index_magic, 4);
+    write_pod(out_, static_cast<uint64_t>(chunks_.size()));
+    for (const LogChunk &chunk : chunks_) {
+        write_pod(out_, chunk.t_begin);
+        write_pod(out_, chunk.t_end);
+        write_pod(out_, chunk.offset);
+        write_pod(out_, chunk.num_records);
+    }
+    write_pod(out_, index_offset);
+    out_.write(footer_magic, 8);
+
+    success &= out_.good();
+    out_.close();
+    chunks_.clear();
+    return success;
+}
+
+bool ChunkedLogReader::is_chunked(const std::string &filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return in.is_open() && read_magic(in, file_magic, 8);
+}
+
+bool ChunkedLogReader::open(const std::string &filename) {
+    close();
+    filename_ = filename;
+    in_.open(filename, std::ios::binary);
+    if (!in_.is_open()) {
+        cout << "Failed to open log file: " << filename << endl;
+        return false;
+    }
+
+    chunked_ = read_magic(in_, file_magic, 8);
+    in_.clear();
+    bool success = chunked_ ? build_chunked_index() : scan_stream();
+
+    for (const LogChunk &chunk : chunks_) {
+        first_record_.push_back(num_records_);
+        num_records_ += chunk.num_records;
+    }
+    return success;
+}
+
+void ChunkedLogReader::close() {
+    in_.close();
+    in_.clear();
+    chunked_ = false;
+    chunks_.clear();
+    first_record_.clear();
+    num_records_ = 0;
+    chunk_ = 0;
+    chunk_loaded_ = false;
+    raw_.clear();
+    compressed_.clear();
+    times_.clear();
+    offsets_.clear();
+    record_ = 0;
+}
+
+double ChunkedLogReader::start_time() const {
+    return chunks_.empty() ? 0 : chunks_.front().t_begin;
+}
+
+double ChunkedLogReader::end_time() const {
+    return chunks_.empty() ? 0 : chunks_.back().t_end;
+}
+
+bool ChunkedLogReader::build_chunked_index() {
+    in_.seekg(0, std::ios::end);
+    const uint64_t file_size = in_.tellg();
+
+    uint64_t index_offset = 0;
+    in_.seekg(-16, std::ios::end);
+    bool has_index = read_pod(in_, index_offset) && read_magic(in_, footer_magic, 8)
+        && index_offset <= file_size - 16;
+
+    uint64_t num_chunks = 0;
+    if (has_index) {
+        in_.seekg(index_offset);
+        has_index = read_magic(in_, index_magic, 4) && read_pod(in_, num_chunks);
+    }
+
+    // The chunks have to be in order and end before the index
+    uint64_t prev_offset = 8;
+    for (uint64_t i = 0; has_index && i < num_chunks; i++) {
+        LogChunk chunk;
+        has_index = read_pod(in_, chunk.t_begin) && read_pod(in_, chunk.t_end)
+            && read_pod(in_, chunk.offset) && read_pod(in_, chunk.num_records)
+            && chunk.offset >= prev_offset && chunk.offset < index_offset;
+        prev_offset = chunk.offset;
+        chunks_.push_back(chunk);
+    }
+
+    if (!has_index) {
+        // The run probably ended before the log was closed
+        cout << "Log index missing, scanning chunks: " << filename_ << endl;
+        chunks_.clear();
+        in_.clear();
+        return scan_chunks(8);
+    }
+
+    for (size_t i = 0; i < chunks_.size(); i++) {
+        chunks_[i].end_offset =
+            i + 1 < chunks_.size() ? chunks_[i + 1].offset : index_offset;
+    }
+    return true;
+}
+
+bool ChunkedLogReader::scan_chunks(uint64_t begin) {
+    in_.seekg(0, std::ios::end);
+    const uint64_t file_size = in_.tellg();
+
+    uint64_t offset = begin;
+    std::vector<double> times;
+    while (true) {
+        in_.seekg(offset);
+        LogChunk chunk;
+        uint64_t raw_size, compressed_size;
+        if (!read_magic(in_, chunk_magic, 4) || !read_pod(in_, chunk.num_records)
+            || !read_pod(in_, raw_size) || !read_pod(in_, compressed_size)
+            || chunk.num_records == 0) {
+            break;
+        }
+        // A truncated or corrupt header can claim more than is left
+        const uint64_t data_offset = in_.tellg();
+        const uint64_t remaining = file_size - data_offset;
+        if (chunk.num_records > remaining / sizeof(double)
+            || compressed_size > remaining - chunk.num_records * sizeof(double)) {
+            break;
+        }
+        times.resize(chunk.num_records);
+        in_.read(reinterpret_cast<char *>(times.data()),
+                 times.size() * sizeof(double));
+        chunk.offset = offset;
+        chunk.end_offset = data_offset + times.size() * sizeof(double) + compressed_size;
+        if (!in_.good()) {
+            break;
+        }
+        chunk.t_begin = times.front();
+        chunk.t_end = times.back();
+        chunks_.push_back(chunk);
+        offset = chunk.end_offset;
+    }
+    in_.clear();
+    return true;
+}
+
+bool ChunkedLogReader::scan_stream() {
+    in_.seekg(0, std::ios::end);
+    const uint64_t file_size = in_.tellg();
+    in_.seekg(0);
+
+    LogChunk chunk;
+    uint64_t offset = 0;
+    char head[16];
+    while (true) {
+        // Read the size varint one byte at a time
+        uint64_t size = 0;
+        int shift = 0;
+        bool have_size = false;
+        uint64_t record_offset = offset;
+        char c;
+        while (shift < 64 && in_.get(c)) {
+            ++offset;
+            uint8_t byte = static_cast<uint8_t>(c);
+            size |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+            if ((byte & 0x80) == 0) {
+                have_size = true;
+                break;
+            }
+        }
+        if (!have_size || size > file_size - offset) {
+            // end of file or a truncated last record
+            break;
+        }
+
+        // Only the start of the message is needed for its time
+        in_.read(head, std::min<uint64_t>(size, sizeof(head)));
+        double time = record_time(head, head + in_.gcount());
+        offset += size;
+        in_.seekg(offset);
+
+        if (chunk.num_records == 0) {
+            chunk.offset = record_offset;
+            chunk.t_begin = time;
+        }
+        chunk.t_end = time;
+        chunk.end_offset = offset;
+        if (++chunk.num_records == stream_chunk_records) {
+            chunks_.push_back(chunk);
+            chunk = LogChunk();
+        }
+    }
+    if (chunk.num_records > 0) {
+        chunks_.push_back(chunk);
+    }
+    in_.clear();
+    return true;
+}
+
+bool ChunkedLogReader::load_chunk(size_t index) {
+    chunk_loaded_ = false;
+    chunk_ = index;
+    record_ = 0;
+    raw_.clear();
+    times_.clear();
+    offsets_.clear();
+
+    const LogChunk &chunk = chunks_[index];
+    in_.clear();
+    in_.seekg(chunk.offset);
+
+    if (chunked_) {
+        uint32_t num_records;
+        uint64_t raw_size, compressed_size;
+        if (!read_magic(in_, chunk_magic, 4) || !read_pod(in_, num_records)
+            || !read_pod(in_, raw_size) || !read_pod(in_, compressed_size)) {
+            cout << "Failed to read log chunk: " << filename_ << endl;
+            return false;
+        }
+
+        // Check the sizes against the chunk's extent before allocating.
+        // zlib can't compress by more than about 1032:1.
+        const uint64_t data_offset = in_.tellg();
+        const uint64_t extent = chunk.end_offset > data_offset ?
+            chunk.end_offset - data_offset : 0;
+        if (num_records != chunk.num_records
+            || num_records > extent / sizeof(double)
+            || compressed_size > extent - num_records * sizeof(double)
+            || raw_size / 1032 > compressed_size) {
+            cout << "Corrupt log chunk header: " << filename_ << endl;
+            return false;
+        }
+        times_.resize(num_records);
+        in_.read(reinterpret_cast<char *>(times_.data()), num_records * sizeof(double));
+        compressed_.resize(compressed_size);
+        in_.read(&compressed_[0], compressed_size);
+        if (!in_.good()) {
+            cout << "Failed to read log chunk: " << filename_ << endl;
+            return false;
+        }
+
+        raw_.reserve(raw_size);
+        try {
+            io::filtering_istream decompress;
+            decompress.push(io::zlib_decompressor());
+            decompress.push(io::array_source(compressed_.data(), compressed_.size()));
+            io::copy(decompress, io::back_inserter(raw_));
+        } catch (const io::zlib_error &e) {
+            cout << "Failed to decompress log chunk: " << filename_ << endl;
+            return false;
+        }
+        if (!find_records(raw_, offsets_, nullptr)) {
+            cout << "Corrupt log chunk: " << filename_ << endl;
+            return false;
+        }
+    } else {
+        raw_.resize(chunk.end_offset - chunk.offset);
+        in_.read(&raw_[0], raw_.size());
+        if (!in_.good() || !find_records(raw_, offsets_, &times_)) {
+            cout << "Failed to read log records: " << filename_ << endl;
+            return false;
+        }
+    }
+
+    if (offsets_.size() != chunk.num_records || times_.size() != chunk.num_records) {
+        cout << "Log chunk has the wrong number of records: " << filename_ << endl;
+        return false;
+    }
+    chunk_loaded_ = true;
+    return true;
+}
+
+bool ChunkedLogReader::seek(double t) {
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), t,
+        [](const LogChunk &chunk, double t) { return chunk.t_end < t; });
+    if (it == chunks_.end()) {
+        chunk_ = chunks_.size();
+        chunk_loaded_ = false;
+        return false;
+    }
+
+    size_t index = it - chunks_.begin();
+    if ((!chunk_loaded_ || chunk_ != index) && !load_chunk(index)) {
+        return false;
+    }
+    record_ = std::lower_bound(times_.begin(), times_.end(), t) - times_.begin();
+    return record_ < times_.size();
+}
+
+bool ChunkedLogReader::seek_record(uint64_t index) {
+    if (index >= num_records_) {
+        chunk_ = chunks_.size();
+        chunk_loaded_ = false;
+        return false;
+    }
+    size_t chunk = std::upper_bound(first_record_.begin(), first_record_.end(), index)
+        - first_record_.begin() - 1;
+    if ((!chunk_loaded_ || chunk_ != chunk) && !load_chunk(chunk)) {
+        return false;
+    }
+    record_ = index - first_record_[chunk];
+    return true;
+}
+
+bool ChunkedLogReader::next(google::protobuf::MessageLite &message, double *time) {
+    while (!chunk_loaded_ || record_ >= offsets_.size()) {
+        size_t next_chunk = chunk_loaded_ ? chunk_ + 1 : chunk_;
+        if (next_chunk >= chunks_.size() || !load_chunk(next_chunk)) {
+            chunk_ = chunks_.size();
+            chunk_loaded_ = false;
+            return false;
+        }
+    }
+
+    const char *p = raw_.data() + offsets_[record_];
+    const char *end = raw_.data() + raw_.size();
+    uint64_t size;
+    read_varint(p, end, size);
+    if (time) {
+        *time = times_[record_];
+    }
+    ++record_;
+    return message.ParseFromArray(p, size);
+}
+
+uint64_t ChunkedLogReader::record_index() const {
+    if (chunk_ >= chunks_.size()) {
+        return num_records_;
+    }
+    return first_record_[chunk_] + (chunk_loaded_ ? record_ : 0);
+}
+
+} // namespace scrimmage
@@ -0,0 +1,225 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/log/FrameDelta.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sp = scrimmage_proto;
+
+namespace scrimmage {
+
+namespace {
+double round_to(double value, double precision) {
+    // adding zero turns -0.0 into 0.0, which protobuf does not serialize
+    return std::round(value / precision) * precision + 0.0;
+}
+
+void quantize(sp::Vector3d *v, double precision) {
+    v->set_x(round_to(v->x(), precision));
+    v->set_y(round_to(v->y(), precision));
+    v->set_z(round_to(v->z(), precision));
+}
+
+void quantize(sp::Contact &contact, double precision) {
+    if (precision <= 0 || !contact.has_state()) return;
+    sp::State *state = contact.mutable_state();
+    if (state->has_position()) quantize(state->mutable_position(), precision);
+    if (state->has_linear_velocity()) quantize(state->mutable_linear_velocity(), precision);
+    if (state->has_angular_velocity()) quantize(state->mutable_angular_velocity(), precision);
+    if (state->has_orientation()) {
+        sp::Quaternion *q = state->mutable_orientation();
+        q->set_w(round_to(q->w(), precision));
+        q->set_x(round_to(q->x(), precision));
+        q->set_y(round_to(q->y(), precision));
+        q->set_z(round_to(q->z(), precision));
+    }
+}
+} // namespace
+
+void quantize(sp::Frame &frame, double precision) {
+    for (int i = 0; i < frame.contact_size(); i++) {
+        quantize(*frame.mutable_contact(i), precision);
+    }
+}
+
+void merge_frames(sp::Frame &into, const sp::Frame &next) {
+    if (!next.delta()) {
+        into = next;
+        return;
+    }
+
+    std::unordered_map<int, int> index;
+    for (int i = 0; i < into.contact_size(); i++) {
+        index[into.contact(i).id().id()] = i;
+    }
+
+    // A removed contact is dropped from the earlier frame. Only a delta frame
+    // has to pass the removal on to the decoder.
+    if (next.removed_id_size() > 0) {
+        std::unordered_set<int> removed(next.removed_id().begin(), next.removed_id().end());
+        auto contacts = into.mutable_contact();
+        auto end = std::remove_if(contacts->begin(), contacts->end(),
+            [&](const sp::Contact &c) {return removed.count(c.id().id()) > 0;});
+        contacts->erase(end, contacts->end());
+        index.clear();
+        for (int i = 0; i < into.contact_size(); i++) {
+            index[into.contact(i).id().id()] = i;
+        }
+        if (into.delta()) {
+            for (int id : next.removed_id()) {
+                into.add_removed_id(id);
+            }
+        }
+    }
+
+    for (const sp::Contact &contact : next.contact()) {
+        auto it = index.find(contact.id().id());
+        if (it == index.end()) {
+            index[contact.id().id()] = into.contact_size();
+            *into.add_contact() = contact;
+        } else {
+            *into.mutable_contact(it->second) = contact;
+        }
+    }
+    into.set_time(next.time());
+}
+
+void FrameDeltaEncoder::set_keyframe_interval(unsigned int interval) {
+    keyframe_interval_ = std::max(interval, 1u);
+}
+
+void FrameDeltaEncoder::set_precision(double precision) {
+    precision_ = precision;
+}
+
+void FrameDeltaEncoder::reset() {
+    need_keyframe_ = true;
+}
+
+std::shared_ptr<sp::Frame> FrameDeltaEncoder::encode(const sp::Frame &frame) {
+    const bool keyframe = need_keyframe_ || frames_since_keyframe_ >= keyframe_interval_;
+    if (keyframe) {
+        sent_.clear();
+        frames_since_keyframe_ = 0;
+        need_keyframe_ = false;
+    }
+    frames_since_keyframe_++;
+
+    auto out = std::make_shared<sp::Frame>();
+    out->set_time(frame.time());
+    out->set_delta(!keyframe);
+
+    present_.clear();
+    for (const sp::Contact &contact : frame.contact()) {
+        sp::Contact rounded = contact;
+        quantize(rounded, precision_);
+        rounded.SerializeToString(&buffer_);
+
+        const int id = contact.id().id();
+        present_.insert(id);
+
+        auto it = sent_.find(id);
+        if (it == sent_.end()) {
+            sent_[id].swap(buffer_);
+        } else if (it->second != buffer_) {
+            it->second.swap(buffer_);
+        } else {
+            continue;
+        }
+        out->add_contact()->Swap(&rounded);
+    }
+
+    if (!keyframe) {
+        for (auto it = sent_.begin(); it != sent_.end();) {
+            if (present_.count(it->first) == 0) {
+                out->add_removed_id(it->first);
+                it = sent_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    return out;
+}
+
+void FrameDeltaDecoder::reset() {
+    synced_ = false;
+    order_.clear();
+    contacts_.clear();
+}
+
+std::shared_ptr<sp::Frame>
+FrameDeltaDecoder::decode(const std::shared_ptr<sp::Frame> &frame) {
+    if (!frame->delta()) {
+        order_.clear();
+        contacts_.clear();
+        for (const sp::Contact &contact : frame->contact()) {
+            const int id = contact.id().id();
+            order_.push_back(id);
+            contacts_[id] = contact;
+        }
+        synced_ = true;
+        return frame;
+    }
+
+    if (frame->removed_id_size() > 0) {
+        for (int id : frame->removed_id()) {
+            contacts_.erase(id);
+        }
+        auto removed = [&](int id) {return contacts_.count(id) == 0;};
+        order_.erase(std::remove_if(order_.begin(), order_.end(), removed),
+                     order_.end());
+    }
+
+    for (const sp::Contact &contact : frame->contact()) {
+        const int id = contact.id().id();
+        auto it = contacts_.find(id);
+        if (it == contacts_.end()) {
+            order_.push_back(id);
+            contacts_.emplace(id, contact);
+        } else {
+            it->second = contact;
+        }
+    }
+
+    auto out = std::make_shared<sp::Frame>();
+    out->set_time(frame->time());
+    out->mutable_contact()->Reserve(order_.size());
+    for (int id : order_) {
+        *out->add_contact() = contacts_[id];
+    }
+    return out;
+}
+
+} // namespace scrimmage
@@ -43,6 +43,7 @@
 #include <scrimmage/proto/Visual.pb.h>
 #include <scrimmage/math/State.h>
 #include <scrimmage/log/Log.h>
+#include <scrimmage/log/FrameDelta.h>
 #include <scrimmage/proto/ProtoConversions.h>
 #include <scrimmage/entity/EntityPlugin.h>
 
@@ -74,6 +75,13 @@ Log::Log() : frames_output_(), shapes_output_(), utm_terrain_output_(),
     msgs_fd_ = -1;
 }
 
+Log::~Log() {
+    // The writer thread uses the output streams, which are destroyed first
+    if (writer_) {
+        writer_->stop();
+    }
+}
+
 bool Log::open_file(std::string filename, int &fd) {
     fd = open(filename.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
     if (fd == -1) {
@@ -97,11 +105,18 @@ bool Log::init(const std::string &dir, Log::Mode mode) {
     msgs_name_ = log_dir_ + "/" + msgs_name_;
 
     if (mode_ == WRITE) {
-        if (open_file(frames_name_, frames_fd_)) {
-            frames_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(frames_fd_);
-        }
-        if (open_file(shapes_name_, shapes_fd_)) {
-            shapes_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(shapes_fd_);
+        if (chunked_) {
+            frames_chunked_ = std::make_shared<ChunkedLogWriter>();
+            frames_chunked_->open(frames_name_, records_per_chunk_);
+            shapes_chunked_ = std::make_shared<ChunkedLogWriter>();
+            shapes_chunked_->open(shapes_name_, records_per_chunk_);
+        } else {
+            if (open_file(frames_name_, frames_fd_)) {
+                frames_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(frames_fd_);
+            }
+            if (open_file(shapes_name_, shapes_fd_)) {
+                shapes_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(shapes_fd_);
+            }
         }
         if (open_file(utm_terrain_name_, utm_terrain_fd_)) {
             utm_terrain_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(utm_terrain_fd_);
@@ -109,6 +124,16 @@ bool Log::init(const std::string &dir, Log::Mode mode) {
         if (open_file(contact_visual_name_, contact_visual_fd_)) {
             contact_visual_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(contact_visual_fd_);
         }
+        if (async_ && enable_log_) {
+            auto write = [this](const google::protobuf::MessageLite &message,
+                                int type) {
+                return this->write(static_cast<FileType>(type), message);
+            };
+            writer_ = std::make_shared<AsyncLogWriter>(
+                write, async_queue_size_,
+                async_drop_when_full_ ? AsyncLogWriter::Policy::DROP
+                                      : AsyncLogWriter::Policy::BLOCK);
+        }
     } else if (mode_ == READ) {
         parse(dir);
     }
@@ -133,12 +158,54 @@ bool Log::write_ascii(const std::string &str) {
     return true;
 }
 
+bool Log::write(FileType type, const google::protobuf::MessageLite &message) {
+    if (mode_ == READ || !enable_log_) {
+        return true;
+    }
+
+    switch (type) {
+    case FRAMES:
+        if (frames_chunked_) {
+            return frames_chunked_->write(
+                message, static_cast<const sp::Frame &>(message).time());
+        }
+        return writeDelimitedTo(message, frames_output_);
+    case SHAPES:
+        if (shapes_chunked_) {
+            return shapes_chunked_->write(
+                message, static_cast<const sp::Shapes &>(message).time());
+        }
+        return writeDelimitedTo(message, shapes_output_);
+    case CONTACTVISUAL:
+        return writeDelimitedTo(message, contact_visual_output_);
+    default:
+        cout << "Log write(): Invalid file type: " << type << endl;
+        return false;
+    }
+}
+
+bool Log::save(FileType type,
+               const std::shared_ptr<const google::protobuf::MessageLite> &message) {
+    if (writer_) {
+        writer_->push(message, type);
+        return true;
+    }
+    return write(type, *message);
+}
+
 bool Log::save_frame(const std::shared_ptr<scrimmage_proto::Frame> &frame) {
-    return writeDelimitedTo(*frame, frames_output_);
+    return save(FRAMES, frame);
 }
 
 bool Log::save_shapes(const scrimmage_proto::Shapes &shapes) {
-    return writeDelimitedTo(shapes, shapes_output_);
+    if (writer_) {
+        return save(SHAPES, std::make_shared<scrimmage_proto::Shapes>(shapes));
+    }
+    return write(SHAPES, shapes);
+}
+
+bool Log::save_shapes(const std::shared_ptr<scrimmage_proto::Shapes> &shapes) {
+    return save(SHAPES, shapes);
 }
 
 bool Log::save_utm_terrain(const std::shared_ptr<scrimmage_proto::UTMTerrain> &utm_terrain) {
@@ -146,7 +213,12 @@ bool Log::save_utm_terrain(const std::shared_ptr<scrimmage_proto::UTMTerrain> &u
 }
 
 bool Log::save_contact_visual(const std::shared_ptr<scrimmage_proto::ContactVisual> &contact_visual) {
-    return writeDelimitedTo(*contact_visual, contact_visual_output_);
+    if (writer_) {
+        // The entity keeps changing its visual, so queue a copy
+        return save(CONTACTVISUAL,
+                    std::make_shared<scrimmage_proto::ContactVisual>(*contact_visual));
+    }
+    return write(CONTACTVISUAL, *contact_visual);
 }
 
 std::string Log::frames_filename() { return frames_name_; }
@@ -161,6 +233,17 @@ std::string Log::msgs_filename() { return msgs_name_; }
 
 void Log::set_enable_log(bool enable) { enable_log_ = enable; }
 
+void Log::set_async(bool async, size_t queue_size, bool drop_when_full) {
+    async_ = async;
+    async_queue_size_ = queue_size;
+    async_drop_when_full_ = drop_when_full;
+}
+
+void Log::set_chunked(bool chunked, unsigned int records_per_chunk) {
+    chunked_ = chunked;
+    records_per_chunk_ = records_per_chunk;
+}
+
 bool Log::parse(std::string dir) {
     if (!fs::is_directory(dir)) {
         cout << "Log directory doesn't exist: " << dir << endl;
@@ -195,6 +278,10 @@ bool Log::parse(std::string dir) {
 }
 
 bool Log::parse(std::string filename, Log::FileType type) {
+    if ((type == FRAMES || type == SHAPES) && ChunkedLogReader::is_chunked(filename)) {
+        return parse_chunked(filename, type);
+    }
+
     int input_fd = open(filename.c_str(), O_RDONLY);
     if (input_fd == -1) {
         cout << "Failed to open file: " << filename.c_str() << endl;
@@ -227,17 +314,47 @@ bool Log::parse(std::string filename, Log::FileType type) {
     return true;
 }
 
+bool Log::parse_chunked(const std::string &filename, FileType type) {
+    ChunkedLogReader reader;
+    if (!reader.open(filename)) {
+        return false;
+    }
+
+    if (type == FRAMES) {
+        frames_.clear();
+        scrimmage_frames_.clear();
+        FrameDeltaDecoder decoder;
+        auto frame = std::make_shared<scrimmage_proto::Frame>();
+        while (reader.next(*frame)) {
+            frames_.push_back(decoder.decode(frame));
+            frame = std::make_shared<scrimmage_proto::Frame>();
+        }
+    } else {
+        shapes_.clear();
+        auto shapes = std::make_shared<scrimmage_proto::Shapes>();
+        while (reader.next(*shapes)) {
+            shapes_.push_back(shapes);
+            shapes = std::make_shared<scrimmage_proto::Shapes>();
+        }
+    }
+
+    if (reader.record_index() != reader.num_records()) {
+        cout << "WARNING: Failed to read all records: " << filename << endl;
+    }
+    return true;
+}
+
 bool Log::parse_frames(std::string filename,
                        ZeroCopyInputStreamPtr input) {
     frames_.clear();
     scrimmage_frames_.clear();
+    FrameDeltaDecoder decoder;
     bool success = false, clean_eof = false;
     do {
         std::shared_ptr<scrimmage_proto::Frame> frame = std::make_shared<scrimmage_proto::Frame>();
         success = this->readDelimitedFrom(filename, input, frame, clean_eof);
         if (clean_eof || !success) break;
-        frames_.push_back(frame);
-        scrimmage_frames_.push_back(proto_2_frame(*frame));
+        frames_.push_back(decoder.decode(frame));
     } while (success);
 
     if (!clean_eof) {
@@ -372,6 +489,28 @@ bool Log::close_log() {
         ascii_output_.close();
     }
 
+    // Finish writing everything that is queued before the outputs go away
+    if (writer_) {
+        writer_->stop();
+        if (writer_->dropped() > 0) {
+            cout << "Log - WARNING: dropped " << writer_->dropped()
+                 << " messages because the writer fell behind." << endl;
+        }
+        if (writer_->failed() > 0) {
+            cout << "Log - WARNING: failed to write " << writer_->failed()
+                 << " messages." << endl;
+        }
+        writer_ = nullptr;
+    }
+    if (frames_chunked_) {
+        frames_chunked_->close();
+        frames_chunked_ = nullptr;
+    }
+    if (shapes_chunked_) {
+        shapes_chunked_->close();
+        shapes_chunked_ = nullptr;
+    }
+
     google::protobuf::ShutdownProtobufLibrary();
     frames_output_.reset();
     shapes_output_.reset();
@@ -381,7 +520,16 @@ bool Log::close_log() {
     return true;
 }
 
-std::list<Frame> &Log::scrimmage_frames() { return scrimmage_frames_; }
+std::list<Frame> &Log::scrimmage_frames() {
+    // Converted on first use, most readers only need the proto frames
+    if (scrimmage_frames_.size() != frames_.size()) {
+        scrimmage_frames_.clear();
+        for (auto &frame : frames_) {
+            scrimmage_frames_.push_back(proto_2_frame(*frame));
+        }
+    }
+    return scrimmage_frames_;
+}
 
 std::list<std::shared_ptr<scrimmage_proto::Frame> > &Log::frames() { return frames_; }
 
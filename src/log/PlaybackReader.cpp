@@ -0,0 +1,272 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/log/PlaybackReader.h>
+
+#include <fstream>
+#include <limits>
+
+namespace sp = scrimmage_proto;
+
+namespace scrimmage {
+
+PlaybackReader::PlaybackReader(size_t read_ahead) :
+    read_ahead_(read_ahead > 0 ? read_ahead : 1) {}
+
+PlaybackReader::~PlaybackReader() {
+    close();
+}
+
+bool PlaybackReader::open(const std::string &frames_filename,
+                          const std::string &shapes_filename) {
+    close();
+
+    if (!frames_.open(frames_filename)) {
+        return false;
+    }
+    num_frames_ = frames_.num_records();
+    start_time_ = frames_.start_time();
+    end_time_ = frames_.end_time();
+
+    sp::Frame frame;
+    double t0, t1;
+    if (frames_.next(frame, &t0) && frames_.next(frame, &t1) && t1 > t0) {
+        dt_ = t1 - t0;
+    }
+
+    has_shapes_ = !shapes_filename.empty() && std::ifstream(shapes_filename).good()
+        && shapes_.open(shapes_filename);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = false;
+    eof_ = false;
+    queue_.clear();
+    seek_ = Seek::INDEX;
+    seek_index_ = 0;
+    thread_ = std::thread(&PlaybackReader::read_loop, this);
+    return true;
+}
+
+void PlaybackReader::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        eof_ = true;
+        queue_.clear();
+    }
+    reader_cv_.notify_all();
+    consumer_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    frames_.close();
+    shapes_.close();
+    has_shapes_ = false;
+    next_frame_ = nullptr;
+    next_shapes_ = nullptr;
+}
+
+bool PlaybackReader::next(PlaybackStep &step) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumer_cv_.wait(lock, [&] {
+        return stop_ || !queue_.empty() || (eof_ && seek_ == Seek::NONE);
+    });
+    if (queue_.empty()) {
+        return false;
+    }
+    step = std::move(queue_.front());
+    queue_.pop_front();
+    reader_cv_.notify_one();
+    return true;
+}
+
+void PlaybackReader::seek(double t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    seek_ = Seek::TIME;
+    seek_time_ = t;
+    eof_ = false;
+    queue_.clear();
+    reader_cv_.notify_one();
+}
+
+void PlaybackReader::seek_frame(uint64_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    seek_ = Seek::INDEX;
+    seek_index_ = index;
+    eof_ = false;
+    queue_.clear();
+    reader_cv_.notify_one();
+}
+
+void PlaybackReader::read_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        reader_cv_.wait(lock, [&] {
+            return stop_ || seek_ != Seek::NONE
+                || (!eof_ && queue_.size() < read_ahead_);
+        });
+        if (stop_) {
+            return;
+        }
+
+        if (seek_ != Seek::NONE) {
+            const Seek seek = seek_;
+            const double t = seek_time_;
+            uint64_t index = seek_index_;
+            seek_ = Seek::NONE;
+            lock.unlock();
+
+            if (seek == Seek::TIME) {
+                index = frames_.seek(t) ? frames_.record_index() : num_frames_;
+            }
+            const bool success = position(index);
+
+            lock.lock();
+            if (seek_ == Seek::NONE) {
+                eof_ = !success;
+            }
+            consumer_cv_.notify_all();
+            continue;
+        }
+
+        lock.unlock();
+        PlaybackStep step;
+        const bool success = read_step(step);
+        lock.lock();
+
+        // a seek that arrived while reading makes the step stale
+        if (seek_ != Seek::NONE) {
+            continue;
+        }
+        if (success) {
+            queue_.push_back(std::move(step));
+        } else {
+            eof_ = true;
+        }
+        consumer_cv_.notify_all();
+    }
+}
+
+bool PlaybackReader::read_step(PlaybackStep &step) {
+    std::shared_ptr<sp::Frame> frame = next_frame_;
+    next_frame_ = nullptr;
+    if (!frame) {
+        frame = std::make_shared<sp::Frame>();
+        if (!frames_.next(*frame)) {
+            return false;
+        }
+    }
+    step.index = index_++;
+    step.frame = decoder_.decode(frame);
+    step.shapes.clear();
+
+    while (has_shapes_) {
+        if (!next_shapes_) {
+            next_shapes_ = std::make_shared<sp::Shapes>();
+            if (!shapes_.next(*next_shapes_)) {
+                next_shapes_ = nullptr;
+                break;
+            }
+            if (next_shapes_->time() <= shapes_after_) {
+                next_shapes_ = nullptr;
+                continue;
+            }
+        }
+        if (next_shapes_->time() > step.frame->time()) {
+            break;
+        }
+        step.shapes.push_back(next_shapes_);
+        next_shapes_ = nullptr;
+    }
+    return true;
+}
+
+bool PlaybackReader::position(uint64_t index) {
+    decoder_.reset();
+    next_frame_ = nullptr;
+    next_shapes_ = nullptr;
+    index_ = index;
+    if (index >= num_frames_) {
+        return false;
+    }
+
+    // Back up to the nearest keyframe. Keyframes are at most one keyframe
+    // interval apart, and all frames of older logs are keyframes.
+    auto frame = std::make_shared<sp::Frame>();
+    uint64_t keyframe = index;
+    while (true) {
+        if (!frames_.seek_record(keyframe) || !frames_.next(*frame)) {
+            return false;
+        }
+        if (!frame->delta() || keyframe == 0) break;
+        --keyframe;
+    }
+
+    // Decode the frames up to the requested one, which read_step() decodes
+    double t_prev = -std::numeric_limits<double>::infinity();
+    for (uint64_t i = keyframe; i < index; i++) {
+        if (i > keyframe) {
+            frame = std::make_shared<sp::Frame>();
+            if (!frames_.next(*frame)) {
+                return false;
+            }
+        }
+        decoder_.decode(frame);
+        t_prev = frame->time();
+    }
+    if (keyframe < index) {
+        frame = std::make_shared<sp::Frame>();
+        if (!frames_.next(*frame)) {
+            return false;
+        }
+    } else if (index > 0) {
+        sp::Frame prev;
+        if (frames_.seek_record(index - 1) && frames_.next(prev)) {
+            t_prev = prev.time();
+        }
+        frames_.seek_record(index + 1);
+    }
+    next_frame_ = frame;
+
+    // Send the shapes logged after the previous frame with this frame
+    if (has_shapes_) {
+        shapes_after_ = t_prev;
+        if (index == 0) {
+            shapes_.seek_record(0);
+        } else {
+            shapes_.seek(t_prev);
+        }
+    }
+    return true;
+}
+
+} // namespace scrimmage
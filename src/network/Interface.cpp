@@ -45,6 +45,9 @@ using grpc::Status;
 #include <scrimmage/proto/Shape.pb.h>
 #include <scrimmage/network/Interface.h>
 
+#include <algorithm>
+#include <chrono> // NOLINT
+#include <functional>
 #include <iostream>
 #include <thread> // NOLINT
 
@@ -54,17 +57,248 @@ using std::endl;
 namespace scrimmage {
 
 #if ENABLE_GRPC == 1
+namespace {
+// A client stream that is opened on the first write and reopened on the
+// next write after a failure, e.g., when the receiver restarts. Each context
+// is passed to track() when it is created (open = true) and before it is
+// destroyed (open = false), so that another thread can cancel it.
+template <class T>
+class ClientStream {
+ public:
+    using Open = std::function<std::unique_ptr<grpc::ClientWriter<T>>(
+        grpc::ClientContext *, scrimmage_proto::BlankReply *)>;
+    using Track = std::function<void(grpc::ClientContext *, bool)>;
+
+    ClientStream(const std::string &name, Open open, Track track)
+        : name_(name), open_(open), track_(track) {}
+    ~ClientStream() { close(); }
+
+    bool write(const T &msg) {
+        if (!writer_) {
+            context_ = std::make_unique<grpc::ClientContext>();
+            track_(context_.get(), true);
+            writer_ = open_(context_.get(), &reply_);
+        }
+        if (writer_->Write(msg)) {
+            failed_ = false;
+            return true;
+        }
+
+        grpc::Status status = writer_->Finish();
+        if (!failed_ && status.error_code() != grpc::StatusCode::CANCELLED) {
+            cout << name_ << ": Error code: " << status.error_code() << endl;
+            cout << status.error_message() << endl;
+        }
+        failed_ = true;
+        reset();
+        return false;
+    }
+
+    void close() {
+        if (writer_) {
+            writer_->WritesDone();
+            writer_->Finish();
+            reset();
+        }
+    }
+
+ protected:
+    void reset() {
+        writer_.reset();
+        track_(context_.get(), false);
+        context_.reset();
+    }
+
+    std::string name_;
+    Open open_;
+    Track track_;
+    std::unique_ptr<grpc::ClientContext> context_;
+    std::unique_ptr<grpc::ClientWriter<T>> writer_;
+    scrimmage_proto::BlankReply reply_;
+    bool failed_ = false;
+};
+} // namespace
+
 void Interface::start_server() {
     server_->Wait();
 }
+
+void Interface::send_loop() {
+    namespace sp = scrimmage_proto;
+    sp::ScrimmageService::Stub *stub = scrimmage_stub_.get();
+
+    // Keep the open contexts where the destructor can cancel them
+    auto track = [this](grpc::ClientContext *context, bool open) {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        if (open) {
+            stream_contexts_.push_back(context);
+            if (streams_cancelled_) context->TryCancel();
+        } else {
+            stream_contexts_.remove(context);
+        }
+    };
+
+    ClientStream<sp::Frame> frames("send_frame",
+        [=](grpc::ClientContext *c, sp::BlankReply *r) {return stub->SendFrameStream(c, r);},
+        track);
+    ClientStream<sp::Shapes> shapes("send_shapes",
+        [=](grpc::ClientContext *c, sp::BlankReply *r) {return stub->SendShapesStream(c, r);},
+        track);
+    ClientStream<sp::SimInfo> sim_info("send_sim_info",
+        [=](grpc::ClientContext *c, sp::BlankReply *r) {return stub->SendSimInfoStream(c, r);},
+        track);
+    ClientStream<sp::ContactVisual> contact_visuals("send_contact_visual",
+        [=](grpc::ClientContext *c, sp::BlankReply *r) {return stub->SendContactVisualStream(c, r);},
+        track);
+
+    std::unique_lock<std::mutex> lock(send_mutex_);
+    while (true) {
+        send_cv_.wait(lock, [&] {
+            return send_stop_ || pending_frame_ || pending_shapes_
+                || pending_sim_info_ || !pending_contact_visuals_.empty();
+        });
+
+        // Take everything that is waiting, so that the simulation can keep
+        // queueing while this thread writes
+        auto frame = std::move(pending_frame_);
+        auto shape = std::move(pending_shapes_);
+        auto info = std::move(pending_sim_info_);
+        std::list<std::shared_ptr<sp::ContactVisual>> cvs;
+        cvs.swap(pending_contact_visuals_);
+        pending_frame_ = nullptr;
+        pending_shapes_ = nullptr;
+        pending_sim_info_ = nullptr;
+        pending_frame_owned_ = false;
+        const bool stop = send_stop_;
+        lock.unlock();
+
+        for (auto &cv : cvs) {
+            contact_visuals.write(*cv);
+        }
+        if (shape) shapes.write(*shape);
+        if (frame) frames.write(*frame);
+        if (info) sim_info.write(*info);
+
+        lock.lock();
+        if (stop) break;
+    }
+
+    // Close the streams before telling the destructor that we are done
+    lock.unlock();
+    frames.close();
+    shapes.close();
+    sim_info.close();
+    contact_visuals.close();
+    lock.lock();
+    send_done_ = true;
+    send_cv_.notify_all();
+}
+#endif
+
+Interface::~Interface() {
+#if ENABLE_GRPC == 1
+    if (send_thread_.joinable()) {
+        // Give the sender the client timeout to write what is waiting, then
+        // cancel the streams in case a write is blocked on the receiver
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        send_stop_ = true;
+        send_cv_.notify_all();
+        bool done = send_cv_.wait_for(lock, std::chrono::seconds(client_timeout_),
+                                      [&] { return send_done_; });
+        lock.unlock();
+
+        if (!done) {
+            std::lock_guard<std::mutex> stream_lock(stream_mutex_);
+            streams_cancelled_ = true;
+            for (grpc::ClientContext *context : stream_contexts_) {
+                context->TryCancel();
+            }
+        }
+        send_thread_.join();
+    }
 #endif
+    shm_stop_ = true;
+    if (shm_thread_.joinable()) {
+        shm_thread_.join();
+    }
+}
+
+namespace {
+// Read the messages of a shared memory channel in order. A reader that
+// falls a whole ring behind skips to the oldest message that is left.
+template <class T, class Push>
+bool drain(ShmChannel &channel, uint64_t &next, Push push) {
+    bool read = false;
+    while (next < channel.count()) {
+        auto msg = std::make_shared<T>();
+        ShmChannel::Status status = channel.read(next, *msg);
+        if (status == ShmChannel::Status::OK) {
+            push(msg);
+            read = true;
+            ++next;
+        } else if (status == ShmChannel::Status::OVERWRITTEN) {
+            const uint64_t count = channel.count();
+            next = std::max(next + 1, count - std::min<uint64_t>(count, channel.num_slots()));
+        } else if (status == ShmChannel::Status::ERROR) {
+            ++next;
+        } else {
+            break;
+        }
+    }
+    return read;
+}
+} // namespace
+
+void Interface::shm_read_loop() {
+    namespace sp = scrimmage_proto;
+    ShmChannel frames, shapes;
+    uint64_t next_frame = 0, next_shapes = 0;
+
+    while (!shm_stop_) {
+        // (Re)attach when the writer starts or restarts
+        if (frames.closed()) {
+            if (!frames.open(ShmChannel::frames_name(port_))) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            shapes.open(ShmChannel::shapes_name(port_));
+            // start from the newest frame
+            next_frame = frames.count() > 0 ? frames.count() - 1 : 0;
+            next_shapes = shapes.count();
+        }
+
+        bool read = drain<sp::Frame>(frames, next_frame,
+            [&](std::shared_ptr<sp::Frame> &frame) {push_frame(frame);});
+        if (shapes.is_open()) {
+            read = drain<sp::Shapes>(shapes, next_shapes,
+                [&](std::shared_ptr<sp::Shapes> &s) {push_shapes(*s);}) || read;
+        }
+        if (!read) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
 
 bool Interface::init_network(Interface::Mode_t mode, const std::string &ip, int port) {
     mode_ = mode;
     ip_ = ip;
     port_ = port;
 
-    if (mode_ == server) {
+    if (mode_ == shm_server && !shm_thread_.joinable()) {
+        shm_thread_ = std::thread(&Interface::shm_read_loop, this);
+    } else if (mode_ == shm_client) {
+        shm_frames_ = std::make_shared<ShmChannel>();
+        shm_shapes_ = std::make_shared<ShmChannel>();
+        if (!shm_frames_->create(ShmChannel::frames_name(port_),
+                                 shm_frame_slots_, shm_frame_size_) ||
+            !shm_shapes_->create(ShmChannel::shapes_name(port_),
+                                 shm_shapes_slots_, shm_shapes_size_)) {
+            shm_frames_ = nullptr;
+            shm_shapes_ = nullptr;
+        }
+    }
+
+    if (mode_ == server || mode_ == shm_server) {
 #if ENABLE_GRPC == 1
         std::string result = ip_ + ":" + std::to_string(port_);
         ScrimmageServiceImpl frame_service(this);
@@ -84,7 +318,7 @@ bool Interface::init_network(Interface::Mode_t mode, const std::string &ip, int
 #else
         cout << "WARNING: GRPC DISABLED!" << endl;
 #endif
-    } else if (mode_ == client) {
+    } else if (mode_ == client || mode_ == shm_client) {
 #if ENABLE_GRPC
         std::string result = ip_ + ":" + std::to_string(port_);
         std::shared_ptr<Channel> channel(
@@ -93,6 +327,10 @@ bool Interface::init_network(Interface::Mode_t mode, const std::string &ip, int
         std::unique_ptr<scrimmage_proto::ScrimmageService::Stub> frame_temp(scrimmage_proto::ScrimmageService::NewStub(channel));
         scrimmage_stub_ = std::move(frame_temp);
         cout << "Client connecting to " << result << endl;
+
+        if (!send_thread_.joinable()) {
+            send_thread_ = std::thread(&Interface::send_loop, this);
+        }
 #else
         cout << "WARNING: GRPC DISABLED!" << endl;
 #endif
@@ -102,7 +340,7 @@ bool Interface::init_network(Interface::Mode_t mode, const std::string &ip, int
 
 bool Interface::check_ready() {
 #if ENABLE_GRPC == 1
-    if (mode_ == server || mode_ == shared) return true;
+    if (mode_ == server || mode_ == shm_server || mode_ == shared) return true;
 
     grpc::ClientContext context;
     std::chrono::system_clock::time_point deadline =
@@ -129,29 +367,25 @@ bool Interface::check_ready() {
 bool Interface::send_frame(std::shared_ptr<scrimmage_proto::Frame> &frame) {
     if (mode_ == shared) {
         push_frame(frame);
+    } else if (mode_ == shm_client) {
+        if (shm_frames_) {
+            shm_frames_->write(*shm_decoder_.decode(frame));
+        }
     } else if (mode_ == client) {
 #if ENABLE_GRPC
-        scrimmage_proto::BlankReply reply;
-
-        // Context for the client. It could be used to convey extra information to
-        // the server and/or tweak certain RPC behaviors.
-        grpc::ClientContext context;
-
-        // Set timeout for API
-        std::chrono::system_clock::time_point deadline =
-            std::chrono::system_clock::now() + std::chrono::seconds(client_timeout_);
-        context.set_deadline(deadline);
-
-        grpc::Status status;
-        status = scrimmage_stub_->SendFrame(&context, *frame, &reply);
-
-        if (status.ok()) {
-            return true;
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (pending_frame_ && frame->delta()) {
+            // the frame may also be held by the log, so merge into a copy
+            if (!pending_frame_owned_) {
+                pending_frame_ = std::make_shared<scrimmage_proto::Frame>(*pending_frame_);
+                pending_frame_owned_ = true;
+            }
+            merge_frames(*pending_frame_, *frame);
         } else {
-            cout << "send_frame: Error code: " << status.error_code() << endl;
-            cout << status.error_message() << endl;
-            return false;
+            pending_frame_ = frame;
+            pending_frame_owned_ = false;
         }
+        send_cv_.notify_one();
 #else
         cout << "WARNING: GRPC DISABLED!" << endl;
 #endif
@@ -174,7 +408,7 @@ bool Interface::send_utm_terrain(std::shared_ptr<scrimmage_proto::UTMTerrain> &u
 
     if (mode_ == shared) {
         push_utm_terrain(utm_terrain);
-    } else if (mode_ == client) {
+    } else if (mode_ == client || mode_ == shm_client) {
 #if ENABLE_GRPC
         scrimmage_proto::BlankReply reply;
 
@@ -211,29 +445,11 @@ bool Interface::send_contact_visual(std::shared_ptr<scrimmage_proto::ContactVisu
 
     if (mode_ == shared) {
         push_contact_visual(cv);
-    } else if (mode_ == client) {
+    } else if (mode_ == client || mode_ == shm_client) {
 #if ENABLE_GRPC
-        scrimmage_proto::BlankReply reply;
-
-        // Context for the client. It could be used to convey extra information to
-        // the server and/or tweak certain RPC behaviors.
-        grpc::ClientContext context;
-
-        // Set timeout for API
-        std::chrono::system_clock::time_point deadline =
-            std::chrono::system_clock::now() + std::chrono::seconds(client_timeout_);
-        context.set_deadline(deadline);
-
-        grpc::Status status;
-        status = scrimmage_stub_->SendContactVisual(&context, *cv, &reply);
-
-        if (status.ok()) {
-            return true;
-        } else {
-            cout << "send_contact_visual: Error code: " << status.error_code() << endl;
-            cout << status.error_message() << endl;
-            return false;
-        }
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        pending_contact_visuals_.push_back(cv);
+        send_cv_.notify_one();
 #else
         cout << "WARNING: GRPC DISABLED!" << endl;
 #endif
@@ -244,7 +460,7 @@ bool Interface::send_contact_visual(std::shared_ptr<scrimmage_proto::ContactVisu
 bool Interface::send_gui_msg(scrimmage_proto::GUIMsg &gui_msg) {
     if (mode_ == shared) {
         push_gui_msg(gui_msg);
-    } else if (mode_ == client) {
+    } else if (mode_ == client || mode_ == shm_client) {
 #if ENABLE_GRPC
         scrimmage_proto::BlankReply reply;
 
@@ -277,7 +493,7 @@ bool Interface::send_gui_msg(scrimmage_proto::GUIMsg &gui_msg) {
 bool Interface::send_world_point_clicked_msg(scrimmage_proto::WorldPointClicked &msg) {
     if (mode_ == shared) {
         push_world_point_clicked_msg(msg);
-    } else if (mode_ == client) {
+    } else if (mode_ == client || mode_ == shm_client) {
 #if ENABLE_GRPC
         scrimmage_proto::BlankReply reply;
 
@@ -311,29 +527,11 @@ bool Interface::send_world_point_clicked_msg(scrimmage_proto::WorldPointClicked
 bool Interface::send_sim_info(scrimmage_proto::SimInfo &sim_info) {
     if (mode_ == shared) {
         push_sim_info(sim_info);
-    } else if (mode_ == client) {
+    } else if (mode_ == client || mode_ == shm_client) {
 #if ENABLE_GRPC
-        scrimmage_proto::BlankReply reply;
-
-        // Context for the client. It could be used to convey extra information to
-        // the server and/or tweak certain RPC behaviors.
-        grpc::ClientContext context;
-
-        // Set timeout for API
-        std::chrono::system_clock::time_point deadline =
-            std::chrono::system_clock::now() + std::chrono::seconds(client_timeout_);
-        context.set_deadline(deadline);
-
-        grpc::Status status;
-        status = scrimmage_stub_->SendSimInfo(&context, sim_info, &reply);
-
-        if (status.ok()) {
-            return true;
-        } else {
-            cout << "send_sim_info: Error code: " << status.error_code() << endl;
-            cout << status.error_message() << endl;
-            return false;
-        }
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        pending_sim_info_ = std::make_shared<scrimmage_proto::SimInfo>(sim_info);
+        send_cv_.notify_one();
 #else
         cout << "WARNING: GRPC DISABLED!" << endl;
 #endif
@@ -344,29 +542,19 @@ bool Interface::send_sim_info(scrimmage_proto::SimInfo &sim_info) {
 bool Interface::send_shapes(scrimmage_proto::Shapes &shapes) {
     if (mode_ == shared) {
         push_shapes(shapes);
+    } else if (mode_ == shm_client) {
+        if (shm_shapes_) {
+            shm_shapes_->write(shapes);
+        }
     } else if (mode_ == client) {
 #if ENABLE_GRPC
-        scrimmage_proto::BlankReply reply;
-
-        // Context for the client. It could be used to convey extra information to
-        // the server and/or tweak certain RPC behaviors.
-        grpc::ClientContext context;
-
-        // Set timeout for API
-        std::chrono::system_clock::time_point deadline =
-            std::chrono::system_clock::now() + std::chrono::seconds(client_timeout_);
-        context.set_deadline(deadline);
-
-        grpc::Status status;
-        status = scrimmage_stub_->SendShapes(&context, shapes, &reply);
-
-        if (status.ok()) {
-            return true;
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (pending_shapes_) {
+            pending_shapes_->MergeFrom(shapes);
         } else {
-            cout << "send_shapes: Error code: " << status.error_code() << endl;
-            cout << status.error_message() << endl;
-            return false;
+            pending_shapes_ = std::make_shared<scrimmage_proto::Shapes>(shapes);
         }
+        send_cv_.notify_one();
 #else
         cout << "WARNING: GRPC DISABLED!" << endl;
 #endif
@@ -400,7 +588,7 @@ bool Interface::push_contact_visual(std::shared_ptr<scrimmage_proto::ContactVisu
 
 bool Interface::push_frame(std::shared_ptr<scrimmage_proto::Frame> &frame) {
     frames_mutex.lock();
-    frames_list_.push_back(frame);
+    frames_list_.push_back(frame_decoder_.decode(frame));
     if (frames_list_.size() > max_queue_size_) {
         frames_list_.pop_front();
     }
@@ -82,4 +82,38 @@ grpc::Status scrimmage::ScrimmageServiceImpl::Ready(grpc::ServerContext* context
     return grpc::Status::OK;
 }
 
+grpc::Status scrimmage::ScrimmageServiceImpl::SendFrameStream(grpc::ServerContext *context, grpc::ServerReader<scrimmage_proto::Frame> *reader, scrimmage_proto::BlankReply *reply) {
+    auto f = std::make_shared<scrimmage_proto::Frame>();
+    while (reader->Read(f.get())) {
+        interface_->push_frame(f);
+        f = std::make_shared<scrimmage_proto::Frame>();
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status scrimmage::ScrimmageServiceImpl::SendSimInfoStream(grpc::ServerContext *context, grpc::ServerReader<scrimmage_proto::SimInfo> *reader, scrimmage_proto::BlankReply *reply) {
+    scrimmage_proto::SimInfo si;
+    while (reader->Read(&si)) {
+        interface_->push_sim_info(si);
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status scrimmage::ScrimmageServiceImpl::SendContactVisualStream(grpc::ServerContext *context, grpc::ServerReader<scrimmage_proto::ContactVisual> *reader, scrimmage_proto::BlankReply *reply) {
+    auto cv = std::make_shared<scrimmage_proto::ContactVisual>();
+    while (reader->Read(cv.get())) {
+        interface_->push_contact_visual(cv);
+        cv = std::make_shared<scrimmage_proto::ContactVisual>();
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status scrimmage::ScrimmageServiceImpl::SendShapesStream(grpc::ServerContext *context, grpc::ServerReader<scrimmage_proto::Shapes> *reader, scrimmage_proto::BlankReply *reply) {
+    scrimmage_proto::Shapes s;
+    while (reader->Read(&s)) {
+        interface_->push_shapes(s);
+    }
+    return grpc::Status::OK;
+}
+
 #endif // ENABLE_GRPC
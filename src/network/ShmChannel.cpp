@@ -0,0 +1,271 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/network/ShmChannel.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <google/protobuf/message_lite.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+namespace scrimmage {
+
+namespace {
+const char magic[] = "SCRSHM01";
+const size_t slot_header_size = 16;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared memory channels need lock-free atomics");
+} // namespace
+
+struct ShmChannel::Header {
+    char magic[8];
+    uint32_t num_slots;
+    uint32_t slot_size;
+    std::atomic<uint64_t> count;
+    std::atomic<uint32_t> closed;
+    uint32_t reserved[9];
+};
+
+struct ShmChannel::Slot {
+    std::atomic<uint64_t> seq;
+    uint32_t size;
+    uint32_t reserved;
+
+    char *payload() { return reinterpret_cast<char *>(this) + slot_header_size; }
+};
+
+ShmChannel::~ShmChannel() {
+    close();
+}
+
+std::string ShmChannel::frames_name(int port) {
+    return "/scrimmage_" + std::to_string(port) + "_frames";
+}
+
+std::string ShmChannel::shapes_name(int port) {
+    return "/scrimmage_" + std::to_string(port) + "_shapes";
+}
+
+bool ShmChannel::map(int fd, size_t size) {
+    const int prot = writer_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *data = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        cout << "Failed to map shared memory: " << name_ << endl;
+        return false;
+    }
+    data_ = data;
+    size_ = size;
+    header_ = static_cast<Header *>(data);
+    return true;
+}
+
+bool ShmChannel::create(const std::string &name, uint32_t num_slots, uint32_t slot_size) {
+    static_assert(sizeof(Header) == 64, "unexpected shared memory header size");
+    close();
+    name_ = name;
+    writer_ = true;
+    too_large_ = false;
+
+    num_slots = std::max(num_slots, 1u);
+    slot_size = (slot_size + 7) & ~7u;
+    const size_t size = sizeof(Header) + num_slots * (slot_header_size + slot_size);
+
+    // Replace a channel left behind by a previous run
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd == -1) {
+        cout << "Failed to create shared memory: " << name << endl;
+        return false;
+    }
+    if (ftruncate(fd, size) == -1) {
+        cout << "Failed to size shared memory: " << name << endl;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    if (!map(fd, size)) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // The new mapping is zero filled, so every slot starts with seq 0
+    header_->num_slots = num_slots;
+    header_->slot_size = slot_size;
+    header_->count.store(0, std::memory_order_relaxed);
+    header_->closed.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header_->magic, magic, sizeof(header_->magic));
+    return true;
+}
+
+bool ShmChannel::open(const std::string &name) {
+    close();
+    name_ = name;
+    writer_ = false;
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    if (!map(fd, st.st_size)) {
+        return false;
+    }
+
+    const size_t expected = sizeof(Header) +
+        static_cast<size_t>(header_->num_slots) * (slot_header_size + header_->slot_size);
+    if (std::memcmp(header_->magic, magic, sizeof(header_->magic)) != 0
+        || header_->num_slots == 0 || expected != size_) {
+        close();
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
+
+void ShmChannel::close() {
+    if (header_ == nullptr) return;
+    if (writer_) {
+        header_->closed.store(1, std::memory_order_release);
+        shm_unlink(name_.c_str());
+    }
+    munmap(data_, size_);
+    data_ = nullptr;
+    header_ = nullptr;
+    size_ = 0;
+}
+
+bool ShmChannel::closed() const {
+    return header_ == nullptr || header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+uint64_t ShmChannel::count() const {
+    return header_ ? header_->count.load(std::memory_order_acquire) : 0;
+}
+
+uint32_t ShmChannel::num_slots() const {
+    return header_ ? header_->num_slots : 0;
+}
+
+ShmChannel::Slot *ShmChannel::slot(uint64_t n) const {
+    const size_t stride = slot_header_size + header_->slot_size;
+    char *base = static_cast<char *>(data_) + sizeof(Header);
+    return reinterpret_cast<Slot *>(base + (n % header_->num_slots) * stride);
+}
+
+bool ShmChannel::write(const google::protobuf::MessageLite &message) {
+    if (header_ == nullptr || !writer_) {
+        return false;
+    }
+
+    const size_t size = message.ByteSizeLong();
+    if (size > header_->slot_size) {
+        if (!too_large_) {
+            cout << "Message of " << size << " bytes does not fit in shared memory "
+                 << name_ << " (" << header_->slot_size << " bytes)" << endl;
+            too_large_ = true;
+        }
+        return false;
+    }
+
+    const uint64_t n = header_->count.load(std::memory_order_relaxed);
+    Slot *s = slot(n);
+    s->seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s->size = static_cast<uint32_t>(size);
+    message.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(s->payload()));
+
+    s->seq.store(2 * n + 2, std::memory_order_release);
+    header_->count.store(n + 1, std::memory_order_release);
+    return true;
+}
+
+ShmChannel::Status ShmChannel::read(uint64_t n, google::protobuf::MessageLite &message) const {
+    if (header_ == nullptr) {
+        return Status::ERROR;
+    }
+
+    Slot *s = slot(n);
+    const uint64_t seq = s->seq.load(std::memory_order_acquire);
+    if (seq < 2 * n + 2) {
+        return Status::NOT_READY;
+    } else if (seq > 2 * n + 2) {
+        return Status::OVERWRITTEN;
+    }
+
+    // Parse in place, then check that the writer did not reuse the slot
+    // meanwhile
+    const uint32_t size = s->size;
+    const bool parsed = size <= header_->slot_size
+        && message.ParseFromArray(s->payload(), size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s->seq.load(std::memory_order_relaxed) != seq) {
+        return Status::OVERWRITTEN;
+    }
+    return parsed ? Status::OK : Status::ERROR;
+}
+
+ShmChannel::Status ShmChannel::read_latest(google::protobuf::MessageLite &message,
+                                           uint64_t *n) const {
+    Status status = Status::NOT_READY;
+    for (int attempt = 0; attempt < 3; attempt++) {
+        const uint64_t c = count();
+        if (c == 0) {
+            return Status::NOT_READY;
+        }
+        status = read(c - 1, message);
+        if (status != Status::OVERWRITTEN) {
+            if (n) *n = c - 1;
+            break;
+        }
+    }
+    return status;
+}
+
+} // namespace scrimmage
@@ -54,6 +54,10 @@ using std::endl;
 
 namespace scrimmage {
 
+std::mutex ConfigParse::cache_mutex_;
+std::unordered_map<std::string, std::shared_ptr<const ConfigParse::Template>>
+ConfigParse::cache_;
+
 ConfigParse::ConfigParse() {}
 
 void ConfigParse::set_required(std::string node_name) {
@@ -102,6 +106,50 @@ void ConfigParse::recursive_params(rx::xml_node<char> *root,
     recursive_params(root->next_sibling(), overrides, params, prev);
 }
 
+std::shared_ptr<const ConfigParse::Template> ConfigParse::load(
+        const std::string &filename) {
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = cache_.find(filename);
+        if (it != cache_.end()) return it->second;
+    }
+
+    rx::xml_document<> doc;
+    std::ifstream file(filename.c_str());
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    file.close();
+    std::string content(buffer.str());
+    doc.parse<0>(&content[0]);
+
+    rx::xml_node<> *config_node = doc.first_node("params");
+    if (config_node == 0) {
+        cout << "Missing tag: params" << endl;
+        return nullptr;
+    }
+
+    auto tmpl = std::make_shared<Template>();
+    tmpl->params["XML_DIR"] = fs::path(filename).parent_path().string() + "/";
+    tmpl->params["XML_FILENAME"] = filename;
+    recursive_params(config_node->first_node(), {}, tmpl->params, "");
+
+    // Overrides only replace the values of the XML nodes
+    for (auto &kv : tmpl->params) {
+        if (kv.first == "XML_DIR" || kv.first == "XML_FILENAME" ||
+            boost::algorithm::ends_with(kv.first, ":size")) {
+            tmpl->fixed.insert(kv.first);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return cache_.emplace(filename, tmpl).first->second;
+}
+
+void ConfigParse::clear_cache() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    cache_.clear();
+}
+
 bool ConfigParse::parse(const std::map<std::string, std::string> &overrides,
         std::string filename, std::string env_var,
         FileSearch &file_search, bool verbose) {
@@ -120,31 +168,17 @@ bool ConfigParse::parse(const std::map<std::string, std::string> &overrides,
     }
     filename_ = result;
 
-    rx::xml_document<> doc;
-    std::ifstream file(filename_.c_str());
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    file.close();
-    std::string content(buffer.str());
-    doc.parse<0>(&content[0]);
-
-    rx::xml_node<> *config_node = doc.first_node("params");
-    if (config_node == 0) {
-        cout << "Missing tag: params" << endl;
+    std::shared_ptr<const Template> tmpl = load(filename_);
+    if (tmpl == nullptr) {
         return false;
     }
 
-    params_.clear();
-    params_["XML_DIR"] = this->directory() + "/";
-    params_["XML_FILENAME"] = filename_;
-
-    recursive_params(config_node->first_node(), overrides, params_, "");
-
-    // Determine if there were any overrides (XML attributes) specified in the
-    // mission file that weren't declared in the Plugin's XML
-    // file. Automatically add these overrides to the params block.
+    // Apply the overrides to the parsed file. Overrides (XML attributes)
+    // specified in the mission file that weren't declared in the Plugin's XML
+    // file are added to the params block.
+    params_ = tmpl->params;
     for (auto &kv : overrides) {
-        if (params_.count(kv.first) == 0) {
+        if (tmpl->fixed.count(kv.first) == 0) {
             params_[kv.first] = kv.second;
         }
     }
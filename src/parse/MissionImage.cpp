@@ -0,0 +1,272 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/parse/MissionImage.h>
+
+#include <fstream>
+#include <iostream>
+#include <regex> //NOLINT
+
+#include <rapidxml/rapidxml.hpp>
+
+using std::cout;
+using std::endl;
+
+namespace sp = scrimmage_proto;
+namespace rx = rapidxml;
+
+namespace scrimmage {
+
+namespace {
+const std::string image_header = "SCRIMMAGE_MISSION_IMAGE\n";
+const unsigned int image_version = 1;
+
+void append(const sp::MissionText &text,
+            const std::vector<const std::string *> &slot_values,
+            std::string &out) {
+    for (const sp::MissionSegment &segment : text.segments()) {
+        if (segment.has_placeholder()) {
+            const sp::MissionPlaceholder &placeholder = segment.placeholder();
+            size_t slot = placeholder.slot();
+            const std::string *value =
+                slot < slot_values.size() ? slot_values[slot] : nullptr;
+            out += value ? *value : placeholder.default_value();
+        } else {
+            out += segment.text();
+        }
+    }
+}
+
+// Returns the text with its variables replaced. Text without variables is not
+// copied.
+const char *resolve(rx::xml_document<> &doc, const sp::MissionText &text,
+                    const std::vector<const std::string *> &slot_values,
+                    size_t &size) {
+    if (text.segments_size() == 0) {
+        size = 0;
+        return "";
+    } else if (text.segments_size() == 1 && !text.segments(0).has_placeholder()) {
+        size = text.segments(0).text().size();
+        return text.segments(0).text().c_str();
+    }
+    std::string value;
+    append(text, slot_values, value);
+    size = value.size();
+    return doc.allocate_string(value.c_str(), value.size() + 1);
+}
+} // namespace
+
+bool MissionImage::is_image(const std::string &content) {
+    return content.compare(0, image_header.size(), image_header) == 0;
+}
+
+bool MissionImage::compile(const std::string &mission_filename,
+                           const std::string &content) {
+    image_.Clear();
+    slots_.clear();
+    image_.set_version(image_version);
+    image_.set_mission_filename(mission_filename);
+    split(content, *image_.mutable_content());
+
+    // Parse the xml tree with the variables in it. rapidxml requires a null
+    // terminated string that it can modify.
+    rx::xml_document<> doc;
+    std::vector<char> content_vec(content.begin(), content.end());
+    content_vec.push_back('\0');
+    try {
+        doc.parse<0>(content_vec.data());
+    } catch (...) {
+        cout << "Failed to parse mission file: " << mission_filename << endl;
+        return false;
+    }
+    return compile_node(&doc, *image_.mutable_document());
+}
+
+bool MissionImage::load(const std::string &content) {
+    if (!is_image(content) ||
+        !image_.ParseFromArray(content.data() + image_header.size(),
+                               content.size() - image_header.size())) {
+        cout << "Failed to read mission image" << endl;
+        return false;
+    } else if (image_.version() != image_version) {
+        cout << "Unsupported mission image version: " << image_.version()
+             << ". Compile the mission again." << endl;
+        return false;
+    }
+
+    slots_.clear();
+    for (int i = 0; i < image_.slots_size(); i++) {
+        slots_[image_.slots(i)] = i;
+    }
+    return true;
+}
+
+std::string MissionImage::serialize() const {
+    return image_header + image_.SerializeAsString();
+}
+
+bool MissionImage::write(const std::string &filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        cout << "Failed to open mission image file: " << filename << endl;
+        return false;
+    }
+    file << serialize();
+    return file.good();
+}
+
+const std::string &MissionImage::mission_filename() const {
+    return image_.mission_filename();
+}
+
+int MissionImage::num_slots() const { return image_.slots_size(); }
+
+int MissionImage::slot(const std::string &name) const {
+    auto it = slots_.find(name);
+    return it == slots_.end() ? -1 : it->second;
+}
+
+std::string MissionImage::content(
+        const std::vector<const std::string *> &slot_values) const {
+    std::string out;
+    append(image_.content(), slot_values, out);
+    return out;
+}
+
+std::string MissionImage::source() const {
+    std::string out;
+    for (const sp::MissionSegment &segment : image_.content().segments()) {
+        if (segment.has_placeholder()) {
+            const sp::MissionPlaceholder &placeholder = segment.placeholder();
+            out += "${" + image_.slots(placeholder.slot()) + "="
+                + placeholder.default_value() + "}";
+        } else {
+            out += segment.text();
+        }
+    }
+    return out;
+}
+
+void MissionImage::build(rx::xml_document<> &doc,
+                         const std::vector<const std::string *> &slot_values) const {
+    doc.clear();
+    for (const sp::MissionNode &child : image_.document().children()) {
+        build_node(doc, &doc, child, slot_values);
+    }
+}
+
+void MissionImage::split(const std::string &text, sp::MissionText &out) {
+    // The variables are found like MissionParse::parse() finds them in the
+    // mission file: ${name=default}
+    static const std::regex reg("\\$\\{(.+?)=(.+?)\\}");
+
+    size_t pos = 0;
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), reg);
+         it != std::sregex_iterator(); ++it) {
+        const std::smatch &match = *it;
+        size_t match_pos = match.position();
+        if (match_pos > pos) {
+            out.add_segments()->set_text(text.substr(pos, match_pos - pos));
+        }
+
+        auto result = slots_.emplace(match[1].str(), image_.slots_size());
+        if (result.second) {
+            image_.add_slots(match[1].str());
+        }
+
+        sp::MissionPlaceholder *placeholder =
+            out.add_segments()->mutable_placeholder();
+        placeholder->set_slot(result.first->second);
+        placeholder->set_default_value(match[2].str());
+        pos = match_pos + match.length();
+    }
+    if (pos < text.size()) {
+        out.add_segments()->set_text(text.substr(pos));
+    }
+}
+
+bool MissionImage::compile_node(rx::xml_node<> *node, sp::MissionNode &out) {
+    std::string name(node->name(), node->name_size());
+    if (name.find("${") != std::string::npos) {
+        cout << "Mission variables are only supported in values: " << name << endl;
+        return false;
+    }
+    out.set_type(node->type());
+    out.set_name(name);
+    split(std::string(node->value(), node->value_size()), *out.mutable_value());
+
+    for (rx::xml_attribute<> *attr = node->first_attribute(); attr;
+         attr = attr->next_attribute()) {
+        std::string attr_name(attr->name(), attr->name_size());
+        if (attr_name.find("${") != std::string::npos) {
+            cout << "Mission variables are only supported in values: "
+                 << attr_name << endl;
+            return false;
+        }
+        sp::MissionAttribute *attr_out = out.add_attributes();
+        attr_out->set_name(attr_name);
+        split(std::string(attr->value(), attr->value_size()),
+              *attr_out->mutable_value());
+    }
+
+    for (rx::xml_node<> *child = node->first_node(); child;
+         child = child->next_sibling()) {
+        if (!compile_node(child, *out.add_children())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MissionImage::build_node(rx::xml_document<> &doc, rx::xml_node<> *parent,
+                              const sp::MissionNode &node,
+                              const std::vector<const std::string *> &slot_values) const {
+    size_t value_size;
+    const char *value = resolve(doc, node.value(), slot_values, value_size);
+    rx::xml_node<> *xml_node =
+        doc.allocate_node(static_cast<rx::node_type>(node.type()),
+                          node.name().c_str(), value, node.name().size(),
+                          value_size);
+
+    for (const sp::MissionAttribute &attr : node.attributes()) {
+        const char *attr_value = resolve(doc, attr.value(), slot_values, value_size);
+        xml_node->append_attribute(
+            doc.allocate_attribute(attr.name().c_str(), attr_value,
+                                   attr.name().size(), value_size));
+    }
+    parent->append_node(xml_node);
+
+    for (const sp::MissionNode &child : node.children()) {
+        build_node(doc, xml_node, child, slot_values);
+    }
+}
+} // namespace scrimmage
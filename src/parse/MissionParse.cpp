@@ -32,6 +32,7 @@
 
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/common/FileSearch.h>
+#include <scrimmage/parse/MissionImage.h>
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/parse/ConfigParse.h>
 #include <scrimmage/parse/ParseUtils.h>
@@ -80,65 +81,118 @@ void MissionParse::set_overrides(const std::string &overrides) {
     }
 }
 
-bool MissionParse::parse(const std::string &filename) {
-    mission_filename_ = expand_user(filename);
+bool MissionParse::read_mission_file(const std::string &filename,
+                                     std::string &mission_filename,
+                                     std::string &content) {
+    mission_filename = expand_user(filename);
 
     // First, explicitly search for the mission file.
-    if (!fs::exists(mission_filename_)) {
+    if (!fs::exists(mission_filename)) {
         // If the file doesn't exist, search for the mission file under the
         // SCRIMMAGE_MISSION_PATH.
         FileSearch file_search;
         std::string result = "";
-        bool status = file_search.find_file(mission_filename_, "xml",
+        bool status = file_search.find_file(mission_filename, "xml",
                                             "SCRIMMAGE_MISSION_PATH",
                                             result, false);
         if (!status) {
             // The mission file wasn't found. Exit.
-            cout << "SCRIMMAGE mission file not found: " << mission_filename_ << endl;
+            cout << "SCRIMMAGE mission file not found: " << mission_filename << endl;
             return false;
         }
         // The mission file was found, save its path.
-        mission_filename_ = result;
+        mission_filename = result;
     }
 
-    std::ifstream file(mission_filename_.c_str());
+    std::ifstream file(mission_filename.c_str());
     if (!file.is_open()) {
-        std::cout << "Failed to open mission file: " << mission_filename_ << endl;
+        std::cout << "Failed to open mission file: " << mission_filename << endl;
         return false;
     }
 
     std::stringstream buffer;
     buffer << file.rdbuf();
     file.close();
-    mission_file_content_ = buffer.str();
+    content = buffer.str();
+    return true;
+}
 
-    // Search and replace any overrides of the form ${key=value} in the mission
-    // file
-    for (auto &kv : overrides_map_) {
-        std::regex reg("\\$\\{" + kv.first + "=(.+?)\\}");
-        mission_file_content_ = std::regex_replace(mission_file_content_, reg,
-                                                   kv.second);
+void MissionParse::set_mission_content(const std::string &mission_filename,
+                                       const std::string &content) {
+    preloaded_filename_ = mission_filename;
+    preloaded_content_ = content;
+}
+
+void MissionParse::set_mission_image(const std::string &mission_filename,
+                                     std::shared_ptr<const MissionImage> image) {
+    preloaded_filename_ = mission_filename;
+    preloaded_image_ = image;
+}
+
+bool MissionParse::parse(const std::string &filename) {
+    mission_image_ = preloaded_image_;
+    if (mission_image_) {
+        mission_filename_ = preloaded_filename_;
+    } else if (preloaded_filename_.empty()) {
+        if (!read_mission_file(filename, mission_filename_, mission_file_content_)) {
+            return false;
+        }
+    } else {
+        mission_filename_ = preloaded_filename_;
+        mission_file_content_ = preloaded_content_;
     }
 
-    // Replace our xml variables of the form ${var=default} with the default
-    // value
-    std::string fmt{"$1"};
-    std::regex reg("\\$\\{.+?=(.+?)\\}");
-    mission_file_content_ = std::regex_replace(mission_file_content_, reg, fmt);
+    if (!mission_image_ && MissionImage::is_image(mission_file_content_)) {
+        auto image = std::make_shared<MissionImage>();
+        if (!image->load(mission_file_content_)) {
+            return false;
+        }
+        mission_image_ = image;
+    }
 
-    // Parse the xml tree.
     rapidxml::xml_document<> doc;
-    // doc.parse requires a null terminated string that it can modify.
-    std::vector<char> mission_file_content_vec(mission_file_content_.size() + 1); // allocation done here
-    mission_file_content_vec.assign(mission_file_content_.begin(), mission_file_content_.end()); // copy
-    mission_file_content_vec.push_back('\0'); // shouldn't reallocate
-    try {
-        // Note: This parse function can hard fail (seg fault, no exception) on
-        //       badly formatted xml data. Sometimes it'll except, sometimes not.
-        doc.parse<0>(mission_file_content_vec.data());
-    } catch (...) {
-        cout << "scrimmage::MissionParse::parse: Exception during rapidxml::xml_document<>.parse<>()." << endl;
-        return false;
+    std::vector<char> mission_file_content_vec;
+    if (mission_image_) {
+        // The mission was compiled with "scrimmage --compile-mission". Apply
+        // the overrides by slot and build the xml tree from the image.
+        std::vector<const std::string *> slot_values(mission_image_->num_slots(),
+                                                     nullptr);
+        for (auto &kv : overrides_map_) {
+            int slot = mission_image_->slot(kv.first);
+            if (slot != -1) {
+                slot_values[slot] = &kv.second;
+            }
+        }
+        mission_file_content_ = mission_image_->content(slot_values);
+        mission_image_->build(doc, slot_values);
+    } else {
+        // Search and replace any overrides of the form ${key=value} in the
+        // mission file
+        for (auto &kv : overrides_map_) {
+            std::regex reg("\\$\\{" + kv.first + "=(.+?)\\}");
+            mission_file_content_ = std::regex_replace(mission_file_content_, reg,
+                                                       kv.second);
+        }
+
+        // Replace our xml variables of the form ${var=default} with the
+        // default value
+        std::string fmt{"$1"};
+        std::regex reg("\\$\\{.+?=(.+?)\\}");
+        mission_file_content_ = std::regex_replace(mission_file_content_, reg, fmt);
+
+        // Parse the xml tree.
+        // doc.parse requires a null terminated string that it can modify.
+        mission_file_content_vec.reserve(mission_file_content_.size() + 1); // allocation done here
+        mission_file_content_vec.assign(mission_file_content_.begin(), mission_file_content_.end()); // copy
+        mission_file_content_vec.push_back('\0'); // shouldn't reallocate
+        try {
+            // Note: This parse function can hard fail (seg fault, no exception) on
+            //       badly formatted xml data. Sometimes it'll except, sometimes not.
+            doc.parse<0>(mission_file_content_vec.data());
+        } catch (...) {
+            cout << "scrimmage::MissionParse::parse: Exception during rapidxml::xml_document<>.parse<>()." << endl;
+            return false;
+        }
     }
 
     rapidxml::xml_node<> *runscript_node = doc.first_node("runscript");
@@ -312,11 +366,11 @@ bool MissionParse::parse(const std::string &filename) {
     // Create a directory to hold the log data
     // Use the current time for the directory's name
     time_t rawtime;
-    struct tm * timeinfo;
+    struct tm timeinfo;
     char time_buffer[80];
     time(&rawtime);
-    timeinfo = localtime(&rawtime);
-    strftime(time_buffer, 80, "%Y-%m-%d_%H-%M-%S", timeinfo);
+    localtime_r(&rawtime, &timeinfo); // batch runs parse concurrently
+    strftime(time_buffer, 80, "%Y-%m-%d_%H-%M-%S", &timeinfo);
     std::string name(time_buffer);
 
     log_dir_ = root_log_dir_ + "/" + name;
@@ -718,7 +772,10 @@ bool MissionParse::create_log_dir() {
     }
 
     // Copy the input scenario xml file to the output directory
-    if (fs::exists(mission_filename_)) {
+    if (mission_image_) {
+        std::ofstream orig_out(log_dir_ + "/mission.orig.xml");
+        orig_out << mission_image_->source();
+    } else if (fs::exists(mission_filename_)) {
         fs::copy_file(fs::path(mission_filename_), fs::path(log_dir_+"/mission.orig.xml"));
     }
 
@@ -31,16 +31,42 @@
  */
 
 #include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/parse/ParseUtils.h>
+
+#include <iostream>
 #include <functional>
+
 #include <boost/numeric/odeint.hpp>
 
 namespace pl = std::placeholders;
+namespace odeint = boost::numeric::odeint;
 
 namespace scrimmage {
 
+struct MotionModel::ODEWorkspace {
+    typedef odeint::runge_kutta_dopri5<vector_t> dopri5_t;
+    typedef odeint::result_of::make_controlled<dopri5_t>::type controlled_t;
+
+    explicit ODEWorkspace(double abs_tol, double rel_tol) :
+        rk45(odeint::make_controlled(abs_tol, rel_tol, dopri5_t())) {}
+
+    odeint::runge_kutta4<vector_t> rk4;
+    controlled_t rk45;
+    vector_t dxdt;
+    vector_t x_tmp;
+};
+
 MotionModel::MotionModel() : ext_force_(0, 0, 0), ext_moment_(0, 0, 0),
                              mass_(1.0), g_(9.81) {}
 
+MotionModel::MotionModel(const MotionModel &other) : EntityPlugin(other),
+    semi_implicit_indices_(other.semi_implicit_indices_),
+    state_(other.state_), x_(other.x_),
+    ext_force_(other.ext_force_), ext_moment_(other.ext_moment_),
+    mass_(other.mass_), g_(other.g_),
+    integrator_(other.integrator_),
+    abs_tol_(other.abs_tol_), rel_tol_(other.rel_tol_) {}
+
 std::string MotionModel::type() { return std::string("MotionModel"); }
 
 bool MotionModel::init(std::map<std::string, std::string> &info, std::map<std::string, std::string> &params)
@@ -48,6 +74,15 @@ bool MotionModel::init(std::map<std::string, std::string> &info, std::map<std::s
 
 bool MotionModel::step(double time, double dt) { return true; }
 
+bool MotionModel::step_batch(const std::vector<MotionModel *> &models,
+                             double time, double dt) {
+    bool success = true;
+    for (MotionModel *model : models) {
+        success &= model->step(time, dt);
+    }
+    return success;
+}
+
 bool MotionModel::posthumous(double t) { return true; }
 
 StatePtr &MotionModel::state() {return state_;}
@@ -56,10 +91,79 @@ void MotionModel::set_state(StatePtr &state) {state_ = state;}
 
 void MotionModel::teleport(StatePtr &state) {state_ = state;}
 
+bool MotionModel::set_integrator(std::map<std::string, std::string> &params) {
+    std::string name = get<std::string>("integrator", params, "rk4");
+    if (name == "rk4") {
+        set_integrator(Integrator::RK4);
+    } else if (name == "rk45") {
+        set_integrator(Integrator::RK45);
+    } else if (name == "semi_implicit_euler") {
+        if (semi_implicit_indices_.empty()) {
+            std::cout << "Motion model " << name_ << " doesn't support the "
+                      << "semi_implicit_euler integrator" << std::endl;
+            return false;
+        }
+        set_integrator(Integrator::SEMI_IMPLICIT_EULER);
+    } else {
+        std::cout << "Unknown integrator \"" << name << "\" for motion model "
+                  << name_ << ". Use rk4, rk45, or semi_implicit_euler." << std::endl;
+        return false;
+    }
+    abs_tol_ = get<double>("integrator_abs_tol", params, abs_tol_);
+    rel_tol_ = get<double>("integrator_rel_tol", params, rel_tol_);
+    ode_workspace_ = nullptr;
+    return true;
+}
+
+void MotionModel::set_integrator(Integrator integrator) {
+    integrator_ = integrator;
+}
+
+void MotionModel::reset_integrator() {
+    if (ode_workspace_) {
+        ode_workspace_->rk45.reset();
+    }
+}
+
 void MotionModel::ode_step(double dt) {
+    if (!ode_workspace_) {
+        ode_workspace_ = std::make_shared<ODEWorkspace>(abs_tol_, rel_tol_);
+    }
+    ODEWorkspace &ws = *ode_workspace_;
     auto sys = std::bind(&MotionModel::model, this, pl::_1, pl::_2, pl::_3);
-    boost::numeric::odeint::runge_kutta4<std::vector<double>> stepper;
-    stepper.do_step(sys, x_, 0, dt);
+
+    if (integrator_ == Integrator::RK4) {
+        ws.rk4.do_step(sys, x_, 0, dt);
+    } else if (integrator_ == Integrator::RK45) {
+        // Dopri5 starts a step with the derivative from the end of the
+        // last one, which is stale once the inputs or x_ changed. Pass the
+        // stepper by reference so that its buffers are reused.
+        ws.rk45.reset();
+        odeint::integrate_adaptive(std::ref(ws.rk45), sys, x_, 0.0, dt, dt);
+    } else if (integrator_ == Integrator::SEMI_IMPLICIT_EULER) {
+        ws.dxdt.resize(x_.size());
+        model(x_, ws.dxdt, 0);
+        if (semi_implicit_indices_.empty()) {
+            for (size_t i = 0; i < x_.size(); i++) {
+                x_[i] += dt * ws.dxdt[i];
+            }
+            return;
+        }
+
+        // Update the velocities, then the rest of the state with the
+        // derivative at the new velocities
+        ws.x_tmp = x_;
+        for (int i : semi_implicit_indices_) {
+            ws.x_tmp[i] += dt * ws.dxdt[i];
+        }
+        model(ws.x_tmp, ws.dxdt, dt);
+        for (size_t i = 0; i < x_.size(); i++) {
+            x_[i] += dt * ws.dxdt[i];
+        }
+        for (int i : semi_implicit_indices_) {
+            x_[i] = ws.x_tmp[i];
+        }
+    }
 }
 
 void MotionModel::model(const MotionModel::vector_t &x, MotionModel::vector_t &dxdt, double t) {}
@@ -112,6 +112,8 @@ void PluginManager::print_plugins(const std::string &plugin_type,
                                   const std::string &title,
                                   FileSearch &file_search,
                                   const std::string &env_var_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     // make sure all files are loaded
     if (!files_checked_) {
         file_search.find_files(env_var_name, LIB_EXT, so_files_);
@@ -138,6 +140,7 @@ void PluginManager::print_plugins(const std::string &plugin_type,
 }
 
 void PluginManager::print_returned_plugins() {
+    std::lock_guard<std::mutex> lock(mutex_);
     std::cout << "using the following plugins:" << std::endl;
     for (auto &kv : plugins_info_) {
         for (auto &kv2 : kv.second) {
@@ -175,6 +178,7 @@ PluginPtr PluginManager::make_plugin_helper(std::string &plugin_type, std::strin
 }
 
 std::map<std::string, std::unordered_set<std::string>> PluginManager::get_commits() {
+    std::lock_guard<std::mutex> lock(mutex_);
     std::map<std::string, std::unordered_set<std::string>> commits;
     std::string sha;
     for (auto &kv : plugins_info_) {
@@ -32,6 +32,7 @@
 
 #include <scrimmage/common/RTree.h>
 #include <scrimmage/common/Utilities.h>
+#include <scrimmage/entity/ContactSnapshot.h>
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/math/State.h>
 #include <scrimmage/math/Angles.h>
@@ -100,14 +101,24 @@ bool Boids::step_autonomy(double t, double dt) {
     std::vector<ID> rtree_neighbors;
     rtree_->neighbors_in_range(state_->pos(), rtree_neighbors, comms_range_);
 
+    // Read the other entities' states from the step's snapshot, which is safe
+    // when autonomies run in multiple threads
+    const ContactSnapshot &contacts = *parent_->contact_snapshot();
+    State other;
+
     // Remove neighbors that are not within field of view
     for (auto it = rtree_neighbors.begin(); it != rtree_neighbors.end();
          /* no inc */) {
 
         // Ignore own position / id
-        if (it->id() == parent_->id().id()) {
+        int idx = contacts.index(it->id());
+        if (it->id() == parent_->id().id() || idx < 0) {
             it = rtree_neighbors.erase(it);
-        } else if (state_->InFieldOfView(*(*contacts_)[it->id()].state(), fov_az_, fov_el_)) {
+            continue;
+        }
+
+        other.pos() = contacts.pos()[idx];
+        if (state_->InFieldOfView(other, fov_az_, fov_el_)) {
             // The neighbor is "in front"
             ++it;
         } else {
@@ -134,10 +145,11 @@ bool Boids::step_autonomy(double t, double dt) {
     for (ID id : rtree_neighbors) {
         bool is_team = (id.team_id() == parent_->id().team_id());
 
-        StatePtr other_state = (*contacts_)[id.id()].state();
+        int idx = contacts.index(id.id());
+        const Eigen::Vector3d &other_pos = contacts.pos()[idx];
 
         // Calculate vector pointing from own position to other
-        Eigen::Vector3d diff = other_state->pos() - state_->pos();
+        Eigen::Vector3d diff = other_pos - state_->pos();
         double dist = diff.norm();
 
         // Calculate magnitude of repulsion vector
@@ -162,9 +174,9 @@ bool Boids::step_autonomy(double t, double dt) {
 
         // Calculate centroid of team members and heading alignment
         if (is_team) {
-            centroid = centroid + other_state->pos();
-            align += other_state->vel().normalized();
-            heading += other_state->quat().yaw();
+            centroid = centroid + other_pos;
+            align += contacts.vel()[idx].normalized();
+            heading += contacts.quat()[idx].yaw();
         }
     }
 
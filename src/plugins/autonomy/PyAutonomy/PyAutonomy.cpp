@@ -40,10 +40,12 @@
 #include <scrimmage/pubsub/Subscriber.h>
 #include <scrimmage/pubsub/Publisher.h>
 #include <scrimmage/proto/Shape.pb.h>
+#include <scrimmage/parse/ParseUtils.h>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/embed.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <cstddef>
 #include <stdexcept>
 #include <iostream>
@@ -68,7 +70,35 @@ PyAutonomy::PyAutonomy() {
     need_reset_ = true;
 }
 
+namespace {
+// x, y, z, vx, vy, vz, wx, wy, wz, qw, qx, qy, qz
+const int state_cols = 13;
+// id, team_id, then the state columns
+const int contact_cols = 2 + state_cols;
+
+void state_to_row(const sc::State &state, double *row) {
+    Eigen::Map<Eigen::Vector3d> pos(row), vel(row + 3), ang_vel(row + 6);
+    pos = state.pos();
+    vel = state.vel();
+    ang_vel = state.ang_vel();
+    const sc::Quaternion &quat = state.quat();
+    row[9] = quat.w();
+    row[10] = quat.x();
+    row[11] = quat.y();
+    row[12] = quat.z();
+}
+
+void row_to_state(const double *row, sc::State &state) {
+    state.set_pos(Eigen::Map<const Eigen::Vector3d>(row));
+    state.set_vel(Eigen::Map<const Eigen::Vector3d>(row + 3));
+    state.set_ang_vel(Eigen::Map<const Eigen::Vector3d>(row + 6));
+    state.set_quat(sc::Quaternion(row[9], row[10], row[11], row[12]));
+}
+} // namespace
+
 void PyAutonomy::init(std::map<std::string, std::string> &params) {
+    batch_ = sc::get<bool>("batch", params, false);
+    py_class_name_ = params["module"] + "." + params["class"];
     py_obj_ = get_py_obj(params);
     py_obj_.attr("id") = py::cast(parent_->id());
     init_py_obj(params);
@@ -84,7 +114,8 @@ py::object PyAutonomy::get_py_obj(std::map<std::string, std::string> &params) {
 void PyAutonomy::init_py_obj(std::map<std::string, std::string> &params) {
     py::dict py_params;
     for (auto &kv : params) {
-        if (kv.first != "module" && kv.first != "class" && kv.first != "library") {
+        if (kv.first != "module" && kv.first != "class" && kv.first != "library"
+                && kv.first != "batch") {
             py_params[kv.first.c_str()] = py::str(kv.second);
         }
     }
@@ -229,6 +260,95 @@ std::shared_ptr<scrimmage_proto::Shape> PyAutonomy::py2shape(const pybind11::han
 //     }
 // }
 
+bool PyAutonomy::step_autonomy_batch(const std::vector<Autonomy *> &autonomies,
+                                     double t, double dt) {
+    // The batches may step on a thread that released the GIL
+    py::gil_scoped_acquire acquire;
+
+    // Every PyAutonomy has the same C++ type, so group them by Python class
+    for (auto &kv : batch_groups_) {
+        kv.second.clear();
+    }
+    for (Autonomy *a : autonomies) {
+        PyAutonomy *py_autonomy = static_cast<PyAutonomy *>(a);
+        batch_groups_[py_autonomy->py_class_name_].push_back(py_autonomy);
+    }
+
+    bool success = true;
+    for (auto &kv : batch_groups_) {
+        if (!kv.second.empty()) {
+            success &= kv.second.front()->step_batch_group(kv.second, t, dt);
+        }
+    }
+    return success;
+}
+
+bool PyAutonomy::step_batch_group(const std::vector<PyAutonomy *> &group,
+                                  double t, double dt) {
+    const int rows = group.size();
+    if (rows != batch_rows_) {
+        batch_ids_ = py::array_t<int>(rows);
+        batch_states_ = py::array_t<double>({rows, state_cols});
+        batch_desired_ = py::array_t<double>({rows, state_cols});
+        batch_rows_ = rows;
+    }
+
+    int *ids = batch_ids_.mutable_data();
+    double *states = batch_states_.mutable_data();
+    double *desired = batch_desired_.mutable_data();
+    for (int i = 0; i < rows; i++) {
+        ids[i] = group[i]->parent_->id().id();
+        state_to_row(*group[i]->state_, states + i * state_cols);
+        state_to_row(*group[i]->desired_state_, desired + i * state_cols);
+    }
+
+    const int contact_rows = contacts_->size();
+    if (contact_rows != batch_contact_rows_) {
+        batch_contacts_ = py::array_t<double>({contact_rows, contact_cols});
+        batch_contact_rows_ = contact_rows;
+    }
+    double *contact_row = batch_contacts_.mutable_data();
+    for (auto &kv : *contacts_) {
+        contact_row[0] = kv.second.id().id();
+        contact_row[1] = kv.second.id().team_id();
+        state_to_row(*kv.second.state(), contact_row + 2);
+        contact_row += contact_cols;
+    }
+
+    py::object out;
+    try {
+        py::object step_autonomy_batch = py_obj_.attr("step_autonomy_batch");
+        out = step_autonomy_batch(py::float_(t), py::float_(dt), batch_ids_,
+                                  batch_states_, batch_contacts_, batch_desired_);
+    } catch (py::error_already_set &e) {
+        cout << "PyAutonomy: step_autonomy_batch failed for "
+             << py_class_name_ << ": " << e.what() << endl;
+        return false;
+    }
+
+    using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+    DoubleArray out_array;
+    const double *result = desired;
+    if (py::isinstance<py::bool_>(out)) {
+        if (!out.cast<bool>()) return false;
+    } else if (!out.is_none()) {
+        out_array = out.cast<DoubleArray>();
+        if (out_array.ndim() != 2 || out_array.shape(0) != rows ||
+                out_array.shape(1) != state_cols) {
+            cout << "PyAutonomy: step_autonomy_batch of " << py_class_name_
+                 << " must return an array of shape (" << rows << ", "
+                 << state_cols << ")" << endl;
+            return false;
+        }
+        result = out_array.data();
+    }
+
+    for (int i = 0; i < rows; i++) {
+        row_to_state(result + i * state_cols, *group[i]->desired_state_);
+    }
+    return true;
+}
+
 bool PyAutonomy::step_autonomy(double t, double dt) {
     cache_python_vars();
 
@@ -44,6 +44,32 @@ namespace py = pybind11;
 namespace scrimmage {
 namespace autonomy {
 
+namespace {
+template <class T, class V>
+void put_action(int &idx, size_t from_sz, const T *from_data, V &to_vec) {
+    if (to_vec.size() != from_sz) {
+        to_vec.resize(from_sz);
+    }
+    if (from_data == nullptr && from_sz > 0) {
+        std::cout << "Error: disc_action_data not set correctly" << std::endl;
+        return;
+    } else {
+        for (size_t i = 0; i < from_sz; i++) {
+            to_vec[i] = from_data[idx++];
+        }
+    }
+}
+
+void put_actions(const std::shared_ptr<ScrimmageOpenAIAutonomy> &a,
+                 const int *disc, const double *cont,
+                 int &disc_action_idx, int &cont_action_idx) {
+    put_action(disc_action_idx, a->action_space.discrete_count.size(),
+               disc, a->action.discrete);
+    put_action(cont_action_idx, a->action_space.continuous_extrema.size(),
+               cont, a->action.continuous);
+}
+} // namespace
+
 OpenAIActions::OpenAIActions() :
     tuple_space_(get_gym_space("Tuple")),
     box_space_(get_gym_space("Box")),
@@ -119,36 +145,10 @@ void OpenAIActions::distribute_action(pybind11::object action, bool combine_acto
         }
     };
 
-    auto put_action = [&](int &idx, size_t from_sz, auto *from_data, auto &to_vec) {
-        if (to_vec.size() != from_sz) {
-            to_vec.resize(from_sz);
-        }
-        if (from_data == nullptr && from_sz > 0) {
-            std::cout << "Error: disc_action_data not set correctly" << std::endl;
-            return;
-        } else {
-            for (size_t i = 0; i < from_sz; i++) {
-                to_vec[i] = from_data[idx++];
-            }
-        }
-    };
-
-    auto put_actions = [&](auto a, int &disc_action_idx, int &cont_action_idx) {
-        put_action(disc_action_idx, a->action_space.discrete_count.size(),
-                   disc_action_data, a->action.discrete);
-        put_action(cont_action_idx, a->action_space.continuous_extrema.size(),
-                   cont_action_data, a->action.continuous);
-    };
-
     if (ext_ctrl_vec_.size() == 1 || combine_actors) {
 
         update_action_lists(action_space, action);
-
-        int disc_action_idx = 0;
-        int cont_action_idx = 0;
-        for (auto &a : ext_ctrl_vec_) {
-            put_actions(a, disc_action_idx, cont_action_idx);
-        }
+        distribute_action(disc_action_data, cont_action_data);
 
     } else {
         py::list action_space_list = action_space.attr("spaces").cast<py::list>();
@@ -159,11 +159,29 @@ void OpenAIActions::distribute_action(pybind11::object action, bool combine_acto
             update_action_lists(indiv_action_space, indiv_action);
             int disc_action_idx = 0;
             int cont_action_idx = 0;
-            put_actions(ext_ctrl_vec_[i], disc_action_idx, cont_action_idx);
+            put_actions(ext_ctrl_vec_[i], disc_action_data, cont_action_data,
+                        disc_action_idx, cont_action_idx);
         }
     }
 }
 
+void OpenAIActions::distribute_action(const int *disc, const double *cont) {
+    int disc_action_idx = 0;
+    int cont_action_idx = 0;
+    for (auto &a : ext_ctrl_vec_) {
+        put_actions(a, disc, cont, disc_action_idx, cont_action_idx);
+    }
+}
+
+std::pair<size_t, size_t> OpenAIActions::combined_size() const {
+    std::pair<size_t, size_t> size(0, 0);
+    for (auto &a : ext_ctrl_vec_) {
+        size.first += a->action_space.discrete_count.size();
+        size.second += a->action_space.continuous_extrema.size();
+    }
+    return size;
+}
+
 
 } // namespace autonomy
 } // namespace scrimmage
@@ -48,6 +48,19 @@ namespace ba = boost::adaptors;
 namespace scrimmage {
 namespace autonomy {
 
+namespace {
+template <class T>
+void call_get_obs(T *data, uint32_t &beg_idx,
+                  const std::shared_ptr<sensor::ScrimmageOpenAISensor> &sensor,
+                  int obs_size) {
+    uint32_t end_idx = beg_idx + obs_size;
+    if (end_idx != beg_idx) {
+        sensor->get_observation(data, beg_idx, end_idx);
+        beg_idx = end_idx;
+    }
+}
+} // namespace
+
 OpenAIObservations::OpenAIObservations() :
     tuple_space_(get_gym_space("Tuple")),
     box_space_(get_gym_space("Box")) {}
@@ -55,14 +68,6 @@ OpenAIObservations::OpenAIObservations() :
 pybind11::object OpenAIObservations::update_observation(size_t num_entities,
                                                         bool static_obs_space) {
 
-    auto call_get_obs = [&](auto *data, uint32_t &beg_idx, auto sensor, int obs_size) {
-        uint32_t end_idx = beg_idx + obs_size;
-        if (end_idx != beg_idx) {
-            sensor->get_observation(data, beg_idx, end_idx);
-            beg_idx = end_idx;
-        }
-    };
-
     auto init_arrays = [&](py::object obs_space, py::object obs) {
         py::array_t<int> disc_obs;
         py::array_t<double> cont_obs;
@@ -83,25 +88,9 @@ pybind11::object OpenAIObservations::update_observation(size_t num_entities,
     py::array_t<double> cont_obs;
     if (static_obs_space && (num_entities == 1 || combine_actors_)) {
         std::tie(disc_obs, cont_obs) = init_arrays(observation_space, observation);
-        uint32_t disc_beg_idx = 0;
-        uint32_t cont_beg_idx = 0;
         int* r_disc = static_cast<int *>(disc_obs.request().ptr);
         double* r_cont = static_cast<double *>(cont_obs.request().ptr);
-
-        bool done = false;
-        for (auto &v : ext_sensor_vec_) {
-            if (done) break;
-            for (auto &s : v) {
-                auto obs_space = s->observation_space;
-                call_get_obs(r_disc, disc_beg_idx, s, obs_space.discrete_count.size());
-                call_get_obs(r_cont, cont_beg_idx, s, obs_space.continuous_extrema.size());
-
-                if (num_entities > 1 && global_sensor_) {
-                    done = true;
-                    break;
-                }
-            }
-        }
+        write_observation(num_entities, r_disc, r_cont);
 
     } else {
         py::list observation_space_list =
@@ -136,6 +125,34 @@ pybind11::object OpenAIObservations::update_observation(size_t num_entities,
     return observation;
 }
 
+void OpenAIObservations::write_observation(size_t num_entities,
+                                           int *disc, double *cont) {
+    uint32_t disc_beg_idx = 0;
+    uint32_t cont_beg_idx = 0;
+    for (auto &v : ext_sensor_vec_) {
+        for (auto &s : v) {
+            const EnvParams &obs_space = s->observation_space;
+            call_get_obs(disc, disc_beg_idx, s, obs_space.discrete_count.size());
+            call_get_obs(cont, cont_beg_idx, s, obs_space.continuous_extrema.size());
+
+            if (num_entities > 1 && global_sensor_) return;
+        }
+    }
+}
+
+std::pair<size_t, size_t> OpenAIObservations::combined_size(size_t num_entities) const {
+    std::pair<size_t, size_t> size(0, 0);
+    for (auto &v : ext_sensor_vec_) {
+        for (auto &s : v) {
+            size.first += s->observation_space.discrete_count.size();
+            size.second += s->observation_space.continuous_extrema.size();
+
+            if (num_entities > 1 && global_sensor_) return size;
+        }
+    }
+    return size;
+}
+
 void OpenAIObservations::create_observation_space(size_t num_entities) {
 
     auto create_obs = [&](py::list &discrete_count, py::list &continuous_maxima) -> py::object {
@@ -85,21 +85,9 @@ void Straight::init(std::map<std::string, std::string> &params) {
     save_camera_images_ = scrimmage::get<bool>("save_camera_images", params, false);
     show_text_label_ = scrimmage::get<bool>("show_text_label", params, false);
 
-    // Project goal in front...
-    Eigen::Vector3d rel_pos = Eigen::Vector3d::UnitX()*1e6;
-    Eigen::Vector3d unit_vector = rel_pos.normalized();
-    unit_vector = state_->quat().rotate(unit_vector);
-    goal_ = state_->pos() + unit_vector * rel_pos.norm();
-
-    // Set the desired_z to our initial position.
-    // desired_z_ = state_->pos()(2);
+    enable_boundary_control_ = get<bool>("enable_boundary_control", params, false);
 
-    // Register the desired_z parameter with the parameter server
-    auto param_cb = [&](const double &desired_z) {
-        std::cout << "desired_z param changed at: " << time_->t()
-        << ", with value: " << desired_z << endl;
-    };
-    register_param<double>("desired_z", goal_(2), param_cb);
+    gen_ents_ = sc::get("generate_entities", params, gen_ents_);
 
     if (save_camera_images_) {
         /////////////////////////////////////////////////////////
@@ -124,6 +112,34 @@ void Straight::init(std::map<std::string, std::string> &params) {
         /////////////////////////////////////////////////////////
     }
 
+    init_instance();
+
+    desired_alt_idx_ = vars_.declare(VariableIO::Type::desired_altitude, VariableIO::Direction::Out);
+    desired_speed_idx_ = vars_.declare(VariableIO::Type::desired_speed, VariableIO::Direction::Out);
+    desired_heading_idx_ = vars_.declare(VariableIO::Type::desired_heading, VariableIO::Direction::Out);
+}
+
+std::shared_ptr<EntityPlugin> Straight::clone() {
+    return std::make_shared<Straight>(*this);
+}
+
+void Straight::init_instance() {
+    // Project goal in front...
+    Eigen::Vector3d rel_pos = Eigen::Vector3d::UnitX()*1e6;
+    Eigen::Vector3d unit_vector = rel_pos.normalized();
+    unit_vector = state_->quat().rotate(unit_vector);
+    goal_ = state_->pos() + unit_vector * rel_pos.norm();
+
+    // Set the desired_z to our initial position.
+    // desired_z_ = state_->pos()(2);
+
+    // Register the desired_z parameter with the parameter server
+    auto param_cb = [&](const double &desired_z) {
+        std::cout << "desired_z param changed at: " << time_->t()
+        << ", with value: " << desired_z << endl;
+    };
+    register_param<double>("desired_z", goal_(2), param_cb);
+
     frame_number_ = 0;
 
     if (show_text_label_) {
@@ -136,8 +152,6 @@ void Straight::init(std::map<std::string, std::string> &params) {
         draw_shape(text_shape_);
     }
 
-    enable_boundary_control_ = get<bool>("enable_boundary_control", params, false);
-
     auto bd_cb = [&](auto &msg) {boundary_ = sci::Boundary::make_boundary(msg->data);};
     subscribe<sp::Shape>("GlobalNetwork", "Boundary", bd_cb);
 
@@ -193,14 +207,9 @@ void Straight::init(std::map<std::string, std::string> &params) {
     subscribe<sc::sensor::ContactBlobCameraType>("LocalNetwork", "ContactBlobCamera", blob_cb);
 #endif
 
-    gen_ents_ = sc::get("generate_entities", params, gen_ents_);
     if (gen_ents_) {
         pub_gen_ents_ = advertise("GlobalNetwork", "GenerateEntity");
     }
-
-    desired_alt_idx_ = vars_.declare(VariableIO::Type::desired_altitude, VariableIO::Direction::Out);
-    desired_speed_idx_ = vars_.declare(VariableIO::Type::desired_speed, VariableIO::Direction::Out);
-    desired_heading_idx_ = vars_.declare(VariableIO::Type::desired_heading, VariableIO::Direction::Out);
 }
 
 bool Straight::step_autonomy(double t, double dt) {
@@ -284,5 +293,15 @@ bool Straight::step_autonomy(double t, double dt) {
     noisy_state_set_ = false;
     return true;
 }
+
+boost::any Straight::save_state() {
+    return SavedState(goal_, boundary_, noisy_state_set_, noisy_state_,
+                      noisy_contacts_, prev_gen_time_, frame_number_);
+}
+
+void Straight::restore_state(const boost::any &state) {
+    std::tie(goal_, boundary_, noisy_state_set_, noisy_state_, noisy_contacts_,
+             prev_gen_time_, frame_number_) = boost::any_cast<const SavedState &>(state);
+}
 } // namespace autonomy
 } // namespace scrimmage
@@ -16,3 +16,11 @@ class Straight(object):
         self.desired_state = desired
 
         return True
+
+    def step_autonomy_batch(self, t, dt, ids, states, contacts, desired):
+        # Used instead of step_autonomy when the plugin's batch parameter is
+        # set. Each row of desired belongs to one entity, with the velocity
+        # in columns 3 to 5.
+        desired[:, 0:3] = states[:, 0:3]
+        desired[:, 3:6] = [self.speed, 0, 0]
+        return True
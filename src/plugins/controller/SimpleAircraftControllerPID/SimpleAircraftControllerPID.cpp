@@ -96,5 +96,20 @@ bool SimpleAircraftControllerPID::step(double t, double dt) {
     vars_.output(output_throttle_idx_, u_throttle);
     return true;
 }
+
+boost::any SimpleAircraftControllerPID::save_state() {
+    return std::vector<PID>{heading_pid_, alt_pid_, vel_pid_};
+}
+
+void SimpleAircraftControllerPID::restore_state(const boost::any &state) {
+    const auto &pids = boost::any_cast<const std::vector<PID> &>(state);
+    heading_pid_ = pids[0];
+    alt_pid_ = pids[1];
+    vel_pid_ = pids[2];
+}
+
+std::shared_ptr<EntityPlugin> SimpleAircraftControllerPID::clone() {
+    return std::make_shared<SimpleAircraftControllerPID>(*this);
+}
 }  // namespace controller
 }  // namespace scrimmage
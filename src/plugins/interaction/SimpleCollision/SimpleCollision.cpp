@@ -44,8 +44,12 @@
 
 #include <scrimmage/plugins/interaction/SimpleCollision/SimpleCollision.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace sm = scrimmage_msgs;
 
@@ -69,6 +73,11 @@ bool SimpleCollision::init(std::map<std::string, std::string> &mission_params,
 
     init_alt_deconflict_ = get<bool>("init_alt_deconflict", plugin_params, false);
 
+    num_threads_ = get<int>("num_threads", plugin_params, 1);
+    if (num_threads_ > 1) {
+        executor_ = std::make_shared<TaskExecutor>(num_threads_);
+    }
+
     // Setup publishers
     team_collision_pub_ = advertise("GlobalNetwork", "TeamCollision");
     non_team_collision_pub_ = advertise("GlobalNetwork", "NonTeamCollision");
@@ -79,49 +88,159 @@ bool SimpleCollision::init(std::map<std::string, std::string> &mission_params,
 
 bool SimpleCollision::step_entity_interaction(std::list<EntityPtr> &ents,
                                               double t, double dt) {
-    if (startup_collisions_only_) {
+    if (startup_collisions_only_ || collision_range_ <= 0) {
         return true;
     }
 
-    // Account for entities "colliding"
-    for (EntityPtr ent1 : ents) {
-        Eigen::Vector3d p1 = ent1->state_truth()->pos();
-        for (EntityPtr ent2 : ents) {
-            // ignore distance between itself
-            if (ent1->id().id() == ent2->id().id()) continue;
+    // Index the entities that are still alive in list order. Dead entities
+    // can't collide and entities can't come back to life during this step.
+    alive_.clear();
+    pos_.clear();
+    for (const EntityPtr &ent : ents) {
+        if (!ent->is_alive()) continue;
+        const Eigen::Vector3d &p = ent->state_truth()->pos();
+        if (!p.allFinite()) continue;
+        alive_.push_back(ent.get());
+        pos_.push_back(p);
+    }
+
+    find_candidate_pairs();
+
+    // Resolve the pairs in the order the nested loop over the entity list
+    // would have visited them. A pair (j, i) with j > i never collided in
+    // that loop, since (i, j) was checked first with the same result, so
+    // each unordered pair only has to be visited once.
+    for (const std::pair<int, int> &pair : pairs_) {
+        Entity *ent1 = alive_[pair.first];
+        Entity *ent2 = alive_[pair.second];
 
-            // ignore collisions that have already occurred this time-step
-            if (!ent1->is_alive() || !ent2->is_alive()) continue;
+        // ignore collisions that have already occurred this time-step
+        if (!ent1->is_alive() || !ent2->is_alive()) continue;
 
-            Eigen::Vector3d p2 = ent2->state_truth()->pos();
+        if (enable_team_collisions_ &&
+            ent1->id().team_id() == ent2->id().team_id()) {
 
-            double dist = (p1 - p2).norm();
-            if (dist < collision_range_) {
-                if (enable_team_collisions_ &&
-                    ent1->id().team_id() == ent2->id().team_id()) {
+            ent1->collision();
+            ent2->collision();
 
-                    ent1->collision();
-                    ent2->collision();
+            auto msg = std::make_shared<Message<sm::TeamCollision>>();
+            msg->data.set_entity_id_1(ent1->id().id());
+            msg->data.set_entity_id_2(ent2->id().id());
+            team_collision_pub_->publish(msg);
 
-                    auto msg = std::make_shared<Message<sm::TeamCollision>>();
-                    msg->data.set_entity_id_1(ent1->id().id());
-                    msg->data.set_entity_id_2(ent2->id().id());
-                    team_collision_pub_->publish(msg);
+        } else if (enable_non_team_collisions_ &&
+                   ent1->id().team_id() != ent2->id().team_id()) {
+            ent1->collision();
+            ent2->collision();
 
-                } else if (enable_non_team_collisions_ &&
-                           ent1->id().team_id() != ent2->id().team_id()) {
-                    ent1->collision();
-                    ent2->collision();
+            auto msg = std::make_shared<Message<sm::NonTeamCollision>>();
+            msg->data.set_entity_id_1(ent1->id().id());
+            msg->data.set_entity_id_2(ent2->id().id());
+            non_team_collision_pub_->publish(msg);
+        }
+    }
+    return true;
+}
 
-                    auto msg = std::make_shared<Message<sm::NonTeamCollision>>();
-                    msg->data.set_entity_id_1(ent1->id().id());
-                    msg->data.set_entity_id_2(ent2->id().id());
-                    non_team_collision_pub_->publish(msg);
+void SimpleCollision::find_candidate_pairs() {
+    // Bin the entities into cubic cells that are collision_range_ wide, so
+    // that colliding entities are always in the same or adjacent cells.
+    if (cells_.size() > 2 * alive_.size() + 16) {
+        cells_.clear();
+    } else {
+        for (auto &kv : cells_) {
+            kv.second.clear();
+        }
+    }
+
+    const double inv_cell_size = 1.0 / collision_range_;
+    auto coord = [&](double x) {
+        return static_cast<int64_t>(std::floor(x * inv_cell_size));
+    };
+
+    occupied_.clear();
+    for (int i = 0; i < static_cast<int>(pos_.size()); i++) {
+        const Eigen::Vector3d &p = pos_[i];
+        uint64_t k = cell_key(coord(p(0)), coord(p(1)), coord(p(2)));
+        std::vector<int> &cell = cells_[k];
+        if (cell.empty()) {
+            occupied_.push_back(Cell{coord(p(0)), coord(p(1)), coord(p(2))});
+        }
+        cell.push_back(i);
+    }
+
+    // Split the occupied cells into one range per thread. The pairs that
+    // start in each range are collected separately.
+    size_t num_threads = std::max(1, num_threads_);
+    num_threads = std::min(num_threads, occupied_.size() / min_cells_per_thread_ + 1);
+    thread_pairs_.resize(num_threads);
+
+    if (num_threads == 1) {
+        find_candidate_pairs(0, occupied_.size(), thread_pairs_[0]);
+    } else {
+        size_t chunk = (occupied_.size() + num_threads - 1) / num_threads;
+        executor_->parallel_for(num_threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                size_t cell_begin = std::min(i * chunk, occupied_.size());
+                size_t cell_end = std::min(cell_begin + chunk, occupied_.size());
+                find_candidate_pairs(cell_begin, cell_end, thread_pairs_[i]);
+            }
+        }, 1);
+    }
+
+    pairs_.clear();
+    for (size_t i = 0; i < num_threads; i++) {
+        pairs_.insert(pairs_.end(), thread_pairs_[i].begin(), thread_pairs_[i].end());
+    }
+    std::sort(pairs_.begin(), pairs_.end());
+}
+
+void SimpleCollision::find_candidate_pairs(size_t begin, size_t end,
+                                           std::vector<std::pair<int, int>> &pairs) const {
+    pairs.clear();
+
+    auto add_if_close = [&](int i, int j) {
+        if ((pos_[i] - pos_[j]).norm() < collision_range_) {
+            pairs.push_back(std::minmax(i, j));
+        }
+    };
+
+    for (size_t c = begin; c < end; c++) {
+        const Cell &cell = occupied_[c];
+        const std::vector<int> &items = cells_.at(cell_key(cell.x, cell.y, cell.z));
+
+        // pairs inside the cell
+        for (size_t a = 0; a < items.size(); a++) {
+            for (size_t b = a + 1; b < items.size(); b++) {
+                add_if_close(items[a], items[b]);
+            }
+        }
+
+        // Pairs with the half of the neighboring cells that come after this
+        // one, so that a pair of cells is only visited from one side.
+        for (int dx = 0; dx <= 1; dx++) {
+            for (int dy = (dx == 0 ? 0 : -1); dy <= 1; dy++) {
+                for (int dz = (dx == 0 && dy == 0 ? 1 : -1); dz <= 1; dz++) {
+                    auto it = cells_.find(cell_key(cell.x + dx, cell.y + dy, cell.z + dz));
+                    if (it == cells_.end()) continue;
+                    for (int i : items) {
+                        for (int j : it->second) {
+                            add_if_close(i, j);
+                        }
+                    }
                 }
             }
         }
     }
-    return true;
+}
+
+uint64_t SimpleCollision::cell_key(int64_t x, int64_t y, int64_t z) {
+    // 21 bits per coordinate. Cells that are 2^21 cells apart share a key,
+    // which only adds candidates that fail the distance check.
+    const uint64_t mask = (static_cast<uint64_t>(1) << 21) - 1;
+    return ((static_cast<uint64_t>(x) & mask) << 42) |
+        ((static_cast<uint64_t>(y) & mask) << 21) |
+        (static_cast<uint64_t>(z) & mask);
 }
 
 bool SimpleCollision::collision_exists(std::list<EntityPtr> &ents,
@@ -149,5 +268,11 @@ bool SimpleCollision::collision_exists(std::list<EntityPtr> &ents,
     }
     return false;
 }
+
+double SimpleCollision::startup_collision_range() {
+    // The altitude deconfliction only compares altitudes, which the grid of
+    // positions can't check
+    return init_alt_deconflict_ ? 0.0 : startup_collision_range_;
+}
 } // namespace interaction
 } // namespace scrimmage
@@ -48,6 +48,8 @@
 
 #include <iostream>
 #include <limits>
+#include <tuple>
+#include <utility>
 
 using std::cout;
 using std::endl;
@@ -88,6 +90,15 @@ void OpenAIRewards::print_team_summaries() {
     }
 }
 
+boost::any OpenAIRewards::save_state() {
+    return std::make_pair(rewards_, print_team_summary_);
+}
+
+void OpenAIRewards::restore_state(const boost::any &state) {
+    std::tie(rewards_, print_team_summary_) =
+        boost::any_cast<const std::pair<std::map<size_t, double>, bool> &>(state);
+}
+
 void OpenAIRewards::calc_team_scores() {
     CSV csv;
     std::string filename = parent_->mp()->log_dir() + "/rewards.csv";
@@ -118,6 +118,16 @@ bool SimpleCollisionMetrics::step_metrics(double t, double dt) {
     return true;
 }
 
+boost::any SimpleCollisionMetrics::save_state() {
+    return SavedState(scores_, team_coll_scores_, surviving_teams_,
+                      initialized_, teams_);
+}
+
+void SimpleCollisionMetrics::restore_state(const boost::any &state) {
+    std::tie(scores_, team_coll_scores_, surviving_teams_, initialized_, teams_) =
+        boost::any_cast<const SavedState &>(state);
+}
+
 void SimpleCollisionMetrics::calc_team_scores() {
     double end_time = -std::numeric_limits<double>::infinity();
     double beg_time = std::numeric_limits<double>::infinity();
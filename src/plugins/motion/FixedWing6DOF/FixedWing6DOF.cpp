@@ -64,6 +64,9 @@ namespace pl = std::placeholders;
 FixedWing6DOF::FixedWing6DOF() {
     Eigen::AngleAxisd aa(M_PI, Eigen::Vector3d::UnitX());
     rot_180_x_axis_ = Eigen::Quaterniond(aa);
+
+    // Semi-implicit Euler updates the body velocities and rates first
+    semi_implicit_indices_ = {U, V, W, P, Q, R};
 }
 
 std::tuple<int, int, int> FixedWing6DOF::version() {
@@ -60,6 +60,9 @@ namespace motion {
 
 Multirotor::Multirotor() : write_csv_(false) {
     x_.resize(MODEL_NUM_ITEMS);
+
+    // Semi-implicit Euler updates the body velocities and rates first
+    semi_implicit_indices_ = {U, V, W, P, Q, R};
 }
 
 bool Multirotor::init(std::map<std::string, std::string> &info,
@@ -71,10 +71,6 @@ std::tuple<int, int, int> SimpleAircraft::version() {
 
 bool SimpleAircraft::init(std::map<std::string, std::string> &info,
                           std::map<std::string, std::string> &params) {
-    x_.resize(MODEL_NUM_ITEMS);
-    Eigen::Vector3d &pos = state_->pos();
-    Quaternion &quat = state_->quat();
-
     min_velocity_ = get("min_velocity", params, 15.0);
     max_velocity_ = get("max_velocity", params, 40.0);
     max_roll_ = Angles::deg2rad(get("max_roll", params, 30.0));
@@ -82,6 +78,27 @@ bool SimpleAircraft::init(std::map<std::string, std::string> &info,
     max_pitch_rate_ = Angles::deg2rad(get("max_pitch_rate", params, 57.3));
     max_roll_rate_ = Angles::deg2rad(get("max_roll_rate", params, 57.3));
 
+    length_ = get("turning_radius", params, 50.0);
+    speedTarget_ = get("speed_target", params, 50.0);  // The "0" speed for adjusting the turning radius
+    lengthSlopePerSpeed_ = get("radius_slope_per_speed", params, 0.0);  // Enables adjusting the turning radius based on speed
+
+    init_instance();
+
+    throttle_idx_ = vars_.declare(VariableIO::Type::throttle, VariableIO::Direction::In);
+    roll_rate_idx_ = vars_.declare(VariableIO::Type::roll_rate, VariableIO::Direction::In);
+    pitch_rate_idx_ = vars_.declare(VariableIO::Type::pitch_rate, VariableIO::Direction::In);
+
+    return true;
+}
+
+std::shared_ptr<EntityPlugin> SimpleAircraft::clone() {
+    return std::make_shared<SimpleAircraft>(*this);
+}
+
+void SimpleAircraft::init_instance() {
+    x_.resize(MODEL_NUM_ITEMS);
+    Eigen::Vector3d &pos = state_->pos();
+    Quaternion &quat = state_->quat();
 
     x_[X] = pos(0);
     x_[Y] = pos(1);
@@ -91,19 +108,9 @@ bool SimpleAircraft::init(std::map<std::string, std::string> &info,
     x_[YAW] = quat.yaw();
     x_[SPEED] = clamp(state_->vel().norm(), min_velocity_, max_velocity_);
 
-    length_ = get("turning_radius", params, 50.0);
-    speedTarget_ = get("speed_target", params, 50.0);  // The "0" speed for adjusting the turning radius
-    lengthSlopePerSpeed_ = get("radius_slope_per_speed", params, 0.0);  // Enables adjusting the turning radius based on speed
-
     state_->pos() << x_[X], x_[Y], x_[Z];
     state_->quat().set(-x_[ROLL], x_[PITCH], x_[YAW]);
     state_->vel() << x_[SPEED] * cos(x_[5]), x_[SPEED] * sin(x_[5]), 0;
-
-    throttle_idx_ = vars_.declare(VariableIO::Type::throttle, VariableIO::Direction::In);
-    roll_rate_idx_ = vars_.declare(VariableIO::Type::roll_rate, VariableIO::Direction::In);
-    pitch_rate_idx_ = vars_.declare(VariableIO::Type::pitch_rate, VariableIO::Direction::In);
-
-    return true;
 }
 
 bool SimpleAircraft::step(double time, double dt) {
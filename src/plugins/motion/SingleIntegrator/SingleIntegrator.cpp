@@ -96,5 +96,46 @@ bool SingleIntegrator::step(double /*t*/, double dt) {
     return true;
 }
 
+bool SingleIntegrator::step_batch(const std::vector<MotionModel *> &models,
+                                  double /*t*/, double dt) {
+    // Gather the states into columns so that the propagation is vectorized
+    const Eigen::Index n = models.size();
+    Eigen::ArrayXXd pos(n, 3), vel(n, 3);
+    Eigen::ArrayXd max_speed(n);
+    for (Eigen::Index i = 0; i < n; i++) {
+        auto model = static_cast<SingleIntegrator *>(models[i]);
+        VariableIO &vars = model->vars_;
+        vel.row(i) << vars.input(model->vel_x_idx_),
+            vars.input(model->vel_y_idx_),
+            vars.input(model->vel_z_idx_);
+        pos.row(i) = model->state_->pos().transpose();
+        max_speed(i) = model->max_speed_;
+    }
+
+    // A negative max_speed applies the desired velocity directly
+    Eigen::ArrayXd norm = vel.square().rowwise().sum().sqrt();
+    vel.colwise() *= (max_speed < 0).select(1.0, max_speed / norm);
+    for (Eigen::Index i = 0; i < n; i++) {
+        if (vel.row(i).isNaN().any()) {
+            vel.row(i).setZero();
+        }
+    }
+
+    pos += vel * dt;
+
+    for (Eigen::Index i = 0; i < n; i++) {
+        auto model = static_cast<SingleIntegrator *>(models[i]);
+        Eigen::Vector3d v = vel.row(i).transpose();
+        model->state_->vel() = v;
+        model->state_->pos() = pos.row(i).transpose();
+
+        double yaw = model->override_heading_ ?
+            model->vars_.input(model->desired_heading_idx_) : atan2(v(1), v(0));
+        double pitch = atan2(v(2), v.head<2>().norm());
+        model->state_->quat().set(0, pitch, yaw);
+    }
+    return true;
+}
+
 } // namespace motion
 } // namespace scrimmage
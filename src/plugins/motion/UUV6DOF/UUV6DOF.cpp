@@ -60,6 +60,9 @@ UUV6DOF::UUV6DOF() {
     Eigen::AngleAxisd aa(M_PI, Eigen::Vector3d::UnitX());
     rot_180_x_axis_ = Eigen::Quaterniond(aa);
     x_.resize(MODEL_NUM_ITEMS);
+
+    // Semi-implicit Euler updates the body velocities and rates first
+    semi_implicit_indices_ = {U, V, W, P, Q, R};
 }
 
 bool UUV6DOF::init(std::map<std::string, std::string> &info,
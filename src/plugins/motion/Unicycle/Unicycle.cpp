@@ -91,6 +91,68 @@ bool Unicycle::init(std::map<std::string, std::string> &info,
 }
 
 bool Unicycle::step(double t, double dt) {
+    read_inputs();
+
+    Eigen::Vector3d prev_pos(x_[X], x_[Y], x_[Z]);
+
+    ode_step(dt);
+
+    update_state(prev_pos, dt);
+    return true;
+}
+
+bool Unicycle::step_batch(const std::vector<MotionModel *> &models,
+                          double /*t*/, double dt) {
+    // Gather the states and inputs into columns so that the integration is
+    // vectorized across the models
+    const Eigen::Index n = models.size();
+    Eigen::ArrayXXd x(n, MODEL_NUM_ITEMS);
+    Eigen::ArrayXd velocity(n), turn_rate(n), pitch_rate(n), velocity_z(n);
+    Eigen::Array<bool, Eigen::Dynamic, 1> use_pitch(n);
+    for (Eigen::Index i = 0; i < n; i++) {
+        auto model = static_cast<Unicycle *>(models[i]);
+        model->read_inputs();
+        for (int j = 0; j < MODEL_NUM_ITEMS; j++) {
+            x(i, j) = model->x_[j];
+        }
+        velocity(i) = model->velocity_;
+        turn_rate(i) = model->turn_rate_;
+        pitch_rate(i) = model->use_pitch_ ? model->pitch_rate_ : 0;
+        velocity_z(i) = model->velocity_z_;
+        use_pitch(i) = model->use_pitch_;
+    }
+
+    // Same equations as model()
+    auto deriv = [&](const Eigen::ArrayXXd &s, Eigen::ArrayXXd &dsdt) {
+        Eigen::ArrayXd xy_speed = velocity * s.col(PITCH).cos();
+        dsdt.col(X) = xy_speed * s.col(YAW).cos();
+        dsdt.col(Y) = xy_speed * s.col(YAW).sin();
+        dsdt.col(Z) = use_pitch.select(velocity * s.col(PITCH).sin(), velocity_z);
+        dsdt.col(YAW) = turn_rate;
+        dsdt.col(PITCH) = pitch_rate;
+    };
+
+    // Classic Runge-Kutta, as in ode_step()
+    Eigen::ArrayXXd k1(n, MODEL_NUM_ITEMS), k2(n, MODEL_NUM_ITEMS);
+    Eigen::ArrayXXd k3(n, MODEL_NUM_ITEMS), k4(n, MODEL_NUM_ITEMS);
+    deriv(x, k1);
+    deriv(x + dt / 2 * k1, k2);
+    deriv(x + dt / 2 * k2, k3);
+    deriv(x + dt * k3, k4);
+    x += dt / 6 * (k1 + 2 * k2 + 2 * k3 + k4);
+
+    for (Eigen::Index i = 0; i < n; i++) {
+        auto model = static_cast<Unicycle *>(models[i]);
+        Eigen::Vector3d prev_pos(model->x_[X], model->x_[Y], model->x_[Z]);
+        for (int j = 0; j < MODEL_NUM_ITEMS; j++) {
+            model->x_[j] = x(i, j);
+        }
+        model->update_state(prev_pos, dt);
+    }
+    return true;
+}
+
+void Unicycle::read_inputs() {
     // Get inputs and saturate
     velocity_ = clamp(vars_.input(speed_idx_), -vel_max_, vel_max_);
     turn_rate_ = clamp(vars_.input(turn_rate_idx_), -turn_rate_max_, turn_rate_max_);
@@ -99,16 +161,12 @@ bool Unicycle::step(double t, double dt) {
     } else {
         velocity_z_ = clamp(vars_.input(velocity_z_idx_), -velocity_z_max_, velocity_z_max_);
     }
+}
 
-    double prev_x = x_[X];
-    double prev_y = x_[Y];
-    double prev_z = x_[Z];
-
-    ode_step(dt);
-
-    double dx = (x_[X] - prev_x) / dt;
-    double dy = (x_[Y] - prev_y) / dt;
-    double dz = (x_[Z] - prev_z) / dt;
+void Unicycle::update_state(const Eigen::Vector3d &prev_pos, double dt) {
+    double dx = (x_[X] - prev_pos(0)) / dt;
+    double dy = (x_[Y] - prev_pos(1)) / dt;
+    double dz = (x_[Z] - prev_pos(2)) / dt;
 
     state_->vel()(0) = dx;
     state_->vel()(1) = dy;
@@ -125,8 +183,6 @@ bool Unicycle::step(double t, double dt) {
         roll = -atan2(pow(velocity_, 2) / radius, g_);
     }
     state_->quat().set(roll, -x_[PITCH], x_[YAW]);
-
-    return true;
 }
 
 void Unicycle::model(const vector_t &x , vector_t &dxdt , double t) {
@@ -69,6 +69,10 @@ bool GlobalNetwork::init(std::map<std::string, std::string> &mission_params,
     return true;
 }
 
+bool GlobalNetwork::step(sc::TopicTable &topics) {
+    return step_topics(topics);
+}
+
 bool GlobalNetwork::is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                                        const scrimmage::EntityPluginPtr &sub_plugin) {
     return true;
@@ -69,6 +69,10 @@ bool LocalNetwork::init(std::map<std::string, std::string> &mission_params,
     return true;
 }
 
+bool LocalNetwork::step(sc::TopicTable &topics) {
+    return step_topics(topics);
+}
+
 bool LocalNetwork::is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                                 const scrimmage::EntityPluginPtr &sub_plugin) {
     // Never reachable if plugin's entity was destroyed
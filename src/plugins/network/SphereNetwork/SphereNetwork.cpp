@@ -43,6 +43,7 @@
 #include <scrimmage/pubsub/Message.h>
 #include <scrimmage/parse/ParseUtils.h>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <boost/range/adaptor/map.hpp>
@@ -77,6 +78,10 @@ bool SphereNetwork::init(std::map<std::string, std::string> &mission_params,
     return true;
 }
 
+bool SphereNetwork::step(sc::TopicTable &topics) {
+    return step_topics(topics);
+}
+
 bool SphereNetwork::is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                                  const scrimmage::EntityPluginPtr &sub_plugin) {
     // Never reachable if plugin's entity was destroyed
@@ -84,29 +89,17 @@ bool SphereNetwork::is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
     // If the publisher and subscriber have the same parent, it is reachable
     if (pub_plugin->parent() == sub_plugin->parent()) return true;
 
-    // Is the publisher to subscriber already in the reachable map?
-    int pub_id = pub_plugin->parent()->id().id();
-    int sub_id = sub_plugin->parent()->id().id();
-
-    // Find the publisher in the mapping
-    auto it_pub = reachable_map_.find(pub_id);
-    if (it_pub != reachable_map_.end()) {
-        // See if the publisher has a reachability mapping for the subscriber
-        auto it_sub = it_pub->second.find(sub_id);
-        if (it_sub != it_pub->second.end()) {
-            return it_sub->second;
-        }
-    }
+    // The neighbors of the publisher are only searched for once per step
+    const std::vector<int> &ids = reachable_ids(pub_plugin->parent());
+    return std::binary_search(ids.begin(), ids.end(),
+                              sub_plugin->parent()->id().id());
+}
 
-    // No reachability mapping exists. Find all entity IDs that are reachable.
+void SphereNetwork::find_reachable(const sc::EntityPtr &pub_ent,
+                                   std::vector<int> &ids) {
     std::vector<sc::ID> neigh;
-    rtree_->neighbors_in_range(pub_plugin->parent()->state_truth()->pos(),
-                               neigh, range_);
+    rtree_->neighbors_in_range(pub_ent->state_truth()->pos(), neigh, range_);
 
-    // Add the entity IDs to the publisher's reachability set
-    // Look for the subscriber ID
-    reachable_map_[pub_id][sub_id] = false; // Default to not reachable
-    reachable_map_[sub_id][pub_id] = false; // Default to not reachable
     for (sc::ID id : neigh) {
         auto ent_neighbor = id_to_ent_map_->find(id.id());
         if (ent_neighbor == id_to_ent_map_->end()) {
@@ -114,17 +107,12 @@ bool SphereNetwork::is_reachable(const scrimmage::EntityPluginPtr &pub_plugin,
                 << id.id() << std::endl;
             continue;
         }
-        if (not filter_comms_plane_) {
-            reachable_map_[pub_id][id.id()] = true;
-            reachable_map_[id.id()][pub_id] = true;
-        } else if (within_planar_boundary(
-            pub_plugin->parent()->state_truth()->pos()[2],
-            ent_neighbor->second->state_truth()->pos()[2])) {
-            reachable_map_[pub_id][id.id()] = true;
-            reachable_map_[id.id()][pub_id] = true;
+        if (not filter_comms_plane_ || within_planar_boundary(
+                pub_ent->state_truth()->pos()[2],
+                ent_neighbor->second->state_truth()->pos()[2])) {
+            ids.push_back(id.id());
         }
     }
-    return reachable_map_[pub_id][sub_id];
 }
 
 bool SphereNetwork::is_successful_transmission(const scrimmage::EntityPluginPtr &pub_plugin,
@@ -71,6 +71,14 @@ void GPS::init(std::map<std::string, std::string> &params) {
        gps_found_ = str2container(params["gps_denied_ids"], ",", gps_denied_ids_);
     }
 
+    init_instance();
+}
+
+std::shared_ptr<EntityPlugin> GPS::clone() {
+    return std::make_shared<GPS>(*this);
+}
+
+void GPS::init_instance() {
     pub_ = advertise("GlobalNetwork", "GPSStatus");
 
     auto bd_cb = [&](auto &msg) {
@@ -31,8 +31,13 @@
  */
 
 #include <scrimmage/pubsub/MessageBase.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/entity/EntityPlugin.h>
+
 #include <cmath>
 
+#include <boost/type_index.hpp>
+
 #if ENABLE_PYTHON_BINDINGS == 1
 // namespace py = pybind11;
 #endif
@@ -52,5 +57,21 @@ namespace scrimmage {
 // }
 #endif
 
+std::string MessageBase::debug_info() const {
+    if (publisher_type == nullptr) {
+        return "";
+    }
+    std::string info = std::string("  publisher:  type (")
+        + boost::typeindex::type_index(*publisher_type).pretty_name() + ")";
+
+    auto plugin = publisher_plugin.lock();
+    if (plugin) {
+        info += ", plugin (" + plugin->name() + ")";
+        if (plugin->parent()) {
+            info += ", id (" + std::to_string(plugin->parent()->id().id()) + ")";
+        }
+    }
+    return info;
+}
 
 } // namespace scrimmage
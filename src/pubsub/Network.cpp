@@ -41,6 +41,7 @@
 #include <scrimmage/pubsub/Publisher.h>
 #include <scrimmage/pubsub/SubscriberBase.h>
 
+#include <algorithm>
 #include <memory>
 #include <iostream>
 
@@ -104,7 +105,79 @@ bool Network::network_init(std::map<std::string, std::string> &mission_params,
 
 bool Network::step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
                    std::map<std::string, std::list<NetworkDevicePtr>> &subs) {
+    TopicTable topics;
+    int topic_id = 0;
+    for (auto &kv : pubs) {
+        for (NetworkDevicePtr &pub : kv.second) {
+            topics.add_pub(topic_id, kv.first, pub);
+        }
+        auto it_subs = subs.find(kv.first);
+        if (it_subs != subs.end()) {
+            for (NetworkDevicePtr &sub : it_subs->second) {
+                topics.add_sub(topic_id, kv.first, sub);
+            }
+        }
+        ++topic_id;
+    }
+    // Subscribers without publishers still get their queue sizes enforced
+    for (auto &kv : subs) {
+        if (pubs.count(kv.first) == 0) {
+            for (NetworkDevicePtr &sub : kv.second) {
+                topics.add_sub(topic_id, kv.first, sub);
+            }
+            ++topic_id;
+        }
+    }
+
+    // The topic ids above are only valid for this call
+    count_ptrs_table_ = nullptr;
+    return step_topics(topics);
+}
+
+void Network::update_count_ptrs(TopicTable &topics) {
+    // Only rebuild when a topic was added to the table
+    if (&topics == count_ptrs_table_
+        && topics.topic_order().size() == count_ptrs_num_topics_) {
+        return;
+    }
+    count_ptrs_table_ = &topics;
+    count_ptrs_num_topics_ = topics.topic_order().size();
+
+    auto update = [&](std::map<std::string, unsigned int> &counts,
+                      std::vector<unsigned int *> &ptrs) {
+        ptrs.assign(topics.topics().size(), nullptr);
+        for (int id : topics.topic_order()) {
+            auto it = counts.find(topics.topics()[id].name);
+            if (it != counts.end()) {
+                ptrs[id] = &it->second;
+            }
+        }
+    };
+    update(pub_counts_, pub_count_ptrs_);
+    update(sub_counts_, sub_count_ptrs_);
+}
+
+bool Network::step(TopicTable &topics) {
+    std::map<std::string, std::list<NetworkDevicePtr>> pubs, subs;
+    for (int topic_id : topics.topic_order()) {
+        TopicTable::Topic &topic = topics.topics()[topic_id];
+        if (!topic.pubs.empty()) {
+            pubs[topic.name].assign(topic.pubs.begin(), topic.pubs.end());
+        }
+        if (!topic.subs.empty()) {
+            subs[topic.name].assign(topic.subs.begin(), topic.subs.end());
+        }
+    }
+    return step(pubs, subs);
+}
+
+bool Network::step_topics(TopicTable &topics) {
     reachable_map_.clear();
+    reachable_index_.clear();
+    num_reachable_rows_ = 0;
+    last_reachable_id_ = -1;
+
+    update_count_ptrs(topics);
 
     // Reset msg pub / sub counts
     for (auto &kv : pub_counts_) {
@@ -122,22 +195,18 @@ bool Network::step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
     // number of messages delivered (may be >1 if delivered with delay)
     int n_delivered = 0;
 
-    // For all publisher topic names
-    for (auto &pub_kv : pubs) {
-        std::string topic = pub_kv.first;
-
-        // Get reference to this specific topic in the pub_counts_ map for
-        // faster access later
-        auto it_pub_topic = pub_counts_.find(topic);
-        bool valid_pub_topic = (it_pub_topic != pub_counts_.end());
+    // For all topics, in topic name order
+    for (int topic_id : topics.topic_order()) {
+        TopicTable::Topic &topic = topics.topics()[topic_id];
+        if (topic.pubs.empty()) {
+            continue;
+        }
 
-        // Get reference to this specific topic in the sub_counts_ map for
-        // faster access later
-        auto it_sub_topic = sub_counts_.find(topic);
-        bool valid_sub_topic = (it_sub_topic != sub_counts_.end());
+        unsigned int *pub_count = pub_count_ptrs_[topic_id];
+        unsigned int *sub_count = sub_count_ptrs_[topic_id];
 
         // For all publisher devices with topic name
-        for (NetworkDevicePtr &pub : pub_kv.second) {
+        for (NetworkDevicePtr &pub : topic.pubs) {
             pub->enforce_queue_size();
 
             auto msgs = pub->pop_msgs<MessageBase>();
@@ -150,13 +219,13 @@ bool Network::step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
                 it_all_pub->second += msgs.size();
             }
 
-            if (valid_pub_topic) {
+            if (pub_count) {
                 // Accumulate published message counts on specific topic
-                it_pub_topic->second += msgs.size();
+                *pub_count += msgs.size();
             }
 
             // For all subscribers on this topic
-            for (NetworkDevicePtr &sub : subs[topic]) {
+            for (NetworkDevicePtr &sub : topic.subs) {
 
                 if (sub->undelivered_msg_list_size() > 0) {
                     // deliver undelivered messages if delay time has passed
@@ -165,9 +234,9 @@ bool Network::step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
                         // Accumulate received msg counts on all topics
                         it_all_sub->second += n_delivered;
                     }
-                    if (valid_sub_topic) {
+                    if (sub_count) {
                         // Accumulate received msg counts on specific topic
-                        it_sub_topic->second += n_delivered;
+                        *sub_count += n_delivered;
                     }
                 }
 
@@ -188,9 +257,9 @@ bool Network::step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
                                     it_all_sub->second += 1;
                                 }
 
-                                if (valid_sub_topic) {
+                                if (sub_count) {
                                     // Accumulate received message counts on specific topic
-                                    it_sub_topic->second += 1;
+                                    *sub_count += 1;
                                 }
                             } else {
                                 // put msg in subs undelivered msg queue
@@ -205,9 +274,9 @@ bool Network::step(std::map<std::string, std::list<NetworkDevicePtr>> &pubs,
     }
 
     // Enforce queue sizes, if necessary
-    for (auto &sub_kv : subs) {
-        // For all publisher devices with topic name
-        for (NetworkDevicePtr &sub : sub_kv.second) {
+    for (TopicTable::Topic &topic : topics.topics()) {
+        // For all subscriber devices with topic name
+        for (NetworkDevicePtr &sub : topic.subs) {
             sub->enforce_queue_size();
         }
     }
@@ -242,6 +311,32 @@ bool Network::is_successful_transmission(const scrimmage::EntityPluginPtr &pub_p
     return false;
 }
 
+const std::vector<int> &Network::reachable_ids(const EntityPtr &pub_ent) {
+    int pub_id = pub_ent->id().id();
+    // step() visits every subscriber of one publisher in a row
+    if (pub_id == last_reachable_id_) {
+        return reachable_rows_[last_reachable_row_];
+    }
+
+    auto it = reachable_index_.find(pub_id);
+    if (it == reachable_index_.end()) {
+        if (num_reachable_rows_ == reachable_rows_.size()) {
+            reachable_rows_.emplace_back();
+        }
+        std::vector<int> &ids = reachable_rows_[num_reachable_rows_];
+        ids.clear();
+        find_reachable(pub_ent, ids);
+        std::sort(ids.begin(), ids.end());
+        it = reachable_index_.emplace(pub_id, num_reachable_rows_++).first;
+    }
+
+    last_reachable_id_ = pub_id;
+    last_reachable_row_ = it->second;
+    return reachable_rows_[it->second];
+}
+
+void Network::find_reachable(const EntityPtr &/*pub_ent*/, std::vector<int> &/*ids*/) {}
+
 double Network::get_transmission_delay() {
     return comm_delay_;
 }
@@ -63,8 +63,21 @@ void NetworkDevice::set_topic(const std::string &topic) {topic_ = topic;}
 
 void NetworkDevice::set_msg_list(const std::list<MessageBasePtr> &msg_list) {
     mutex_.lock();
-    msg_list_ = msg_list;
+    msg_list_.clear();
+    for (const MessageBasePtr &msg : msg_list) {
+        msg_list_.push_back(msg);
+    }
+    mutex_.unlock();
+}
+
+std::list<MessageBasePtr> NetworkDevice::get_msg_list() {
+    std::list<MessageBasePtr> msg_list;
+    mutex_.lock();
+    for (std::size_t i = 0; i < msg_list_.size(); i++) {
+        msg_list.push_back(msg_list_[i]);
+    }
     mutex_.unlock();
+    return msg_list;
 }
 
 void NetworkDevice::set_max_queue_size(const unsigned int& size) {
@@ -87,14 +100,14 @@ void NetworkDevice::enforce_queue_size() {
     if (enable_queue_size_) {
         if (msg_list_.size() > max_queue_size_) {
             mutex_.lock();
-            auto erase_end = msg_list_.begin();
-            std::advance(erase_end, msg_list_.size() - max_queue_size_);
-            msg_list_.erase(msg_list_.begin(), erase_end);
+            msg_list_.drop_front(msg_list_.size() - max_queue_size_);
 
             // enforce size constraint on undelivered messages
-            erase_end = undelivered_msg_list_.begin();
-            std::advance(erase_end, undelivered_msg_list_.size() - max_queue_size_);
-            undelivered_msg_list_.erase(undelivered_msg_list_.begin(), erase_end);
+            if (undelivered_msg_list_.size() > max_queue_size_) {
+                auto erase_end = undelivered_msg_list_.begin();
+                std::advance(erase_end, undelivered_msg_list_.size() - max_queue_size_);
+                undelivered_msg_list_.erase(undelivered_msg_list_.begin(), erase_end);
+            }
 
             mutex_.unlock();
         }
@@ -49,6 +49,24 @@ PubSub::PubSub() {
 void PubSub::add_network_name(const std::string &network_name) {
     pub_map_[network_name] = std::map<std::string, std::list<NetworkDevicePtr>>();
     sub_map_[network_name] = std::map<std::string, std::list<NetworkDevicePtr>>();
+    topic_tables_[network_name] = TopicTable();
+}
+
+void PubSub::clear() {
+    pub_map_.clear();
+    sub_map_.clear();
+    topic_tables_.clear();
+    topic_ids_.clear();
+}
+
+int PubSub::topic_id(const std::string &topic) {
+    auto it = topic_ids_.find(topic);
+    if (it != topic_ids_.end()) {
+        return it->second;
+    }
+    int id = topic_ids_.size();
+    topic_ids_[topic] = id;
+    return id;
 }
 
 PublisherPtr PubSub::advertise(const std::string &network_name,
@@ -65,9 +83,37 @@ PublisherPtr PubSub::advertise(const std::string &network_name,
     PublisherPtr pub = std::make_shared<Publisher>(topic, max_queue_size,
                                                    enable_queue_size, plugin);
     pub_map_[network_name][topic].push_back(pub);
+    topic_tables_[network_name].add_pub(topic_id(topic), topic, pub);
     return pub;
 }
 
+void PubSub::snapshot(Snapshot &snap) {
+    snap.pubs = pub_map_;
+    snap.subs = sub_map_;
+    snap.topic_tables = topic_tables_;
+    snap.queues.clear();
+    for (TopicMap *devs : {&pub_map_, &sub_map_}) {
+        for (auto &kv_network : *devs) {
+            for (auto &kv_topic : kv_network.second) {
+                for (NetworkDevicePtr &dev : kv_topic.second) {
+                    snap.queues[dev] = std::make_pair(dev->get_msg_list(),
+                                                      dev->undelivered_msg_list());
+                }
+            }
+        }
+    }
+}
+
+void PubSub::restore(const Snapshot &snap) {
+    pub_map_ = snap.pubs;
+    sub_map_ = snap.subs;
+    topic_tables_ = snap.topic_tables;
+    for (auto &kv : snap.queues) {
+        kv.first->set_msg_list(kv.second.first);
+        kv.first->undelivered_msg_list() = kv.second.second;
+    }
+}
+
 boost::optional<std::list<NetworkDevicePtr>> PubSub::find_devices(
     const std::string &network_name, const std::string &topic_name, TopicMap &devs) {
 
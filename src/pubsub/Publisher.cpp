@@ -43,10 +43,10 @@ Publisher::Publisher(const std::string &topic, const unsigned int& max_queue_siz
                      const bool& enable_queue_size, EntityPluginPtr plugin) :
     NetworkDevice(topic, max_queue_size, enable_queue_size, plugin) {}
 
-void Publisher::set_debug_info(MessageBasePtr msg, const std::string &type) {
-      msg->debug_info = std::string("  publisher:  ")
-        + "type (" + type
-        + "), plugin (" + plugin_->name() + ")"
-        + "), id (" + std::to_string(plugin_->parent()->id().id()) + ")";
+void Publisher::set_debug_info(const MessageBasePtr &msg, const std::type_info &type) {
+    // Only record where the message came from. The string itself is built
+    // by MessageBase::debug_info() if a subscriber ever needs to print it.
+    msg->publisher_type = &type;
+    msg->publisher_plugin = plugin_;
 }
 } // namespace scrimmage
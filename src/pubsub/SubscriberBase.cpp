@@ -45,8 +45,9 @@ void SubscriberBase::print_err(const std::string &type, MessageBasePtr msg) cons
         << "), plugin (" << plugin_->name()
         << "), id (" << plugin_->parent()->id().id() << ")"
         << std::endl;
-    if (msg->debug_info != "") {
-        std::cout << msg->debug_info << std::endl;
+    std::string debug_info = msg->debug_info();
+    if (debug_info != "") {
+        std::cout << debug_info << std::endl;
     }
 }
 } // namespace scrimmage
@@ -0,0 +1,420 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/common/TaskExecutor.h>
+#include <scrimmage/metrics/Metrics.h>
+#include <scrimmage/parse/MissionImage.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/parse/ParseUtils.h>
+#include <scrimmage/plugin_manager/PluginManager.h>
+#include <scrimmage/simcontrol/BatchRunner.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+#include <rapidxml/rapidxml.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
+namespace fs = boost::filesystem;
+namespace rx = rapidxml;
+
+using std::cout;
+using std::endl;
+
+namespace scrimmage {
+
+BatchRunner::BatchRunner() :
+    plugin_manager_(std::make_shared<PluginManager>()) {}
+
+bool BatchRunner::init(const std::string &mission_file) {
+    if (!MissionParse::read_mission_file(mission_file, mission_filename_,
+                                         mission_content_)) {
+        return false;
+    }
+
+    // Load a compiled mission once for all of the runs
+    if (MissionImage::is_image(mission_content_)) {
+        auto image = std::make_shared<MissionImage>();
+        if (!image->load(mission_content_)) {
+            return false;
+        }
+        mission_image_ = image;
+    }
+    return true;
+}
+
+bool BatchRunner::parse_ranges(const std::string &ranges_file) {
+    std::ifstream file(expand_user(ranges_file));
+    if (!file.is_open()) {
+        cout << "Failed to open ranges file: " << ranges_file << endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    file.close();
+    std::string content(buffer.str());
+
+    rx::xml_document<> doc;
+    try {
+        doc.parse<0>(&content[0]);
+    } catch (...) {
+        cout << "Failed to parse ranges file: " << ranges_file << endl;
+        return false;
+    }
+
+    rx::xml_node<> *root = doc.first_node();
+    if (root == 0) {
+        cout << "Ranges file is empty: " << ranges_file << endl;
+        return false;
+    }
+
+    ranges_.clear();
+    for (rx::xml_node<> *node = root->first_node(); node != 0;
+         node = node->next_sibling()) {
+        ParameterRange range;
+        range.name = node->name();
+
+        std::map<std::string, std::string> attrs;
+        for (rx::xml_attribute<> *attr = node->first_attribute(); attr != 0;
+             attr = attr->next_attribute()) {
+            attrs[attr->name()] = attr->value();
+        }
+
+        if (attrs.count("vec") > 0) {
+            split(range.vec, remove_whitespace(attrs["vec"]), ",");
+        } else if (attrs.count("low") == 0 || attrs.count("high") == 0) {
+            cout << "missing low or high in element " << range.name << endl;
+            return false;
+        }
+        range.type = get<std::string>("type", attrs, "float");
+        range.low = get("low", attrs, 0.0);
+        range.high = get("high", attrs, 0.0);
+        range.count = get("count", attrs, 0);
+
+        if (range.vec.empty() && range.type != "int" &&
+            range.type != "float" && range.type != "double") {
+            cout << "Unknown type, " << range.type << ", in element "
+                 << range.name << endl;
+            return false;
+        }
+        ranges_.push_back(range);
+    }
+    return true;
+}
+
+void BatchRunner::set_ranges(const std::vector<ParameterRange> &ranges) {
+    ranges_ = ranges;
+}
+
+void BatchRunner::set_method(const std::string &method) {method_ = method;}
+
+void BatchRunner::set_num_runs(int num_runs) {num_runs_ = num_runs;}
+
+void BatchRunner::set_num_repeats(int num_repeats) {num_repeats_ = num_repeats;}
+
+void BatchRunner::set_num_threads(int num_threads) {num_threads_ = num_threads;}
+
+void BatchRunner::set_seed(uint32_t seed) {
+    seed_ = seed;
+    seed_set_ = true;
+}
+
+void BatchRunner::set_overrides(const std::string &overrides) {
+    overrides_ = overrides;
+}
+
+void BatchRunner::set_job_number(int job_number) {job_number_ = job_number;}
+
+void BatchRunner::set_summary_file(const std::string &summary_file) {
+    summary_file_ = summary_file;
+}
+
+std::vector<std::map<std::string, std::string>> &BatchRunner::runs() {
+    return runs_;
+}
+
+std::string BatchRunner::format(const ParameterRange &range, double value) {
+    if (range.type == "int") {
+        // truncate like numpy's astype(int)
+        return std::to_string(static_cast<int>(value));
+    }
+    std::stringstream ss;
+    ss << std::setprecision(12) << value;
+    return ss.str();
+}
+
+bool BatchRunner::generate_runs() {
+    if (seed_set_) {
+        random_.seed(seed_);
+    } else {
+        random_.seed();
+        seed_ = random_.get_seed();
+    }
+
+    std::vector<std::map<std::string, std::string>> samples;
+    if (ranges_.empty()) {
+        samples.resize(std::max(num_runs_, 0));
+    } else if (method_ == "lhs") {
+        // Latin hypercube: each parameter's range is split into num_runs
+        // intervals and every interval is sampled exactly once.
+        const int n = std::max(num_runs_, 0);
+        samples.resize(n);
+        std::vector<int> perm(n);
+        for (const ParameterRange &range : ranges_) {
+            std::iota(perm.begin(), perm.end(), 0);
+            std::shuffle(perm.begin(), perm.end(), *random_.gener());
+            for (int i = 0; i < n; i++) {
+                double u = (perm[i] + random_.rng_uniform(0, 1)) / n;
+                if (range.vec.empty()) {
+                    samples[i][range.name] =
+                        format(range, range.low + u * (range.high - range.low));
+                } else {
+                    size_t idx = std::min(static_cast<size_t>(u * range.vec.size()),
+                                          range.vec.size() - 1);
+                    samples[i][range.name] = range.vec[idx];
+                }
+            }
+        }
+    } else if (method_ == "grid") {
+        // Every combination of the parameter values, with the last parameter
+        // changing fastest
+        std::vector<std::vector<std::string>> values;
+        for (const ParameterRange &range : ranges_) {
+            if (!range.vec.empty()) {
+                values.push_back(range.vec);
+                continue;
+            }
+            if (range.count <= 0) {
+                cout << "Param '" << range.name
+                     << "' needs count specified for grid method" << endl;
+                return false;
+            }
+            std::vector<std::string> vals;
+            for (int i = 0; i < range.count; i++) {
+                double frac = range.count == 1 ? 0.0 :
+                    static_cast<double>(i) / (range.count - 1);
+                vals.push_back(format(range, range.low + frac * (range.high - range.low)));
+            }
+            values.push_back(vals);
+        }
+
+        std::vector<size_t> idx(values.size(), 0);
+        bool done = false;
+        while (!done) {
+            std::map<std::string, std::string> sample;
+            for (size_t i = 0; i < values.size(); i++) {
+                sample[ranges_[i].name] = values[i][idx[i]];
+            }
+            samples.push_back(sample);
+
+            done = true;
+            for (int i = static_cast<int>(values.size()) - 1; i >= 0; i--) {
+                if (++idx[i] < values[i].size()) {
+                    done = false;
+                    break;
+                }
+                idx[i] = 0;
+            }
+        }
+    } else {
+        cout << "Unknown batch method: " << method_ << endl;
+        return false;
+    }
+
+    // Allow multiple repetitions at each combination of parameters
+    runs_.clear();
+    for (auto &sample : samples) {
+        for (int i = 0; i < num_repeats_; i++) {
+            runs_.push_back(sample);
+        }
+    }
+    return true;
+}
+
+bool BatchRunner::run() {
+    if (mission_content_.empty()) {
+        cout << "BatchRunner::init() must be called before run()" << endl;
+        return false;
+    }
+    if (runs_.empty() && !generate_runs()) {
+        return false;
+    }
+
+    std::atomic<int> num_failed{0};
+    TaskExecutor executor(std::max(num_threads_, 1));
+    executor.parallel_for(runs_.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (!exit_ && !run_one(i)) num_failed++;
+        }
+    }, 1);
+
+    if (summary_.is_open()) {
+        summary_.close();
+        cout << "Batch summary: " << summary_file_ << endl;
+    }
+    if (num_failed > 0) {
+        cout << num_failed << " of " << runs_.size() << " runs failed" << endl;
+    }
+    return num_failed == 0 && !exit_;
+}
+
+bool BatchRunner::run_one(size_t index) {
+    SimControl simcontrol;
+    simcontrol.plugin_manager() = plugin_manager_;
+
+    MissionParsePtr mp = simcontrol.mp();
+    if (mission_image_) {
+        mp->set_mission_image(mission_filename_, mission_image_);
+    } else {
+        mp->set_mission_content(mission_filename_, mission_content_);
+    }
+    mp->set_task_number(index + 1);
+    if (job_number_ != -1) mp->set_job_number(job_number_);
+    mp->set_overrides(overrides_);
+    for (auto &kv : runs_[index]) {
+        mp->set_overrides(kv.first + "=" + kv.second);
+    }
+
+    // Python plugins can only be run from a single thread
+    if (!simcontrol.init(mission_filename_, num_threads_ <= 1)) {
+        cout << "Failed to initialize run " << index + 1 << endl;
+        return false;
+    }
+
+    mp->set_time_warp(0);
+    simcontrol.pause(false);
+    mp->params()["seed"] = std::to_string(seed_ + index);
+    mp->params()["display_progress"] = "false";
+    // the runs would race to update the "latest" symlink
+    mp->params()["create_latest_dir"] = "false";
+
+    {
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        if (!exit_) active_.push_back(&simcontrol);
+    }
+    if (exit_) {
+        simcontrol.shutdown(false);
+        return false;
+    }
+
+    bool status = simcontrol.run();
+
+    {
+        std::lock_guard<std::mutex> lock(active_mutex_);
+        active_.remove(&simcontrol);
+    }
+
+    if (!mp->output_type_required("summary")) {
+        // finalize() only calculates the team scores for summary.csv
+        for (MetricsPtr &metrics : simcontrol.metrics()) {
+            if (metrics->get_print_team_summary()) metrics->calc_team_scores();
+        }
+    }
+    write_summary(index, status, simcontrol);
+
+    return simcontrol.shutdown(false) && status;
+}
+
+void BatchRunner::write_summary(size_t index, bool status,
+                                SimControl &simcontrol) {
+    std::map<int, double> team_scores;
+    std::map<int, std::map<std::string, double>> team_metrics;
+    std::list<std::string> headers;
+    if (status) {
+        simcontrol.team_summary(team_scores, team_metrics, headers);
+    }
+
+    std::lock_guard<std::mutex> lock(summary_mutex_);
+    if (!summary_.is_open()) {
+        if (summary_file_ == "") {
+            summary_file_ = simcontrol.mp()->root_log_dir() + "/batch_summary.csv";
+        }
+        fs::path parent = fs::path(summary_file_).parent_path();
+        boost::system::error_code ec;
+        if (!parent.empty()) fs::create_directories(parent, ec);
+
+        summary_.open(summary_file_);
+        if (!summary_.is_open()) {
+            cout << "could not open " << summary_file_
+                 << " for writing the batch summary" << endl;
+            return;
+        }
+
+        // The first run to finish decides the metrics columns
+        summary_headers_ = headers;
+        summary_ << "run,seed";
+        for (const ParameterRange &range : ranges_) {
+            summary_ << "," << range.name;
+        }
+        summary_ << ",status,log_dir,team_id,score";
+        for (const std::string &header : summary_headers_) {
+            summary_ << "," << header;
+        }
+        summary_ << "\n";
+    }
+
+    std::stringstream prefix;
+    prefix << index + 1 << "," << seed_ + index;
+    for (const ParameterRange &range : ranges_) {
+        prefix << "," << runs_[index][range.name];
+    }
+    prefix << "," << (status ? "ok" : "failed") << ","
+           << simcontrol.mp()->log_dir();
+
+    if (team_metrics.empty()) {
+        summary_ << prefix.str() << ",," << "\n";
+    }
+    for (auto const &kv : team_metrics) {
+        summary_ << prefix.str() << "," << kv.first << ","
+                 << team_scores[kv.first];
+        for (const std::string &header : summary_headers_) {
+            auto it = kv.second.find(header);
+            summary_ << "," << (it != kv.second.end() ? it->second : 0.0);
+        }
+        summary_ << "\n";
+    }
+    summary_ << std::flush;
+}
+
+void BatchRunner::force_exit() {
+    exit_ = true;
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    for (SimControl *simcontrol : active_) {
+        simcontrol->force_exit();
+    }
+}
+} // namespace scrimmage
@@ -42,9 +42,11 @@
 #include <scrimmage/common/Time.h>
 #include <scrimmage/entity/Contact.h>
 #include <scrimmage/common/RTree.h>
+#include <scrimmage/common/SpatialHash.h>
 #include <scrimmage/common/ParameterServer.h>
 #include <scrimmage/common/GlobalService.h>
 #include <scrimmage/entity/Entity.h>
+#include <scrimmage/entity/ContactSnapshot.h>
 #include <scrimmage/motion/MotionModel.h>
 #include <scrimmage/motion/Controller.h>
 #include <scrimmage/simcontrol/SimControl.h>
@@ -69,11 +71,14 @@
 
 #include <scrimmage/msgs/Event.pb.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <memory>
 #include <chrono> // NOLINT
-#include <future> // NOLINT
+#include <atomic>
+#include <typeindex>
+#include <typeinfo>
 
 #if ENABLE_PYTHON_BINDINGS == 1
 #include <pybind11/pybind11.h>
@@ -91,6 +96,7 @@ _Pragma("clang diagnostic pop")
 #include <GeographicLib/LocalCartesian.hpp>
 
 #include <boost/thread.hpp>
+#include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/for_each.hpp>
@@ -108,6 +114,43 @@ using NormDistribution = std::normal_distribution<double>;
 
 namespace scrimmage {
 
+struct SimControl::Snapshot {
+    struct PluginState {
+        EntityPluginPtr plugin;
+        boost::any state;
+        double loop_timer;
+        Eigen::VectorXd output;
+    };
+
+    struct EntityState {
+        EntityPtr ent;
+        State state;
+        State state_truth;
+        MotionModel::vector_t motion_x;
+        std::vector<State> desired_states;
+        scrimmage_proto::ContactVisual visual;
+        int health_points;
+        bool active;
+    };
+
+    double t;
+    Random random;
+    std::map<int, GenerateInfo> gen_info;
+    std::map<int, std::vector<double>> next_gen_times;
+    std::set<int> ids_used;
+    std::unordered_map<int, int> id_to_team_map;
+    std::unordered_map<int, EntityPtr> id_to_ent_map;
+    ContactMap contacts;
+    std::map<int, ContactVisualPtr> contact_visuals;
+    std::list<EntityPtr> ents;
+    std::list<EntityPtr> not_ready;
+    std::vector<EntityState> ent_states;
+    std::vector<PluginState> plugin_states;
+    PubSub::Snapshot pubsub;
+    DelayedTask reseed_task;
+    DelayedTask screenshot_task;
+};
+
 SimControl::SimControl() :
     id_to_team_map_(std::make_shared<std::unordered_map<int, int>>()),
     id_to_ent_map_(std::make_shared<std::unordered_map<int, EntityPtr>>()),
@@ -133,6 +176,7 @@ SimControl::SimControl() :
 
     contacts_mutex_.lock();
     contacts_ = std::make_shared<ContactMap>();
+    contact_snapshot_ = std::make_shared<ContactSnapshot>();
     contacts_mutex_.unlock();
 }
 
@@ -150,6 +194,22 @@ bool SimControl::setup_logging() {
     if (mp_->output_required()) {
         mp_->create_log_dir();
         log_->set_enable_log(true);
+
+        const bool async_log = get("async_log", mp_->params(), false);
+        const int queue_size = get("async_log_queue_size", mp_->params(), 128);
+        const std::string policy = get<std::string>("async_log_policy", mp_->params(), "block");
+        if (policy != "block" && policy != "drop") {
+            cout << "Unknown async_log_policy: " << policy
+                 << ", using block" << endl;
+        }
+        log_->set_async(async_log, std::max(queue_size, 1), policy == "drop");
+
+        const std::string log_format = get<std::string>("log_format", mp_->params(), "stream");
+        if (log_format != "stream" && log_format != "chunked") {
+            cout << "Unknown log_format: " << log_format << ", using stream" << endl;
+        }
+        const int chunk_size = get("log_chunk_size", mp_->params(), 100);
+        log_->set_chunked(log_format == "chunked", std::max(chunk_size, 1));
         log_->init(mp_->log_dir(), Log::WRITE);
     } else {
         log_->set_enable_log(false);
@@ -168,14 +228,14 @@ bool SimControl::init(const std::string& mission_file,
 #endif
 
     ents_.clear();
+    prototypes_.clear();
     ent_inters_.clear();
     metrics_.clear();
     contacts_->clear();
     shapes_.clear();
     contact_visuals_.clear();
     networks_->clear();
-    pubsub_->pubs().clear();
-    pubsub_->subs().clear();
+    pubsub_->clear();
 
     if (!mp_->parse(mission_file)) {
         cout << "Failed to parse file: " << mission_file << endl;
@@ -257,9 +317,12 @@ bool SimControl::generate_entities(const double& t) {
     // Delete gen_info's that don't have ents remaining (count==0)
     remove_if(mp_->gen_info(), [&](auto &kv) {return kv.second.total_count <= 0;});
 
-    // Create a new rtree from the existing entity map and provide additional
-    // space in the rtree for the new entities that will be generated.
-    create_rtree(ents_to_gen.size());
+    // Update the rtree with the existing entities' positions. The new
+    // entities are added to the rtree as they are generated.
+    create_rtree();
+    if (!ents_to_gen.empty()) {
+        reset_spawn_placer();
+    }
 
     // Call generate_entity on each entity description id.
     auto gen_ent = [&] (const int &ent_desc_id) -> bool {
@@ -276,11 +339,12 @@ bool SimControl::generate_entity(const int &ent_desc_id) {
     if (it_params == mp_->entity_descriptions().end()) {
         return false;
     }
-    return generate_entity(ent_desc_id, it_params->second);
+    return generate_entity(ent_desc_id, it_params->second, true);
 }
 
 bool SimControl::generate_entity(const int &ent_desc_id,
-                                 std::map<std::string, std::string> &params) {
+                                 std::map<std::string, std::string> &params,
+                                 bool use_prototype) {
 #if ENABLE_JSBSIM == 1
     params["JSBSIM_ROOT"] = jsbsim_root_;
 #endif
@@ -292,12 +356,12 @@ bool SimControl::generate_entity(const int &ent_desc_id,
     double z0 = scrimmage::get("z0", params, 0.0);
     double heading = scrimmage::get("heading", params, 0.0);
 
-    Eigen::Vector3d pos(x0, y0, z0);
+    Eigen::Vector3d mean(x0, y0, z0);
+    Eigen::Vector3d stddev(pow(get("variance_x", params, 100.0), 0.5),
+                           pow(get("variance_y", params, 100.0), 0.5),
+                           pow(get("variance_z", params, 0.0), 0.5));
 
     auto gener = random_->gener();
-    NormDistribution x_normal_dist(x0, pow(get("variance_x", params, 100.0), 0.5));
-    NormDistribution y_normal_dist(y0, pow(get("variance_y", params, 100.0), 0.5));
-    NormDistribution z_normal_dist(z0, pow(get("variance_z", params, 0.0), 0.5));
     NormDistribution heading_normal_dist(heading, pow(get("variance_heading", params, 0.0), 0.5));
     params["heading"] = std::to_string(heading_normal_dist(*gener));
 
@@ -306,28 +370,28 @@ bool SimControl::generate_entity(const int &ent_desc_id,
     // Use variance if a collision exists (This happens when you place <entity>
     // tags" at the same location). Or, if use_variance_all_ents is specified
     // as true in the entity block.
-    if (collision_exists(pos) || use_variance_all_ents) {
-        // Use the uniform distribution to place aircraft
-        // within the x/y variance
-        int ct = 0;
-        const int max_ct = 1e6;
-        bool reselect_pos = collision_exists(pos) || use_variance_all_ents;
-        while (ct++ < max_ct && !exit_ && reselect_pos) {
-            pos(0) = x_normal_dist(*gener);
-            pos(1) = y_normal_dist(*gener);
-            pos(2) = z_normal_dist(*gener);
-            reselect_pos = collision_exists(pos);
-        }
-
-        if (ct >= max_ct) {
+    auto collision = [&](const Eigen::Vector3d &p) {
+        Eigen::Vector3d p_copy = p;
+        return collision_exists(p_copy);
+    };
+    // Stop searching if we were told to exit
+    bool exited = false;
+    auto cancel = [&]() {
+        exit_mutex_.lock();
+        exited = exit_;
+        exit_mutex_.unlock();
+        return exited;
+    };
+    Eigen::Vector3d pos;
+    if (!spawn_placer_.place(ent_desc_id, mean, stddev, use_variance_all_ents,
+                             *gener, collision, cancel, pos)) {
+        if (!exited) {
             cout << "----------------------------------" << endl;
             cout << "ERROR: Having difficulty finding collision-free location for entity at: "
                  << "(" << x0 << "," << y0 << "," << z0 << ")" << endl
                  << "With variance: (" << pos(0) << "," << pos(1) << "," << pos(2) << ")" << endl;
-            return false;
-        } else if (exit_) {
-            return false;
         }
+        return false;
     }
 
     params["x"] = std::to_string(pos(0));
@@ -349,13 +413,29 @@ bool SimControl::generate_entity(const int &ent_desc_id,
 
     int id = find_available_id(params);
 
-    bool ent_status = ent->init(attr_map, params, id_to_team_map_,
-                                id_to_ent_map_,
-                                contacts_, mp_, proj_, id, ent_desc_id,
-                                plugin_manager_, file_search_, rtree_, pubsub_, time_,
-                                param_server_, global_services_,
-                                std::set<std::string>{},
-                                [](std::map<std::string, std::string>&){});
+    ent->contact_snapshot() = contact_snapshot_;
+
+    // The first entity of an entity block is initialized from the mission
+    // parameters and becomes the block's prototype. The other entities of
+    // the block copy the prototype's plugins.
+    use_prototype = use_prototype && clone_entities_;
+    auto it_prototype = prototypes_.find(ent_desc_id);
+    bool ent_status;
+    if (use_prototype && it_prototype != prototypes_.end() &&
+        it_prototype->second != nullptr) {
+        ent_status = ent->init_from_prototype(it_prototype->second, params, id);
+    } else {
+        ent_status = ent->init(attr_map, params, id_to_team_map_,
+                               id_to_ent_map_,
+                               contacts_, mp_, proj_, id, ent_desc_id,
+                               plugin_manager_, file_search_, rtree_, pubsub_, time_,
+                               param_server_, global_services_,
+                               std::set<std::string>{},
+                               [](std::map<std::string, std::string>&){});
+        if (ent_status && use_prototype && it_prototype == prototypes_.end()) {
+            prototypes_[ent_desc_id] = ent->make_prototype();
+        }
+    }
     contacts_mutex_.unlock();
 
     if (!ent_status) {
@@ -380,6 +460,7 @@ bool SimControl::generate_entity(const int &ent_desc_id,
 
     ents_.push_back(ent);
     rtree_->add(ent->state()->pos(), ent->id());
+    spawn_placer_.add(ent->state()->pos(), ent->id());
     contacts_mutex_.lock();
     (*contacts_)[ent->id().id()] =
             Contact(ent->id(), ent->radius(), ent->state_truth(),
@@ -407,11 +488,28 @@ void SimControl::join() {
     thread_.join();
 }
 
-void SimControl::create_rtree(const unsigned int& additional_size) {
-    rtree_->init(ents_.size() + additional_size);
-    for (EntityPtr &ent: ents_) {
-        rtree_->add(ent->state()->pos(), ent->id());
+void SimControl::create_rtree() {
+    std::vector<std::pair<Eigen::Vector3d, ID>> entries;
+    entries.reserve(ents_.size());
+    for (EntityPtr &ent : ents_) {
+        entries.emplace_back(ent->state()->pos(), ent->id());
+    }
+    rtree_->update(entries);
+}
+
+void SimControl::reset_spawn_placer() {
+    std::vector<std::pair<Eigen::Vector3d, ID>> entries;
+    entries.reserve(ents_.size());
+    for (EntityPtr &ent : ents_) {
+        entries.emplace_back(ent->state()->pos(), ent->id());
     }
+    spawn_placer_.reset(entries);
+}
+
+void SimControl::update_contact_snapshot() {
+    contacts_mutex_.lock();
+    contact_snapshot_->update(*contacts_);
+    contacts_mutex_.unlock();
 }
 
 void SimControl::set_autonomy_contacts() {
@@ -439,8 +537,7 @@ void SimControl::set_autonomy_contacts() {
 bool SimControl::run_networks() {
     bool all_true = true;
     for (auto &kv : *networks_) {
-        bool result = kv.second->step(pubsub_->pubs()[kv.second->name()],
-                                      pubsub_->subs()[kv.second->name()]);
+        bool result = kv.second->step(pubsub_->topic_table(kv.second->name()));
         if (!result && kv.second->print_err_on_exit) {
             cout << "Network requested simulation termination: "
                  << kv.second->name() << endl;
@@ -505,15 +602,19 @@ bool SimControl::run_metrics() {
 }
 
 bool SimControl::run_logging() {
+    // The frame is a copy of the contact states, so the lock is only needed
+    // while it is built
     contacts_mutex_.lock();
-
     std::shared_ptr<scrimmage_proto::Frame> frame =
         create_frame(t_ + dt_, contacts_);
+    contacts_mutex_.unlock();
+
+    if (frame_delta_) {
+        frame = frame_encoder_.encode(*frame);
+    }
 
     outgoing_interface_->send_frame(frame);
     log_->save_frame(frame);
-
-    contacts_mutex_.unlock();
     return true;
 }
 
@@ -522,7 +623,12 @@ void SimControl::run_remove_inactive() {
     while (it != ents_.end()) {
         if (!(*it)->active()) {
             int id = (*it)->id().id();
-            (*it)->close(t());
+            if (snapshot_) {
+                // keep the entity intact for restore()
+                removed_ents_.push_back(*it);
+            } else {
+                (*it)->close(t());
+            }
             it = ents_.erase(it);
             contacts_mutex_.lock();
             contacts_->erase(id);
@@ -606,6 +712,7 @@ bool SimControl::run_single_step(const int& loop_number) {
     }
 
     set_autonomy_contacts();
+    update_contact_snapshot();
     if (!run_entities()) {
         if (!limited_verbosity_) {
             std::cout << "Exiting due to plugin request." << std::endl;
@@ -613,6 +720,8 @@ bool SimControl::run_single_step(const int& loop_number) {
         return false;
     }
 
+    // the sensors see the states after the motion models have stepped
+    update_contact_snapshot();
     if (!run_sensors()) {
         if (!limited_verbosity_) {
             std::cout << "Exiting due to plugin request." << std::endl;
@@ -660,6 +769,146 @@ bool SimControl::run_single_step(const int& loop_number) {
     return not (end_condition_reached() || exit_loop);
 }
 
+bool SimControl::snapshot() {
+    auto snap = std::make_shared<Snapshot>();
+    snap->t = t();
+    snap->random.copy_state(*random_);
+    snap->gen_info = mp_->gen_info();
+    snap->next_gen_times = mp_->next_gen_times();
+    snap->ids_used = ids_used_;
+    snap->id_to_team_map = *id_to_team_map_;
+    snap->id_to_ent_map = *id_to_ent_map_;
+    contacts_mutex_.lock();
+    snap->contacts = *contacts_;
+    contacts_mutex_.unlock();
+    snap->contact_visuals = contact_visuals_;
+    snap->ents = ents_;
+    snap->not_ready = not_ready_;
+    snap->reseed_task = reseed_task_;
+    snap->screenshot_task = screenshot_task_;
+    pubsub_->snapshot(snap->pubsub);
+
+    auto save_plugin = [&](const EntityPluginPtr &plugin) {
+        Snapshot::PluginState p;
+        p.plugin = plugin;
+        p.state = plugin->save_state();
+        p.loop_timer = plugin->loop_timer();
+        if (plugin->vars().output()) {
+            p.output = *plugin->vars().output();
+        }
+        snap->plugin_states.push_back(p);
+    };
+
+    for (EntityPtr &ent : ents_) {
+        Snapshot::EntityState e;
+        e.ent = ent;
+        e.state = *ent->state();
+        e.state_truth = *ent->state_truth();
+        e.visual = *ent->contact_visual();
+        e.health_points = ent->health_points();
+        e.active = ent->active();
+
+        if (ent->motion()) {
+            e.motion_x = ent->motion()->full_state_vector();
+            save_plugin(ent->motion());
+        }
+        for (AutonomyPtr &autonomy : ent->autonomies()) {
+            e.desired_states.push_back(*autonomy->desired_state());
+            save_plugin(autonomy);
+        }
+        for (ControllerPtr &controller : ent->controllers()) {
+            save_plugin(controller);
+        }
+        for (auto &kv : ent->sensors()) {
+            save_plugin(kv.second);
+        }
+        snap->ent_states.push_back(e);
+    }
+
+    for (EntityInteractionPtr &ent_inter : ent_inters_) save_plugin(ent_inter);
+    for (MetricsPtr &metrics : metrics_) save_plugin(metrics);
+    for (auto &kv : *networks_) save_plugin(kv.second);
+
+    clear_snapshot();
+    snapshot_ = snap;
+    return true;
+}
+
+bool SimControl::restore() {
+    if (!snapshot_) {
+        return false;
+    }
+    Snapshot &snap = *snapshot_;
+
+    // Close the entities that did not exist at the time of the snapshot
+    std::set<EntityPtr> kept(snap.ents.begin(), snap.ents.end());
+    removed_ents_.splice(removed_ents_.end(), ents_);
+    for (EntityPtr &ent : removed_ents_) {
+        if (kept.count(ent) == 0) {
+            ent->close(t());
+        }
+    }
+    removed_ents_.clear();
+
+    ents_ = snap.ents;
+    not_ready_ = snap.not_ready;
+    mp_->gen_info() = snap.gen_info;
+    mp_->next_gen_times() = snap.next_gen_times;
+    ids_used_ = snap.ids_used;
+    *id_to_team_map_ = snap.id_to_team_map;
+    *id_to_ent_map_ = snap.id_to_ent_map;
+    contacts_mutex_.lock();
+    *contacts_ = snap.contacts;
+    contacts_mutex_.unlock();
+    contact_visuals_ = snap.contact_visuals;
+    shapes_.clear();
+    reseed_task_ = snap.reseed_task;
+    screenshot_task_ = snap.screenshot_task;
+    random_->copy_state(snap.random);
+    pubsub_->restore(snap.pubsub);
+
+    for (Snapshot::EntityState &e : snap.ent_states) {
+        EntityPtr &ent = e.ent;
+        *ent->state() = e.state;
+        *ent->state_truth() = e.state_truth;
+        ent->contact_visual()->CopyFrom(e.visual);
+        ent->set_health_points(e.health_points);
+        ent->set_active(e.active);
+        if (ent->motion()) {
+            ent->motion()->full_state_vector() = e.motion_x;
+            ent->motion()->reset_integrator();
+        }
+        for (size_t i = 0; i < e.desired_states.size(); i++) {
+            *ent->autonomies()[i]->desired_state() = e.desired_states[i];
+        }
+    }
+
+    for (Snapshot::PluginState &p : snap.plugin_states) {
+        p.plugin->restore_state(p.state);
+        p.plugin->set_loop_timer(p.loop_timer);
+        if (p.plugin->vars().output()) {
+            *p.plugin->vars().output() = p.output;
+        }
+    }
+
+    frame_encoder_.reset();
+    exit_mutex_.lock();
+    exit_ = false;
+    exit_mutex_.unlock();
+
+    set_time(snap.t);
+    create_rtree();
+    return true;
+}
+
+void SimControl::clear_snapshot() {
+    for (EntityPtr &ent : removed_ents_) {
+        ent->close(t());
+    }
+    removed_ents_.clear();
+    snapshot_ = nullptr;
+}
+
 void SimControl::run_threaded() {
     running_in_thread_ = true;
     thread_ = std::thread(&SimControl::run, this);
@@ -679,8 +928,34 @@ bool SimControl::start() {
 
     display_progress_ = get("display_progress", mp_->params(), true);
 
+    frame_delta_ = get("frame_delta", mp_->params(), false);
+    frame_encoder_.reset();
+    frame_encoder_.set_keyframe_interval(
+        std::max(get("frame_keyframe_interval", mp_->params(), 100), 1));
+    frame_encoder_.set_precision(get("frame_delta_precision", mp_->params(), 1.0e-3));
+
     proj_ = mp_->projection(); // get projection (origin) from mission
 
+    std::string rtree_update = get<std::string>("rtree_update", mp_->params(), "rebuild");
+    if (rtree_update == "move") {
+        rtree_->set_update_mode(RTree::UpdateMode::MOVE);
+    } else if (rtree_update == "rebuild") {
+        rtree_->set_update_mode(RTree::UpdateMode::REBUILD);
+    } else {
+        cout << "Unknown rtree_update mode, " << rtree_update
+             << ", using rebuild" << endl;
+        rtree_->set_update_mode(RTree::UpdateMode::REBUILD);
+    }
+
+    std::string spatial_index = get<std::string>("spatial_index", mp_->params(), "rtree");
+    if (spatial_index == "grid") {
+        double cell_size = get("cell_size", mp_->attributes()["spatial_index"], 100.0);
+        rtree_->set_index(std::make_shared<SpatialHash>(cell_size));
+    } else if (spatial_index != "rtree") {
+        cout << "Unknown spatial_index, " << spatial_index
+             << ", using rtree" << endl;
+    }
+
     if (get("show_plugins", mp_->params(), false)) {
         plugin_manager_->print_plugins("scrimmage::Autonomy", "Autonomy Plugins", *file_search_);
         plugin_manager_->print_plugins("scrimmage::MotionModel", "Motion Plugins", *file_search_);
@@ -736,7 +1011,8 @@ bool SimControl::start() {
         mp_->params().count("stream_ip") > 0) {
 
         if (mp_->network_gui()) {
-            outgoing_interface_->init_network(Interface::client,
+            const bool shm = get("stream_shared_memory", mp_->params(), false);
+            outgoing_interface_->init_network(shm ? Interface::shm_client : Interface::client,
                                               mp_->params()["stream_ip"],
                                               std::stoi(mp_->params()["stream_port"]));
 
@@ -853,8 +1129,9 @@ bool SimControl::start() {
             params[msg->data.entity_param(i).key()] = msg->data.entity_param(i).value();
         }
 
-        // Recreate the rtree with one additional size for this entity.
-        this->create_rtree(1);
+        // Update the rtree before checking for collisions with this entity.
+        this->create_rtree();
+        this->reset_spawn_placer();
 
         if (not this->generate_entity(it_ent_desc_id->second, params)) {
             cout << "Failed to generate entity with tag: "
@@ -872,6 +1149,28 @@ bool SimControl::start() {
         plugin_manager_->print_returned_plugins();
     }
 
+    batch_motion_ = get<bool>("batch_motion", mp_->params(), false);
+    clone_entities_ = get<bool>("clone_entities", mp_->params(), true);
+
+    std::string spawn_placement = get<std::string>("spawn_placement", mp_->params(), "variance");
+    if (spawn_placement == "poisson_disk") {
+        spawn_placer_.set_method(SpawnPlacer::Method::PoissonDisk);
+        spawn_placer_.set_candidates(
+            get("candidates", mp_->attributes()["spawn_placement"], 30));
+    } else {
+        if (spawn_placement != "variance") {
+            cout << "Unknown spawn_placement, " << spawn_placement
+                 << ", using variance" << endl;
+        }
+        spawn_placer_.set_method(SpawnPlacer::Method::Variance);
+    }
+
+    double separation = 0;
+    for (EntityInteractionPtr &ent_inter : ent_inters_) {
+        separation = std::max(separation, ent_inter->startup_collision_range());
+    }
+    spawn_placer_.set_separation(separation);
+
     if (get("multi_threaded", mp_->params(), false)) {
         auto it = mp_->attributes().find("multi_threaded");
         if (it != mp_->attributes().end()) {
@@ -888,13 +1187,8 @@ bool SimControl::start() {
         }
 
         if (!entity_thread_types_.empty()) {
-            entity_pool_stop_ = false;
             num_entity_threads_ = get("num_threads", mp_->attributes()["multi_threaded"], 1);
-            entity_worker_threads_.clear();
-            entity_worker_threads_.reserve(num_entity_threads_);
-            for (int i = 0; i < num_entity_threads_; i++) {
-                entity_worker_threads_.push_back(std::thread(&SimControl::worker, this));
-            }
+            executor_ = std::make_shared<TaskExecutor>(num_entity_threads_);
         }
     }
 
@@ -987,13 +1281,8 @@ bool SimControl::finalize() {
     }
     finalized_called_ = true;
 
-    if (!entity_thread_types_.empty()) {
-        entity_pool_stop_ = true;
-        entity_pool_condition_var_.notify_all();
-        for (std::thread &t : entity_worker_threads_) {
-            t.join();
-        }
-    }
+    // stop the worker threads
+    executor_ = nullptr;
 
     // account for last step
     set_time(t() - dt_);
@@ -1039,6 +1328,7 @@ bool SimControl::shutdown(const bool& shutdown_python) {
     finalize();
 
     // Close all plugins
+    clear_snapshot();
     for (EntityPtr &ent : ents_) {
         ent->close(t());
     }
@@ -1076,11 +1366,13 @@ bool SimControl::reset_pointers() {
     outgoing_interface_ = nullptr;
     mp_ = nullptr;
     ents_.clear();
+    prototypes_.clear();
     contacts_ = nullptr;
     shapes_.clear();
     contact_visuals_.clear();
     time_ = nullptr;
-    entity_pool_queue_.clear();
+    executor_ = nullptr;
+    task_ents_.clear();
     log_ = nullptr;
     random_ = nullptr;
     plugin_manager_ = nullptr;
@@ -1089,8 +1381,7 @@ bool SimControl::reset_pointers() {
     ent_inters_.clear();
     metrics_.clear();
     networks_->clear();
-    pubsub_->pubs().clear();
-    pubsub_->subs().clear();
+    pubsub_->clear();
     pubsub_ = nullptr;
     file_search_ = nullptr;
     rtree_ = nullptr;
@@ -1185,6 +1476,8 @@ PluginManagerPtr &SimControl::plugin_manager() {return plugin_manager_;}
 
 FileSearchPtr &SimControl::file_search() {return file_search_;}
 
+TaskExecutorPtr &SimControl::executor() {return executor_;}
+
 bool SimControl::take_step() {
     take_step_mutex_.lock();
     bool value = take_step_;
@@ -1219,6 +1512,8 @@ void SimControl::run_check_network_msgs() {
                 this->force_exit();
             } else if (it->request_cached()) {
                 outgoing_interface_->send_cached();
+                // let a newly connected viewer start from a full frame
+                frame_encoder_.reset();
             } else if (it->custom_key() != "") {
                 auto msg = std::make_shared<Message<std::string>>();
                 std::string key(it->custom_key());
@@ -1376,63 +1671,6 @@ bool SimControl::single_step() {
     return value;
 }
 
-void SimControl::worker() {
-    while (true) {
-        entity_pool_mutex_.lock();
-        entity_pool_condition_var_.wait(entity_pool_mutex_);
-        entity_pool_mutex_.unlock();
-
-        if (entity_pool_stop_) {
-            break;
-        }
-
-        while (true) {
-            entity_pool_mutex_.lock();
-            if (entity_pool_queue_.empty()) {
-                entity_pool_mutex_.unlock();
-                break;
-            }
-            std::shared_ptr<Task> task = entity_pool_queue_.front();
-            EntityPtr ent = task->ent;
-            Task::Type task_type = task->type;
-            double temp_t = task->t;
-            double temp_dt = task->dt;
-            entity_pool_queue_.pop_front();
-            entity_pool_mutex_.unlock();
-
-            bool success = false;
-            if (task_type == Task::Type::AUTONOMY) {
-                auto &autonomies = ent->autonomies();
-                br::for_each(autonomies, run_callbacks);
-                auto run = [&](auto &a) {
-                  return a->step_loop_timer(temp_dt) ?
-                    a->step_autonomy(temp_t, temp_dt) : true;};
-                success = std::all_of(autonomies.begin(), autonomies.end(), run);
-            } else if (task_type == Task::Type::CONTROLLER) {
-                auto &controllers = ent->controllers();
-                br::for_each(controllers, run_callbacks);
-                auto run = [&](auto &c) {
-                  return c->step_loop_timer(temp_dt) ?
-                    c->step(temp_t, temp_dt) : true;};
-                success = std::all_of(controllers.begin(), controllers.end(), run);
-            } else if (task_type == Task::Type::MOTION) {
-                success = ent->motion()->step(temp_t, temp_dt);
-            } else if (task_type == Task::Type::SENSOR) {
-                auto sensors = ent->sensors() | ba::map_values;
-                br::for_each(sensors, run_callbacks);
-                auto run = [&](auto &s) {
-                  return s->step_loop_timer(temp_dt) ?
-                    s->step() : true;};
-                success = std::all_of(sensors.begin(), sensors.end(), run);
-            }
-
-            entity_pool_mutex_.lock();
-            task->prom.set_value(success);
-            entity_pool_mutex_.unlock();
-        }
-    }
-}
-
 void print_err(EntityPluginPtr p) {
     if (p->print_err_on_exit) {
         std::cout << "failed to update entity " << p->parent()->id().id()
@@ -1444,7 +1682,7 @@ void print_err(EntityPluginPtr p) {
 bool SimControl::run_sensors() {
     bool success = true;
     if (entity_thread_types_.count(Task::Type::SENSOR)) {
-        success &= add_tasks(Task::Type::SENSOR, t_, dt_);
+        success &= run_tasks(Task::Type::SENSOR, t_, dt_);
     } else {
         for (EntityPtr &ent : ents_) {
             br::for_each(ent->sensors() | ba::map_values, run_callbacks);
@@ -1469,34 +1707,162 @@ bool SimControl::run_sensors() {
     return success;
 }
 
-bool SimControl::add_tasks(Task::Type type, double t, double dt) {
-    // FIXME: this will be much simpler once there is a
-    // step function in EntityPlugin.h
-    // In particular, we can get rid of Task::Type and
-    // more easily do entity_interaction/network plugins in multiple threads.
+bool SimControl::step_entity(Task::Type type, Entity &ent, double t, double dt) {
+    if (type == Task::Type::AUTONOMY) {
+        // the autonomies that support batching run in run_autonomy_batches
+        auto autonomies = ent.autonomies() |
+            ba::filtered([](auto &a) {return !a->supports_batch();});
+        br::for_each(autonomies, run_callbacks);
+        auto run = [&](auto &a) {
+          return a->step_loop_timer(dt) ? a->step_autonomy(t, dt) : true;};
+        return std::all_of(autonomies.begin(), autonomies.end(), run);
+    } else if (type == Task::Type::CONTROLLER) {
+        auto &controllers = ent.controllers();
+        br::for_each(controllers, run_callbacks);
+        auto run = [&](auto &c) {
+          return c->step_loop_timer(dt) ? c->step(t, dt) : true;};
+        return std::all_of(controllers.begin(), controllers.end(), run);
+    } else if (type == Task::Type::MOTION) {
+        return ent.motion()->step(t, dt);
+    } else if (type == Task::Type::SENSOR) {
+        auto sensors = ent.sensors() | ba::map_values;
+        br::for_each(sensors, run_callbacks);
+        auto run = [&](auto &s) {
+          return s->step_loop_timer(dt) ? s->step() : true;};
+        return std::all_of(sensors.begin(), sensors.end(), run);
+    }
+    return false;
+}
 
-    // put tasks on queue
-    std::vector<std::future<bool>> futures;
-    futures.reserve(ents_.size());
+void SimControl::group_motion_models() {
+    for (auto &batch : motion_batches_) {
+        batch.clear();
+    }
+    unbatched_ents_.clear();
 
-    entity_pool_mutex_.lock();
+    std::unordered_map<std::type_index, size_t> batch_index;
+    size_t num_batches = 0;
     for (EntityPtr &ent : ents_) {
-        std::shared_ptr<Task> task = std::make_shared<Task>();
-        task->ent = ent;
-        task->type = type;
-        task->t = t;
-        task->dt = dt;
-        entity_pool_queue_.push_back(task);
-        futures.push_back(task->prom.get_future());
+        MotionModel *motion = ent->motion().get();
+        if (!motion->supports_batch()) {
+            unbatched_ents_.push_back(ent.get());
+            continue;
+        }
+
+        auto it = batch_index.emplace(std::type_index(typeid(*motion)), num_batches);
+        if (it.second) {
+            num_batches++;
+            if (motion_batches_.size() < num_batches) {
+                motion_batches_.emplace_back();
+            }
+        }
+        motion_batches_[it.first->second].push_back(motion);
+    }
+    motion_batches_.resize(num_batches);
+}
+
+bool SimControl::run_autonomy_batches(double t, double dt) {
+    for (auto &batch : autonomy_batches_) {
+        batch.clear();
     }
-    entity_pool_mutex_.unlock();
 
-    // tell the threads to run
-    entity_pool_condition_var_.notify_all();
+    std::unordered_map<std::type_index, size_t> batch_index;
+    size_t num_batches = 0;
+    for (EntityPtr &ent : ents_) {
+        for (AutonomyPtr &autonomy : ent->autonomies()) {
+            if (!autonomy->supports_batch()) continue;
+
+            run_callbacks(autonomy);
+            if (!autonomy->step_loop_timer(dt)) continue;
+
+            Autonomy *a = autonomy.get();
+            auto it = batch_index.emplace(std::type_index(typeid(*a)), num_batches);
+            if (it.second) {
+                num_batches++;
+                if (autonomy_batches_.size() < num_batches) {
+                    autonomy_batches_.emplace_back();
+                }
+            }
+            autonomy_batches_[it.first->second].push_back(a);
+        }
+    }
+    autonomy_batches_.resize(num_batches);
+
+    bool success = true;
+    for (std::vector<Autonomy *> &batch : autonomy_batches_) {
+        if (!batch.front()->step_autonomy_batch(batch, t, dt)) {
+            cout << "failed to update autonomies of type \""
+                 << batch.front()->name() << "\"" << endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+bool SimControl::run_motion_batches(double t, double dt) {
+    for (EntityPtr &ent : ents_) {
+        run_callbacks(ent->motion());
+    }
+
+    const bool threaded = entity_thread_types_.count(Task::Type::MOTION) > 0;
+    std::atomic<bool> success{true};
+    for (std::vector<MotionModel *> &batch : motion_batches_) {
+        if (threaded) {
+            executor_->parallel_for(batch.size(), [&](size_t begin, size_t end) {
+                std::vector<MotionModel *> slice(batch.begin() + begin, batch.begin() + end);
+                if (!slice.front()->step_batch(slice, t, dt)) {
+                    success = false;
+                }
+            });
+        } else if (!batch.front()->step_batch(batch, t, dt)) {
+            success = false;
+        }
+
+        if (!success) {
+            cout << "failed to update motion models of type \""
+                 << batch.front()->name() << "\"" << endl;
+            return false;
+        }
+    }
+
+    auto step = [&](Entity *ent) {
+        if (!ent->motion()->step(t, dt)) {
+            print_err(ent->motion());
+            success = false;
+        }
+    };
+    if (threaded) {
+        executor_->parallel_for(unbatched_ents_.size(), [&](size_t begin, size_t end) {
+            std::for_each(unbatched_ents_.begin() + begin, unbatched_ents_.begin() + end, step);
+        });
+    } else {
+        br::for_each(unbatched_ents_, step);
+    }
+    return success;
+}
 
-    // wait for results
-    auto get = [&](auto &future) {return future.get();};
-    return std::all_of(futures.begin(), futures.end(), get);
+bool SimControl::run_tasks(Task::Type type, double t, double dt) {
+    return run_tasks([&](Entity &ent) {return step_entity(type, ent, t, dt);});
+}
+
+bool SimControl::run_tasks(const std::function<bool(Entity &)> &step) {
+    // The executor needs random access to the entities
+    task_ents_.clear();
+    for (EntityPtr &ent : ents_) {
+        task_ents_.push_back(ent.get());
+    }
+
+    std::atomic<bool> success{true};
+    executor_->parallel_for(task_ents_.size(), [&](size_t begin, size_t end) {
+        bool chunk_success = true;
+        for (size_t i = begin; i < end; i++) {
+            chunk_success &= step(*task_ents_[i]);
+        }
+        if (!chunk_success) {
+            success = false;
+        }
+    });
+    return success;
 }
 
 bool SimControl::run_entities() {
@@ -1513,12 +1879,15 @@ bool SimControl::run_entities() {
         }
     };
 
+    success &= run_autonomy_batches(t_, dt_);
+
     // run autonomies threaded or in a single thread
     if (entity_thread_types_.count(Task::Type::AUTONOMY)) {
-        success &= add_tasks(Task::Type::AUTONOMY, t_, dt_);
+        success &= run_tasks(Task::Type::AUTONOMY, t_, dt_);
     } else {
         for (EntityPtr &ent : ents_) {
             for (auto a : ent->autonomies()) {
+                if (a->supports_batch()) continue;
                 success &= exec_step(a, [&](auto a){
                   return a->step_loop_timer(dt_) ?
                     a->step_autonomy(t_, dt_) : true;});
@@ -1528,20 +1897,42 @@ bool SimControl::run_entities() {
 
     double motion_dt = dt_ / mp_->motion_multiplier();
     double temp_t = t_;
+    const bool threaded_controllers = entity_thread_types_.count(Task::Type::CONTROLLER) > 0;
+    const bool threaded_motion = entity_thread_types_.count(Task::Type::MOTION) > 0;
+    if (batch_motion_) {
+        group_motion_models();
+    }
     for (int i = 0; i < mp_->motion_multiplier(); i++) {
-        // run controllers in a single thread since they are serially connected
-        for (EntityPtr &ent : ents_) {
-            for (auto c : ent->controllers()) {
-                success &= exec_step(c, [&](auto c){
-                  return c->step_loop_timer(dt_) ?
-                    c->step(t_, dt_) : true;});
+        if (threaded_controllers && threaded_motion && !batch_motion_) {
+            // An entity's controllers only feed its own motion model, so
+            // both run in a single task per entity
+            success &= run_tasks([&](Entity &ent) {
+                bool ent_success = step_entity(Task::Type::CONTROLLER, ent, t_, dt_);
+                ent_success &= step_entity(Task::Type::MOTION, ent, temp_t, motion_dt);
+                return ent_success;
+            });
+            temp_t += motion_dt;
+            continue;
+        }
+
+        // the controllers of an entity are serially connected, so they are
+        // threaded per entity
+        if (threaded_controllers) {
+            success &= run_tasks(Task::Type::CONTROLLER, t_, dt_);
+        } else {
+            for (EntityPtr &ent : ents_) {
+                for (auto c : ent->controllers()) {
+                    success &= exec_step(c, [&](auto c){
+                      return c->step_loop_timer(dt_) ?
+                        c->step(t_, dt_) : true;});
+                }
             }
         }
 
         // run motion model
         auto step_all = [&](Task::Type type, auto getter) {
             if (entity_thread_types_.count(type)) {
-                success &= add_tasks(type, temp_t, motion_dt);
+                success &= run_tasks(type, temp_t, motion_dt);
             } else {
                 for (EntityPtr &ent : ents_) {
                     auto step = [&](auto p){return p->step(temp_t, motion_dt);};
@@ -1549,7 +1940,11 @@ bool SimControl::run_entities() {
                 }
             }
         };
-        step_all(Task::Type::MOTION, [&](auto ent){return ent->motion();});
+        if (batch_motion_) {
+            success &= run_motion_batches(temp_t, motion_dt);
+        } else {
+            step_all(Task::Type::MOTION, [&](auto ent){return ent->motion();});
+        }
 
         temp_t += motion_dt;
     }
@@ -1596,15 +1991,15 @@ bool SimControl::run_entities() {
 
 void SimControl::run_send_shapes() {
     // Convert map of shapes to sp::Shapes type
-    scrimmage_proto::Shapes shapes;
-    shapes.set_time(this->t());
+    auto shapes = std::make_shared<scrimmage_proto::Shapes>();
+    shapes->set_time(this->t());
     for (auto &kv : shapes_) {
         for (auto &shape : kv.second) {
-            scrimmage_proto::Shape *s = shapes.add_shape();
+            scrimmage_proto::Shape *s = shapes->add_shape();
             *s = *shape;
         }
     }
-    outgoing_interface_->send_shapes(shapes);
+    outgoing_interface_->send_shapes(*shapes);
     log_->save_shapes(shapes);
     shapes_.clear();
 }
@@ -1651,29 +2046,15 @@ bool SimControl::output_git_summary() {
     return true;
 }
 
-bool SimControl::output_summary() {
-    std::map<int, double> team_scores;
-    std::map<int, std::map<std::string, double>> team_metrics;
-    std::list<std::string> headers;
-
-    bool metrics_empty = true;
-
-    // Loop through each of the metrics plugins.
+void SimControl::team_summary(std::map<int, double> &team_scores,
+                              std::map<int, std::map<std::string, double>> &team_metrics,
+                              std::list<std::string> &headers) {
     for (auto metrics : metrics_) {
-        if (metrics->get_print_team_summary()) {
-            cout << sc::generate_chars("=", 80) << endl;
-            cout << metrics->name() << endl;
-            cout << sc::generate_chars("=", 80) << endl;
-            metrics->calc_team_scores();
-            metrics->print_team_summaries();
-        }
-
         // Add all elements from individual metrics plugin to overall
         // metrics data structure
         for (auto const &team_str_double : metrics->team_metrics()) {
             team_metrics[team_str_double.first].insert(team_str_double.second.begin(),
                                                        team_str_double.second.end());
-            metrics_empty = false;
         }
 
         // Calculate aggregated team scores:
@@ -1688,6 +2069,25 @@ bool SimControl::output_summary() {
         headers.insert(headers.end(), metrics->headers().begin(),
                        metrics->headers().end());
     }
+}
+
+bool SimControl::output_summary() {
+    // Loop through each of the metrics plugins.
+    for (auto metrics : metrics_) {
+        if (metrics->get_print_team_summary()) {
+            cout << sc::generate_chars("=", 80) << endl;
+            cout << metrics->name() << endl;
+            cout << sc::generate_chars("=", 80) << endl;
+            metrics->calc_team_scores();
+            metrics->print_team_summaries();
+        }
+    }
+
+    std::map<int, double> team_scores;
+    std::map<int, std::map<std::string, double>> team_metrics;
+    std::list<std::string> headers;
+    team_summary(team_scores, team_metrics, headers);
+    bool metrics_empty = team_metrics.empty();
 
     // Create headers string
     std::string csv_str = "team_id,score";
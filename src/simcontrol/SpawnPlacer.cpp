@@ -0,0 +1,189 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <scrimmage/simcontrol/SpawnPlacer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace scrimmage {
+
+SpawnPlacer::SpawnPlacer() {}
+
+void SpawnPlacer::set_method(Method method) {
+    method_ = method;
+}
+
+void SpawnPlacer::set_separation(double separation) {
+    separation_ = std::max(separation, 0.0);
+    if (separation_ > 0) {
+        grid_.set_cell_size(separation_);
+    }
+}
+
+void SpawnPlacer::set_candidates(int candidates) {
+    candidates_ = std::max(candidates, 1);
+}
+
+void SpawnPlacer::set_max_attempts(int max_attempts) {
+    max_attempts_ = max_attempts;
+}
+
+void SpawnPlacer::reset(const std::vector<std::pair<Eigen::Vector3d, ID>> &entries) {
+    active_.clear();
+    if (separation_ > 0) {
+        grid_.update(entries);
+    }
+}
+
+void SpawnPlacer::add(const Eigen::Vector3d &pos, const ID &id) {
+    if (separation_ > 0) {
+        grid_.add(pos, id);
+    }
+}
+
+bool SpawnPlacer::occupied(const Eigen::Vector3d &pos) const {
+    if (separation_ <= 0) {
+        return false;
+    }
+    std::vector<ID> neighbors;
+    grid_.neighbors_in_range(pos, neighbors, separation_);
+    return !neighbors.empty();
+}
+
+bool SpawnPlacer::place(int block_id, const Eigen::Vector3d &mean,
+                        const Eigen::Vector3d &stddev, bool sample,
+                        std::default_random_engine &gener,
+                        const std::function<bool(const Eigen::Vector3d &)> &collision,
+                        const std::function<bool()> &cancel,
+                        Eigen::Vector3d &pos) {
+    auto rejected = [&](const Eigen::Vector3d &p) {
+        return occupied(p) || collision(p);
+    };
+
+    if (method_ == Method::PoissonDisk && separation_ > 0 &&
+        place_poisson_disk(block_id, mean, stddev, gener, rejected, cancel, pos)) {
+        active_[block_id].push_back(pos);
+        return true;
+    }
+
+    if (cancel()) {
+        return false;
+    }
+
+    pos = mean;
+    if (sample || rejected(pos)) {
+        // Draw the samples in the same order as before the placer existed,
+        // so that missions keep their initial positions for a given seed.
+        std::normal_distribution<double> x_dist(mean(0), stddev(0));
+        std::normal_distribution<double> y_dist(mean(1), stddev(1));
+        std::normal_distribution<double> z_dist(mean(2), stddev(2));
+        int ct = 0;
+        bool reselect = true;
+        while (reselect && ct++ < max_attempts_) {
+            if (cancel()) {
+                return false;
+            }
+            pos(0) = x_dist(gener);
+            pos(1) = y_dist(gener);
+            pos(2) = z_dist(gener);
+            reselect = rejected(pos);
+        }
+        if (reselect) {
+            return false;
+        }
+    }
+
+    if (method_ == Method::PoissonDisk) {
+        active_[block_id].push_back(pos);
+    }
+    return true;
+}
+
+bool SpawnPlacer::place_poisson_disk(
+        int block_id, const Eigen::Vector3d &mean,
+        const Eigen::Vector3d &stddev, std::default_random_engine &gener,
+        const std::function<bool(const Eigen::Vector3d &)> &rejected,
+        const std::function<bool()> &cancel,
+        Eigen::Vector3d &pos) {
+    std::vector<int> axes;
+    for (int i = 0; i < 3; i++) {
+        if (stddev(i) > 0) axes.push_back(i);
+    }
+    auto it_active = active_.find(block_id);
+    if (axes.empty() || it_active == active_.end()) {
+        return false;
+    }
+
+    // Draw the distance so that the candidates are uniform in the shell
+    // between one and two separations in the dimensions with variance.
+    const double dim = axes.size();
+    const double r_min = std::pow(separation_, dim);
+    const double r_max = std::pow(2 * separation_, dim);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::normal_distribution<double> normal(0, 1);
+
+    std::vector<Eigen::Vector3d> &active = it_active->second;
+    while (!active.empty()) {
+        std::uniform_int_distribution<size_t> pick(0, active.size() - 1);
+        const size_t idx = pick(gener);
+        const Eigen::Vector3d center = active[idx];
+
+        for (int k = 0; k < candidates_; k++) {
+            if (cancel()) {
+                return false;
+            }
+            Eigen::Vector3d dir = Eigen::Vector3d::Zero();
+            for (int i : axes) dir(i) = normal(gener);
+            if (dir.norm() == 0) continue;
+
+            double r = std::pow(r_min + uniform(gener) * (r_max - r_min), 1 / dim);
+            pos = center + dir.normalized() * r;
+
+            // Stay within three standard deviations of the block's position
+            double dist_sq = 0;
+            for (int i : axes) {
+                dist_sq += std::pow((pos(i) - mean(i)) / stddev(i), 2);
+            }
+            if (dist_sq <= 9 && !rejected(pos)) {
+                return true;
+            }
+        }
+
+        // There isn't room around this entity anymore
+        active[idx] = active.back();
+        active.pop_back();
+    }
+    return false;
+}
+} // namespace scrimmage
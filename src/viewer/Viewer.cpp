@@ -102,6 +102,7 @@ bool Viewer::init(const std::shared_ptr<MissionParse>& mp,
     local_port_ = get<int>("local_port", camera_params_, local_port_);
     remote_ip_ = get<std::string>("remote_ip", camera_params_, remote_ip_);
     remote_port_ = get<int>("remote_port", camera_params_, remote_port_);
+    shared_memory_ = get<bool>("shared_memory", camera_params_, false);
 
     return true;
 }
@@ -112,7 +113,8 @@ bool Viewer::run() {
     if (enable_network_) {
         outgoing_interface_->init_network(Interface::client, remote_ip_, remote_port_);
         network_thread_ = std::thread(&Interface::init_network, &(*incoming_interface_),
-                                      Interface::server, local_ip_, local_port_);
+                                      shared_memory_ ? Interface::shm_server : Interface::server,
+                                      local_ip_, local_port_);
         network_thread_.detach();
     } else {
         incoming_interface_->set_mode(Interface::shared);
@@ -0,0 +1,128 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/Quaternion.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <Eigen/Dense>
+
+namespace sc = scrimmage;
+
+namespace {
+// Key: entity ID, Value: position and velocity
+using States = std::map<int, std::pair<Eigen::Vector3d, Eigen::Vector3d>>;
+
+void set_plugin(sc::MissionParsePtr &mp, int block, const std::string &tag,
+                const std::string &name) {
+    mp->entity_descriptions()[block][tag] = name;
+    mp->entity_attributes()[block][tag]["ORIGINAL_PLUGIN_NAME"] = name;
+}
+
+States run_mission(bool batch_motion, bool multi_threaded, int &num_batched) {
+    sc::SimControl simcontrol;
+    simcontrol.mp()->set_overrides("count=40");
+    EXPECT_TRUE(simcontrol.init("straight", false));
+    sc::MissionParsePtr mp = simcontrol.mp();
+    mp->set_time_warp(0);
+    mp->set_enable_gui(false);
+    mp->params()["display_progress"] = "false";
+    mp->params()["batch_motion"] = batch_motion ? "true" : "false";
+    if (multi_threaded) {
+        mp->params()["multi_threaded"] = "true";
+        mp->attributes()["multi_threaded"]["num_threads"] = "4";
+    }
+
+    // The straight mission's first two entity blocks, with motion models
+    // that support batching
+    set_plugin(mp, 0, "motion_model", "Unicycle");
+    mp->entity_attributes()[0]["motion_model"]["use_pitch"] = "true";
+    set_plugin(mp, 0, "controller0", "UnicyclePID");
+    set_plugin(mp, 1, "motion_model", "SingleIntegrator");
+    set_plugin(mp, 1, "autonomy0", "Boids");
+    set_plugin(mp, 1, "controller0", "SingleIntegratorControllerSimple");
+
+    simcontrol.pause(false);
+    EXPECT_TRUE(simcontrol.start());
+
+    num_batched = 0;
+    for (sc::EntityPtr &ent : simcontrol.ents()) {
+        if (ent->motion()->supports_batch()) num_batched++;
+    }
+
+    for (int i = 0; i < 300 && simcontrol.run_single_step(i); i++) {}
+
+    States states;
+    for (sc::EntityPtr &ent : simcontrol.ents()) {
+        states[ent->id().id()] = std::make_pair(ent->state_truth()->pos(),
+                                                ent->state_truth()->vel());
+    }
+    EXPECT_TRUE(simcontrol.shutdown(false));
+    return states;
+}
+
+void expect_same(States &expected, States &states) {
+    ASSERT_EQ(states.size(), expected.size());
+    for (auto &kv : expected) {
+        ASSERT_EQ(states.count(kv.first), 1u);
+        auto &state = states[kv.first];
+        EXPECT_TRUE(state.first.isApprox(kv.second.first, 1e-9))
+            << "entity " << kv.first << " at " << state.first.transpose()
+            << " instead of " << kv.second.first.transpose();
+        EXPECT_TRUE(state.second.isApprox(kv.second.second, 1e-9))
+            << "entity " << kv.first << " velocity " << state.second.transpose()
+            << " instead of " << kv.second.second.transpose();
+    }
+}
+} // namespace
+
+TEST(test_batch_motion, same_as_unbatched) {
+    int num_batched = 0;
+    States unbatched = run_mission(false, false, num_batched);
+    EXPECT_EQ(num_batched, 70);
+
+    States batched = run_mission(true, false, num_batched);
+    expect_same(unbatched, batched);
+
+    // Each thread steps a slice of the batch
+    States threaded = run_mission(true, true, num_batched);
+    expect_same(unbatched, threaded);
+}
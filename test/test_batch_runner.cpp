@@ -0,0 +1,160 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <scrimmage/simcontrol/BatchRunner.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace sc = scrimmage;
+
+TEST(test_batch_runner, grid) {
+    sc::ParameterRange speed;
+    speed.name = "speed";
+    speed.low = 10;
+    speed.high = 20;
+    speed.count = 3;
+
+    sc::ParameterRange count;
+    count.name = "count";
+    count.type = "int";
+    count.vec = {"1", "4"};
+
+    sc::BatchRunner batch_runner;
+    batch_runner.set_ranges({speed, count});
+    batch_runner.set_method("grid");
+    batch_runner.set_num_repeats(2);
+    ASSERT_TRUE(batch_runner.generate_runs());
+
+    auto &runs = batch_runner.runs();
+    ASSERT_EQ(runs.size(), 12u);
+    EXPECT_EQ(runs[0].at("speed"), "10");
+    EXPECT_EQ(runs[0].at("count"), "1");
+    EXPECT_EQ(runs[1], runs[0]);
+    EXPECT_EQ(runs[2].at("speed"), "10");
+    EXPECT_EQ(runs[2].at("count"), "4");
+    EXPECT_EQ(runs[4].at("speed"), "15");
+    EXPECT_EQ(runs[11].at("speed"), "20");
+    EXPECT_EQ(runs[11].at("count"), "4");
+
+    sc::ParameterRange no_count;
+    no_count.name = "gain";
+    batch_runner.set_ranges({no_count});
+    EXPECT_FALSE(batch_runner.generate_runs());
+}
+
+TEST(test_batch_runner, lhs) {
+    sc::ParameterRange speed;
+    speed.name = "speed";
+    speed.low = 0;
+    speed.high = 10;
+
+    sc::ParameterRange count;
+    count.name = "count";
+    count.type = "int";
+    count.low = 0;
+    count.high = 10;
+
+    const int num_runs = 10;
+    sc::BatchRunner batch_runner;
+    batch_runner.set_ranges({speed, count});
+    batch_runner.set_num_runs(num_runs);
+    batch_runner.set_seed(3);
+    ASSERT_TRUE(batch_runner.generate_runs());
+    ASSERT_EQ(batch_runner.runs().size(), static_cast<size_t>(num_runs));
+
+    // every interval of each parameter is sampled once
+    std::set<int> speed_bins, count_bins;
+    for (auto &run : batch_runner.runs()) {
+        double value = std::stod(run.at("speed"));
+        EXPECT_GE(value, 0);
+        EXPECT_LT(value, 10);
+        speed_bins.insert(static_cast<int>(value));
+        count_bins.insert(std::stoi(run.at("count")));
+    }
+    EXPECT_EQ(speed_bins.size(), static_cast<size_t>(num_runs));
+    EXPECT_EQ(count_bins.size(), static_cast<size_t>(num_runs));
+
+    // the same seed gives the same samples
+    auto runs = batch_runner.runs();
+    ASSERT_TRUE(batch_runner.generate_runs());
+    EXPECT_EQ(runs, batch_runner.runs());
+}
+
+TEST(test_batch_runner, run) {
+    char dir_template[] = "/tmp/scrimmage_test_batch_XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template), nullptr);
+    std::string dir(dir_template);
+
+    std::string ranges_file = dir + "/ranges.xml";
+    std::ofstream ranges(ranges_file);
+    ranges << "<ranges><count vec=\"1, 2\" type=\"int\"/></ranges>";
+    ranges.close();
+
+    sc::BatchRunner batch_runner;
+    ASSERT_TRUE(batch_runner.init("straight"));
+    ASSERT_TRUE(batch_runner.parse_ranges(ranges_file));
+    batch_runner.set_method("grid");
+    batch_runner.set_num_repeats(2);
+    batch_runner.set_num_threads(2);
+    batch_runner.set_seed(1);
+    batch_runner.set_summary_file(dir + "/summary.csv");
+    ASSERT_TRUE(batch_runner.generate_runs());
+    ASSERT_EQ(batch_runner.runs().size(), 4u);
+    EXPECT_TRUE(batch_runner.run());
+
+    std::ifstream summary(dir + "/summary.csv");
+    ASSERT_TRUE(summary.is_open());
+    std::string line;
+    std::getline(summary, line);
+    EXPECT_EQ(line.find("run,seed,count,status,log_dir,team_id,score"), 0u);
+
+    std::set<std::string> runs;
+    while (std::getline(summary, line)) {
+        EXPECT_NE(line.find(",ok,"), std::string::npos) << line;
+        runs.insert(line.substr(0, line.find(',')));
+    }
+    EXPECT_EQ(runs, std::set<std::string>({"1", "2", "3", "4"}));
+
+    summary.close();
+    std::remove(ranges_file.c_str());
+    std::remove((dir + "/summary.csv").c_str());
+    rmdir(dir.c_str());
+}
@@ -0,0 +1,83 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <memory>
+
+#include <scrimmage/common/ID.h>
+#include <scrimmage/entity/Contact.h>
+#include <scrimmage/entity/ContactSnapshot.h>
+#include <scrimmage/math/State.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(test_contact_snapshot, update) {
+    sc::ContactMap contacts;
+    for (int id : {7, 3, 12}) {
+        sc::StatePtr state = std::make_shared<sc::State>();
+        state->pos() << id, 2 * id, 0;
+        state->vel() << 1, 0, 0;
+        contacts[id] = sc::Contact(sc::ID(id, 0, id % 2 + 1), state);
+    }
+    // contacts without a state are skipped
+    contacts[5] = sc::Contact(sc::ID(5, 0, 1), nullptr);
+
+    sc::ContactSnapshot snapshot;
+    snapshot.update(contacts);
+    ASSERT_EQ(snapshot.size(), 3u);
+
+    // sorted by id
+    EXPECT_EQ(snapshot.ids()[0], 3);
+    EXPECT_EQ(snapshot.ids()[1], 7);
+    EXPECT_EQ(snapshot.ids()[2], 12);
+
+    int idx = snapshot.index(12);
+    ASSERT_EQ(idx, 2);
+    EXPECT_EQ(snapshot.team_ids()[idx], 1);
+    EXPECT_DOUBLE_EQ(snapshot.pos()[idx](1), 24);
+    EXPECT_DOUBLE_EQ(snapshot.vel()[idx](0), 1);
+
+    EXPECT_EQ(snapshot.index(5), -1);
+    EXPECT_EQ(snapshot.index(100), -1);
+    EXPECT_EQ(snapshot.index(-1), -1);
+
+    // a snapshot taken later doesn't change when the states change
+    contacts[3].state()->pos() << 100, 100, 100;
+    EXPECT_DOUBLE_EQ(snapshot.pos()[0](0), 3);
+
+    contacts.erase(12);
+    snapshot.update(contacts);
+    EXPECT_EQ(snapshot.size(), 2u);
+    EXPECT_EQ(snapshot.index(12), -1);
+    EXPECT_DOUBLE_EQ(snapshot.pos()[snapshot.index(3)](0), 100);
+}
@@ -0,0 +1,129 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/common/VariableIO.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/motion/Controller.h>
+#include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <Eigen/Dense>
+
+namespace sc = scrimmage;
+
+namespace {
+std::map<int, Eigen::Vector3d> run_mission(const std::string &clone_entities,
+                                           std::set<sc::Autonomy *> &autonomies) {
+    sc::SimControl simcontrol;
+    EXPECT_TRUE(simcontrol.init("straight", false));
+    simcontrol.mp()->set_time_warp(0);
+    simcontrol.mp()->set_enable_gui(false);
+    simcontrol.mp()->params()["display_progress"] = "false";
+    simcontrol.mp()->params()["clone_entities"] = clone_entities;
+    simcontrol.pause(false);
+    EXPECT_TRUE(simcontrol.start());
+
+    for (sc::EntityPtr &ent : simcontrol.ents()) {
+        for (sc::AutonomyPtr &autonomy : ent->autonomies()) {
+            autonomies.insert(autonomy.get());
+            // Each copy has its own state and VariableIO
+            EXPECT_EQ(autonomy->state(), ent->state());
+            EXPECT_EQ(autonomy->parent(), ent);
+        }
+        EXPECT_EQ(ent->motion()->parent(), ent);
+        EXPECT_EQ(ent->motion()->state(), ent->state_truth());
+    }
+
+    for (int i = 0; i < 500 && simcontrol.run_single_step(i); i++) {}
+
+    std::map<int, Eigen::Vector3d> positions;
+    for (sc::EntityPtr &ent : simcontrol.ents()) {
+        positions[ent->id().id()] = ent->state_truth()->pos();
+    }
+    EXPECT_TRUE(simcontrol.shutdown(false));
+    return positions;
+}
+} // namespace
+
+TEST(test_entity_clone, same_as_init) {
+    std::set<sc::Autonomy *> autonomies_init, autonomies_clone;
+    auto init = run_mission("false", autonomies_init);
+    auto clone = run_mission("true", autonomies_clone);
+
+    // The straight mission has an entity block with 30 entities
+    EXPECT_GT(autonomies_clone.size(), 30u);
+    EXPECT_EQ(autonomies_clone.size(), autonomies_init.size());
+
+    ASSERT_EQ(clone.size(), init.size());
+    for (auto &kv : init) {
+        ASSERT_EQ(clone.count(kv.first), 1u);
+        EXPECT_TRUE(clone[kv.first].isApprox(kv.second, 1e-9))
+            << "entity " << kv.first << " at " << clone[kv.first].transpose()
+            << " instead of " << kv.second.transpose();
+    }
+}
+
+TEST(test_entity_clone, connect_entity) {
+    for (std::string clone_entities : {"false", "true"}) {
+        sc::SimControl simcontrol;
+        ASSERT_TRUE(simcontrol.init("straight", false));
+        simcontrol.mp()->set_time_warp(0);
+        simcontrol.mp()->set_enable_gui(false);
+        simcontrol.mp()->params()["display_progress"] = "false";
+        simcontrol.mp()->params()["clone_entities"] = clone_entities;
+        for (auto &kv : simcontrol.mp()->entity_descriptions()) {
+            kv.second["connect_entity"] = "false";
+        }
+        simcontrol.pause(false);
+        ASSERT_TRUE(simcontrol.start());
+
+        // The autonomies don't write to the first controller's input
+        for (sc::EntityPtr &ent : simcontrol.ents()) {
+            ASSERT_FALSE(ent->controllers().empty());
+            for (sc::AutonomyPtr &autonomy : ent->autonomies()) {
+                EXPECT_NE(autonomy->vars().output(),
+                          ent->controllers().front()->vars().input())
+                    << "clone_entities " << clone_entities;
+            }
+        }
+        EXPECT_TRUE(simcontrol.shutdown(false));
+    }
+}
@@ -33,6 +33,14 @@
 #include <gtest/gtest.h>
 #include <scrimmage/common/FileSearch.h>
 
+#include <sys/stat.h>
+#include <utime.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+
 #include <boost/optional.hpp>
 
 namespace sc = scrimmage;
@@ -43,3 +51,43 @@ TEST(test_angles, rotation) {
     bool success = res ? true : false;
     EXPECT_EQ(true, success);
 }
+
+TEST(test_file_search, index) {
+    char dir_template[] = "/tmp/scrimmage_test_index_XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template), nullptr);
+    const std::string dir(dir_template);
+    const std::string plugins = dir + "/plugins";
+    const std::string index = dir + "/index";
+    mkdir(plugins.c_str(), 0755);
+    mkdir((plugins + "/A").c_str(), 0755);
+    std::ofstream(plugins + "/A/A.xml").close();
+
+    // The index is only saved for directories that weren't just changed
+    auto set_old = [&]() {
+        struct utimbuf times;
+        times.actime = times.modtime = std::time(nullptr) - 10;
+        utime(plugins.c_str(), &times);
+        utime((plugins + "/A").c_str(), &times);
+    };
+    set_old();
+
+    auto find = [&](const std::string &filename) {
+        sc::FileSearch file_search;
+        file_search.set_index_dir(index);
+        std::string result;
+        return file_search.find_file(filename, "xml", plugins, result);
+    };
+    EXPECT_TRUE(find("A"));
+
+    // A file added without changing the directory's time is only found after
+    // the directory is searched again
+    std::ofstream(plugins + "/A/B.xml").close();
+    set_old();
+    EXPECT_FALSE(find("B"));
+
+    mkdir((plugins + "/C").c_str(), 0755);
+    EXPECT_TRUE(find("B"));
+
+    std::string cmd = "rm -rf " + dir;
+    EXPECT_EQ(std::system(cmd.c_str()), 0);
+}
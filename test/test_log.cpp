@@ -0,0 +1,425 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono> // NOLINT
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread> // NOLINT
+#include <vector>
+
+#include <scrimmage/log/AsyncLogWriter.h>
+#include <scrimmage/log/ChunkedLog.h>
+#include <scrimmage/log/FrameDelta.h>
+#include <scrimmage/log/Log.h>
+#include <scrimmage/log/PlaybackReader.h>
+#include <scrimmage/proto/Frame.pb.h>
+#include <scrimmage/proto/Shape.pb.h>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+namespace sp = scrimmage_proto;
+
+namespace {
+std::shared_ptr<sp::Frame> make_frame(double t, int num_contacts) {
+    auto frame = std::make_shared<sp::Frame>();
+    frame->set_time(t);
+    for (int i = 0; i < num_contacts; i++) {
+        sp::Contact *c = frame->add_contact();
+        c->mutable_id()->set_id(i + 1);
+        c->mutable_state()->mutable_position()->set_x(t + i);
+    }
+    return frame;
+}
+} // namespace
+
+TEST(test_log, async_writer_block) {
+    std::vector<double> times;
+    auto write = [&](const google::protobuf::MessageLite &msg,
+                     int) {
+        times.push_back(static_cast<const sp::Frame &>(msg).time());
+        return true;
+    };
+
+    sc::AsyncLogWriter writer(write, 4, sc::AsyncLogWriter::Policy::BLOCK);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(writer.push(make_frame(i, 1), 0));
+    }
+    writer.flush();
+    ASSERT_EQ(times.size(), 1000u);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_DOUBLE_EQ(times[i], i);
+    }
+    writer.stop();
+    EXPECT_EQ(writer.dropped(), 0u);
+}
+
+TEST(test_log, async_writer_drop) {
+    int written = 0;
+    auto write = [&](const google::protobuf::MessageLite &,
+                     int) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++written;
+        return true;
+    };
+
+    sc::AsyncLogWriter writer(write, 2, sc::AsyncLogWriter::Policy::DROP);
+    for (int i = 0; i < 100; i++) {
+        writer.push(make_frame(i, 1), 0);
+    }
+    writer.stop();
+    EXPECT_GT(writer.dropped(), 0u);
+    EXPECT_EQ(written + writer.dropped(), 100u);
+}
+
+namespace {
+void round_trip(bool chunked) {
+    char dir_template[] = "/tmp/scrimmage_test_log_XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template), nullptr);
+    std::string dir(dir_template);
+
+    {
+        sc::Log log;
+        log.set_async(true, 8);
+        log.set_chunked(chunked, 32);
+        log.init(dir, sc::Log::WRITE);
+        for (int i = 0; i < 200; i++) {
+            log.save_frame(make_frame(0.1 * i, 10));
+        }
+    }
+
+    sc::Log log;
+    log.init(dir, sc::Log::READ);
+    ASSERT_EQ(log.frames().size(), 200u);
+    EXPECT_DOUBLE_EQ(log.frames().back()->time(), 0.1 * 199);
+    EXPECT_EQ(log.frames().back()->contact_size(), 10);
+
+    for (const char *file : {"frames.bin", "shapes.bin",
+                              "utm_terrain.bin", "contact_visual.bin"}) {
+        std::remove((dir + "/" + file).c_str());
+    }
+    rmdir(dir.c_str());
+}
+} // namespace
+
+TEST(test_log, async_round_trip) {
+    round_trip(false);
+}
+
+TEST(test_log, async_chunked_round_trip) {
+    round_trip(true);
+}
+
+namespace {
+void write_stream(const std::string &filename, int num_frames) {
+    std::ofstream out(filename, std::ios::binary);
+    for (int i = 0; i < num_frames; i++) {
+        std::string bytes = make_frame(0.5 * i, 3)->SerializeAsString();
+        uint8_t header[10];
+        uint8_t *end = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+            bytes.size(), header);
+        out.write(reinterpret_cast<char *>(header), end - header);
+        out.write(bytes.data(), bytes.size());
+    }
+}
+} // namespace
+
+TEST(test_log, chunked_seek) {
+    std::string filename = "/tmp/scrimmage_test_chunked_" + std::to_string(getpid()) + ".bin";
+    {
+        sc::ChunkedLogWriter writer;
+        ASSERT_TRUE(writer.open(filename, 16));
+        for (int i = 0; i < 1000; i++) {
+            ASSERT_TRUE(writer.write(*make_frame(0.5 * i, 3), 0.5 * i));
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    ASSERT_TRUE(sc::ChunkedLogReader::is_chunked(filename));
+    sc::ChunkedLogReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    EXPECT_TRUE(reader.chunked());
+    EXPECT_EQ(reader.num_records(), 1000u);
+    EXPECT_EQ(reader.chunks().size(), 63u);
+    EXPECT_DOUBLE_EQ(reader.end_time(), 499.5);
+
+    sp::Frame frame;
+    double t;
+    ASSERT_TRUE(reader.seek(100.2));
+    ASSERT_TRUE(reader.next(frame, &t));
+    EXPECT_DOUBLE_EQ(t, 100.5);
+    EXPECT_DOUBLE_EQ(frame.time(), 100.5);
+    EXPECT_EQ(frame.contact_size(), 3);
+
+    // iterate a window
+    int count = 0;
+    ASSERT_TRUE(reader.seek(10));
+    while (reader.next(frame, &t) && t <= 20) {
+        count++;
+    }
+    EXPECT_EQ(count, 21);
+
+    ASSERT_TRUE(reader.seek_record(999));
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_DOUBLE_EQ(frame.time(), 499.5);
+    EXPECT_FALSE(reader.next(frame));
+    EXPECT_FALSE(reader.seek(1000));
+
+    std::remove(filename.c_str());
+}
+
+TEST(test_log, chunked_corrupt_header) {
+    std::string filename = "/tmp/scrimmage_test_corrupt_" + std::to_string(getpid()) + ".bin";
+    {
+        sc::ChunkedLogWriter writer;
+        ASSERT_TRUE(writer.open(filename, 16));
+        for (int i = 0; i < 100; i++) {
+            ASSERT_TRUE(writer.write(*make_frame(0.5 * i, 3), 0.5 * i));
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    // Claim a huge number of records and a huge compressed size in the first
+    // chunk's header, which follows the file magic and the chunk magic
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t num_records = 0xFFFFFFFF;
+        uint64_t size = 1ull << 60;
+        file.seekp(12);
+        file.write(reinterpret_cast<const char *>(&num_records), sizeof(num_records));
+        file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    }
+
+    sc::ChunkedLogReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    EXPECT_EQ(reader.num_records(), 100u);
+    EXPECT_FALSE(reader.seek(0));
+    EXPECT_TRUE(reader.seek(10));
+
+    // Without the footer, the chunks are scanned and the corrupt one ends
+    // the scan
+    off_t size = std::ifstream(filename, std::ios::binary | std::ios::ate).tellg();
+    ASSERT_EQ(truncate(filename.c_str(), size - 1), 0);
+    ASSERT_TRUE(reader.open(filename));
+    EXPECT_EQ(reader.num_records(), 0u);
+    EXPECT_FALSE(reader.seek(0));
+
+    std::remove(filename.c_str());
+}
+
+TEST(test_log, stream_reader) {
+    // logs written before the chunked format are indexed on open
+    std::string filename = "/tmp/scrimmage_test_stream_" + std::to_string(getpid()) + ".bin";
+    write_stream(filename, 600);
+
+    sc::ChunkedLogReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    EXPECT_FALSE(reader.chunked());
+    EXPECT_EQ(reader.num_records(), 600u);
+    EXPECT_DOUBLE_EQ(reader.start_time(), 0);
+    EXPECT_DOUBLE_EQ(reader.end_time(), 299.5);
+
+    sp::Frame frame;
+    ASSERT_TRUE(reader.seek(200));
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_DOUBLE_EQ(frame.time(), 200);
+    EXPECT_EQ(reader.record_index(), 401u);
+
+    sc::Log log;
+    ASSERT_TRUE(log.parse(filename, sc::Log::FRAMES));
+    EXPECT_EQ(log.frames().size(), 600u);
+    EXPECT_EQ(log.scrimmage_frames().size(), 600u);
+
+    std::remove(filename.c_str());
+}
+
+TEST(test_log, frame_delta) {
+    sc::FrameDeltaEncoder encoder;
+    encoder.set_keyframe_interval(25);
+    encoder.set_precision(0.01);
+    sc::FrameDeltaDecoder decoder;
+
+    for (int step = 0; step < 100; step++) {
+        // contact 1 moves, contact 2 jitters below the precision, contact 3
+        // is removed at step 40, and contact 4 is added at step 60
+        sp::Frame frame;
+        frame.set_time(step * 0.1);
+        for (int id = 1; id <= 4; id++) {
+            if ((id == 3 && step >= 40) || (id == 4 && step < 60)) continue;
+            sp::Contact *c = frame.add_contact();
+            c->mutable_id()->set_id(id);
+            double x = id == 1 ? step : id + (step % 2) * 1.0e-4;
+            c->mutable_state()->mutable_position()->set_x(x);
+            c->mutable_state()->mutable_orientation()->set_w(1);
+        }
+
+        auto encoded = encoder.encode(frame);
+        EXPECT_EQ(encoded->delta(), step % 25 != 0);
+        if (encoded->delta()) {
+            const int expected = 1 + (step == 60 ? 1 : 0);
+            EXPECT_EQ(encoded->contact_size(), expected);
+            EXPECT_EQ(encoded->removed_id_size(), step == 40 ? 1 : 0);
+        } else {
+            EXPECT_EQ(encoded->contact_size(), frame.contact_size());
+        }
+
+        auto decoded = decoder.decode(encoded);
+        sc::quantize(frame, 0.01);
+        ASSERT_EQ(decoded->contact_size(), frame.contact_size());
+        for (int i = 0; i < frame.contact_size(); i++) {
+            EXPECT_EQ(decoded->contact(i).SerializeAsString(),
+                      frame.contact(i).SerializeAsString());
+        }
+        EXPECT_DOUBLE_EQ(decoded->time(), frame.time());
+    }
+}
+
+TEST(test_log, playback_reader) {
+    std::string prefix = "/tmp/scrimmage_test_playback_" + std::to_string(getpid());
+    std::string frames_file = prefix + "_frames.bin";
+    std::string shapes_file = prefix + "_shapes.bin";
+    {
+        // delta frames with a keyframe every 10 frames, in chunks of 16, and
+        // one shapes message between each pair of frames
+        sc::FrameDeltaEncoder encoder;
+        encoder.set_keyframe_interval(10);
+        sc::ChunkedLogWriter frames, shapes;
+        ASSERT_TRUE(frames.open(frames_file, 16));
+        ASSERT_TRUE(shapes.open(shapes_file, 16));
+        for (int i = 0; i < 200; i++) {
+            auto frame = make_frame(0.5 * i, 3);
+            frame->mutable_contact(1)->mutable_state()->mutable_position()->set_x(5);
+            ASSERT_TRUE(frames.write(*encoder.encode(*frame), frame->time()));
+
+            sp::Shapes s;
+            s.set_time(0.5 * i - 0.25);
+            ASSERT_TRUE(shapes.write(s, s.time()));
+        }
+        ASSERT_TRUE(frames.close());
+        ASSERT_TRUE(shapes.close());
+    }
+
+    auto check = [](const sc::PlaybackStep &step, uint64_t index) {
+        EXPECT_EQ(step.index, index);
+        ASSERT_EQ(step.frame->contact_size(), 3);
+        EXPECT_FALSE(step.frame->delta());
+        EXPECT_DOUBLE_EQ(step.frame->time(), 0.5 * index);
+        EXPECT_DOUBLE_EQ(step.frame->contact(0).state().position().x(), 0.5 * index);
+        EXPECT_DOUBLE_EQ(step.frame->contact(1).state().position().x(), 5);
+        ASSERT_EQ(step.shapes.size(), 1u);
+        EXPECT_DOUBLE_EQ(step.shapes[0]->time(), 0.5 * index - 0.25);
+    };
+
+    sc::PlaybackReader reader(4);
+    ASSERT_TRUE(reader.open(frames_file, shapes_file));
+    EXPECT_EQ(reader.num_frames(), 200u);
+    EXPECT_DOUBLE_EQ(reader.dt(), 0.5);
+
+    sc::PlaybackStep step;
+    for (uint64_t i = 0; i < 200; i++) {
+        ASSERT_TRUE(reader.next(step));
+        check(step, i);
+    }
+    EXPECT_FALSE(reader.next(step));
+
+    // scrub backwards onto a delta frame after reaching the end
+    reader.seek_frame(37);
+    ASSERT_TRUE(reader.next(step));
+    check(step, 37);
+    ASSERT_TRUE(reader.next(step));
+    check(step, 38);
+
+    reader.seek(80.1);
+    ASSERT_TRUE(reader.next(step));
+    check(step, 161);
+
+    reader.seek_frame(40);
+    ASSERT_TRUE(reader.next(step));
+    check(step, 40);
+
+    reader.seek(1000);
+    EXPECT_FALSE(reader.next(step));
+
+    reader.close();
+    std::remove(frames_file.c_str());
+    std::remove(shapes_file.c_str());
+}
+
+TEST(test_log, merge_delta_frames) {
+    // decoding frames merged while a receiver lags gives the same contacts
+    // as decoding every frame
+    sc::FrameDeltaEncoder encoder;
+    encoder.set_keyframe_interval(20);
+    sc::FrameDeltaDecoder all, merged;
+
+    std::shared_ptr<sp::Frame> pending;
+    for (int step = 0; step < 60; step++) {
+        sp::Frame frame;
+        frame.set_time(step);
+        for (int id = 1; id <= 5; id++) {
+            // contact 3 leaves for a while, contact 4 only moves sometimes
+            if (id == 3 && step >= 13 && step < 27) continue;
+            sp::Contact *c = frame.add_contact();
+            c->mutable_id()->set_id(id);
+            c->mutable_state()->mutable_position()->set_x(id == 4 ? step / 7 : step * id);
+        }
+        auto encoded = encoder.encode(frame);
+        auto expected = all.decode(encoded);
+
+        if (pending) {
+            sc::merge_frames(*pending, *encoded);
+        } else {
+            pending = std::make_shared<sp::Frame>(*encoded);
+        }
+
+        // deliver every fifth frame
+        if (step % 5 == 4) {
+            auto decoded = merged.decode(pending);
+            pending = nullptr;
+            ASSERT_EQ(decoded->contact_size(), expected->contact_size());
+            std::map<int, std::string> a, b;
+            for (auto &c : decoded->contact()) a[c.id().id()] = c.SerializeAsString();
+            for (auto &c : expected->contact()) b[c.id().id()] = c.SerializeAsString();
+            EXPECT_EQ(a, b);
+            EXPECT_DOUBLE_EQ(decoded->time(), step);
+        }
+    }
+}
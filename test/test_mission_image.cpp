@@ -0,0 +1,121 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <scrimmage/parse/MissionImage.h>
+#include <scrimmage/parse/MissionParse.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sc = scrimmage;
+
+namespace {
+void expect_same(sc::MissionParse &xml, sc::MissionParse &image) {
+    EXPECT_EQ(xml.params(), image.params());
+    EXPECT_EQ(xml.attributes(), image.attributes());
+    EXPECT_EQ(xml.entity_descriptions(), image.entity_descriptions());
+    EXPECT_EQ(xml.entity_attributes(), image.entity_attributes());
+    EXPECT_EQ(xml.entity_params(), image.entity_params());
+    EXPECT_EQ(xml.entity_interactions(), image.entity_interactions());
+    EXPECT_EQ(xml.tend(), image.tend());
+    EXPECT_EQ(xml.dt(), image.dt());
+}
+} // namespace
+
+TEST(test_mission_image, variables) {
+    const std::string content =
+        "<runscript>\n"
+        "  <run end=\"${end=10}\" dt=\"0.1\"/>\n"
+        "  <team_info><color>1 2 ${blue=3}</color></team_info>\n"
+        "  <seed>${seed=1}${seed=2}</seed>\n"
+        "</runscript>\n";
+
+    sc::MissionImage image;
+    ASSERT_TRUE(image.compile("test.xml", content));
+    EXPECT_EQ(image.num_slots(), 3);
+    EXPECT_EQ(image.slot("blue"), 1);
+    EXPECT_EQ(image.slot("missing"), -1);
+    EXPECT_EQ(image.source(), content);
+
+    sc::MissionImage loaded;
+    ASSERT_TRUE(sc::MissionImage::is_image(image.serialize()));
+    ASSERT_FALSE(sc::MissionImage::is_image(content));
+    ASSERT_TRUE(loaded.load(image.serialize()));
+    EXPECT_EQ(loaded.mission_filename(), "test.xml");
+
+    const std::string seed = "7";
+    std::vector<const std::string *> slot_values(3, nullptr);
+    slot_values[loaded.slot("seed")] = &seed;
+    EXPECT_EQ(loaded.content(slot_values),
+              "<runscript>\n"
+              "  <run end=\"10\" dt=\"0.1\"/>\n"
+              "  <team_info><color>1 2 3</color></team_info>\n"
+              "  <seed>77</seed>\n"
+              "</runscript>\n");
+
+    EXPECT_FALSE(image.compile("test.xml", "<runscript><${tag=a}/></runscript>"));
+}
+
+TEST(test_mission_image, parse) {
+    std::string filename, content;
+    ASSERT_TRUE(sc::MissionParse::read_mission_file("benchmark-spawn", filename,
+                                                    content));
+    sc::MissionImage compiled;
+    ASSERT_TRUE(compiled.compile(filename, content));
+    EXPECT_GT(compiled.num_slots(), 0);
+
+    const std::string overrides = "count=30,gen_count=5";
+    sc::MissionParse xml;
+    xml.set_overrides(overrides);
+    xml.set_mission_content(filename, content);
+    ASSERT_TRUE(xml.parse(filename));
+
+    // The image is found by its header like an xml mission file
+    sc::MissionParse image;
+    image.set_overrides(overrides);
+    image.set_mission_content(filename, compiled.serialize());
+    ASSERT_TRUE(image.parse(filename));
+    expect_same(xml, image);
+    EXPECT_EQ(image.entity_descriptions()[0]["count"], "30");
+
+    // A loaded image is shared by the runs of a batch
+    auto loaded = std::make_shared<sc::MissionImage>();
+    ASSERT_TRUE(loaded->load(compiled.serialize()));
+    sc::MissionParse shared;
+    shared.set_overrides(overrides);
+    shared.set_mission_image(filename, loaded);
+    ASSERT_TRUE(shared.parse(filename));
+    expect_same(xml, shared);
+}
@@ -0,0 +1,174 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include <scrimmage/motion/MotionModel.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+// Frictionless spring: x = [position, velocity]
+class Spring : public sc::MotionModel {
+ public:
+    Spring() {
+        x_ = {1, 0};
+    }
+
+    void run(double dt, int steps) {
+        for (int i = 0; i < steps; i++) {
+            ode_step(dt);
+        }
+    }
+
+    void model(const vector_t &x, vector_t &dxdt, double t) override {
+        dxdt[0] = x[1];
+        dxdt[1] = -x[0];
+    }
+
+    double energy() const { return x_[0] * x_[0] + x_[1] * x_[1]; }
+
+    void set_velocity_first() { semi_implicit_indices_ = {1}; }
+
+    template <class StateT>
+    static void fixed_step(StateT &x, double dt) {
+        auto sys = [](const StateT &x, StateT &dxdt, double t) {
+            dxdt[0] = x[1];
+            dxdt[1] = -x[0];
+        };
+        ode_step(sys, x, 0, dt);
+    }
+};
+
+TEST(test_motion_model, integrators) {
+    const double dt = 0.01;
+    const int steps = 628; // about one period
+    const double expected = std::cos(dt * steps);
+
+    std::map<std::string, std::string> params;
+    Spring rk4;
+    ASSERT_TRUE(rk4.set_integrator(params));
+    EXPECT_EQ(rk4.integrator(), sc::MotionModel::Integrator::RK4);
+    rk4.run(dt, steps);
+    EXPECT_NEAR(rk4.full_state_vector()[0], expected, 1e-8);
+
+    params["integrator"] = "rk45";
+    params["integrator_abs_tol"] = "1e-10";
+    params["integrator_rel_tol"] = "1e-10";
+    Spring rk45;
+    ASSERT_TRUE(rk45.set_integrator(params));
+    rk45.run(dt, steps);
+    EXPECT_NEAR(rk45.full_state_vector()[0], expected, 1e-8);
+
+    // Semi-implicit Euler keeps the energy bounded where explicit Euler
+    // gains energy every step. It is refused for models without the
+    // velocity indices.
+    params["integrator"] = "semi_implicit_euler";
+    Spring euler, semi_implicit;
+    EXPECT_FALSE(euler.set_integrator(params));
+    euler.set_integrator(sc::MotionModel::Integrator::SEMI_IMPLICIT_EULER);
+    semi_implicit.set_velocity_first();
+    ASSERT_TRUE(semi_implicit.set_integrator(params));
+    euler.run(dt, steps * 10);
+    semi_implicit.run(dt, steps * 10);
+    EXPECT_GT(euler.energy(), 1.8);
+    EXPECT_NEAR(semi_implicit.energy(), 1.0, 0.02);
+
+    params["integrator"] = "unknown";
+    Spring unknown;
+    EXPECT_FALSE(unknown.set_integrator(params));
+}
+
+// Exponential growth with an input: x' = a * x + u
+class Input : public sc::MotionModel {
+ public:
+    Input() {
+        x_ = {1};
+    }
+
+    void run(double u, double dt) {
+        u_ = u;
+        ode_step(dt);
+    }
+
+    void model(const vector_t &x, vector_t &dxdt, double t) override {
+        dxdt[0] = a_ * x[0] + u_;
+    }
+
+    double a_ = 0.5;
+    double u_ = 0;
+};
+
+TEST(test_motion_model, rk45_inputs_change) {
+    // The input and the state change between steps, so the derivative
+    // dopri5 computed at the end of the previous step can't be reused
+    const double dt = 0.1;
+    std::map<std::string, std::string> params;
+    params["integrator"] = "rk45";
+    Input rk45;
+    ASSERT_TRUE(rk45.set_integrator(params));
+
+    for (int i = 0; i < 50; i++) {
+        double u = i % 2 == 0 ? 1 : -2;
+        double x0 = rk45.full_state_vector()[0];
+        rk45.run(u, dt);
+        double expected = (x0 + u / rk45.a_) * std::exp(rk45.a_ * dt) - u / rk45.a_;
+        ASSERT_NEAR(rk45.full_state_vector()[0], expected, 1e-9) << "step " << i;
+
+        // Rewrite the state from outside the integrator, like a restored
+        // snapshot
+        if (i % 5 == 4) {
+            rk45.full_state_vector()[0] = 1;
+        }
+    }
+}
+
+TEST(test_motion_model, fixed_size_state) {
+    const double dt = 0.01;
+    std::array<double, 2> a = {{1, 0}};
+    Eigen::Vector2d v(1, 0);
+
+    Spring rk4;
+    for (int i = 0; i < 100; i++) {
+        Spring::fixed_step(a, dt);
+        Spring::fixed_step(v, dt);
+    }
+    rk4.run(dt, 100);
+
+    EXPECT_NEAR(a[0], rk4.full_state_vector()[0], 1e-12);
+    EXPECT_NEAR(v(0), rk4.full_state_vector()[0], 1e-12);
+    EXPECT_NEAR(v(1), rk4.full_state_vector()[1], 1e-12);
+}
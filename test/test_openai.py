@@ -35,6 +35,7 @@ import copy
 import numpy as np
 import gym
 import scrimmage.utils
+import scrimmage.bindings
 
 MISSION_FILE = 'rlsimple.xml'
 TEMP_MISSION_FILE = '.rlsimple.xml'
@@ -347,6 +348,39 @@ def test_timestep():
     assert total_reward == 1
 
 
+def test_vec_env():
+    """Step several copies of a mission with one call."""
+    _write_temp_mission(x_discrete=True, ctrl_y=False, y_discrete=True,
+                        num_actors=1, end=2)
+    num_envs = 4
+    env = scrimmage.bindings.ScrimmageVecEnv(
+        TEMP_MISSION_FILE, num_envs, num_threads=2)
+
+    assert env.num_envs == num_envs
+    assert isinstance(env.action_space, gym.spaces.Discrete)
+    assert isinstance(env.observation_space, gym.spaces.Box)
+
+    obs = env.reset()
+    assert obs.shape == (num_envs, 2)
+    assert np.array_equal(obs, np.zeros((num_envs, 2)))
+
+    actions = np.ones(num_envs, dtype=int)
+    obs, rewards, dones, infos = env.step(actions)
+    assert rewards.shape == (num_envs,)
+    assert not dones.any()
+    assert len(infos) == num_envs
+    assert np.all(obs[:, 0] == obs[0, 0])
+
+    # the copies end together and start over
+    obs, rewards, dones, infos = env.step(actions)
+    assert dones.all()
+    for info in infos:
+        assert info["terminal_observation"][0] > 0
+    assert np.array_equal(obs, np.zeros((num_envs, 2)))
+
+    env.close()
+
+
 if __name__ == '__main__':
     test_one_dim_discrete()
     test_two_dim_discrete()
@@ -358,3 +392,4 @@ if __name__ == '__main__':
     test_sim_end()
     test_two_combined_veh_dim_discrete_global_sensor()
     test_timestep()
+    test_vec_env()
@@ -32,8 +32,16 @@
 
 
 #include <gtest/gtest.h>
+#include <scrimmage/common/FileSearch.h>
+#include <scrimmage/parse/ConfigParse.h>
 #include <scrimmage/parse/ParseUtils.h>
 
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
 #include <vector>
 
 #include <iostream>
@@ -140,3 +148,53 @@ TEST(test_parse_utils, get_vec_of_vecs_internal_vecs_complicated) {
     };
     EXPECT_EQ(expected_vecs, test_vecs);
 }
+
+namespace {
+void write_config(const std::string &filename, const std::string &gain) {
+    std::ofstream file(filename);
+    file << "<params><library>Test_plugin</library><gain>" << gain
+         << "</gain><item>a</item><item>b</item></params>";
+}
+} // namespace
+
+TEST(test_parse_utils, config_parse_cache) {
+    char dir_template[] = "/tmp/scrimmage_test_config_XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template), nullptr);
+    std::string dir(dir_template);
+    std::string filename = dir + "/TestConfig.xml";
+    write_config(filename, "1");
+
+    // A search path (with a slash) is used in place of an environment variable
+    sc::FileSearch file_search;
+    std::map<std::string, std::string> overrides {
+        {"gain", "2"}, {"extra", "3"}, {"item:size", "9"}, {"XML_DIR", "x"}};
+
+    sc::ConfigParse config_parse;
+    config_parse.set_required("library");
+    ASSERT_TRUE(config_parse.parse(overrides, "TestConfig", dir, file_search));
+    auto &params = config_parse.params();
+    EXPECT_EQ(params["gain"], "2");
+    EXPECT_EQ(params["extra"], "3");
+    EXPECT_EQ(params["item"], "a");
+    EXPECT_EQ(params["item_1"], "b");
+    EXPECT_EQ(params["item:size"], "2");
+    EXPECT_EQ(params["XML_DIR"], dir + "/");
+    EXPECT_EQ(params["XML_FILENAME"], filename);
+
+    // The overrides of the first parse don't change the cached file
+    sc::ConfigParse config_parse2;
+    ASSERT_TRUE(config_parse2.parse({}, "TestConfig", dir, file_search));
+    EXPECT_EQ(config_parse2.params()["gain"], "1");
+    EXPECT_EQ(config_parse2.params().count("extra"), 0u);
+
+    // The file is only read again after the cache is cleared
+    write_config(filename, "5");
+    ASSERT_TRUE(config_parse2.parse({}, "TestConfig", dir, file_search));
+    EXPECT_EQ(config_parse2.params()["gain"], "1");
+    sc::ConfigParse::clear_cache();
+    ASSERT_TRUE(config_parse2.parse({}, "TestConfig", dir, file_search));
+    EXPECT_EQ(config_parse2.params()["gain"], "5");
+
+    std::remove(filename.c_str());
+    rmdir(dir.c_str());
+}
@@ -0,0 +1,200 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <scrimmage/common/RingBuffer.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/pubsub/NetworkDevice.h>
+#include <scrimmage/pubsub/PubSub.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(test_pubsub, ring_buffer) {
+    sc::RingBuffer<int> buf;
+    EXPECT_TRUE(buf.empty());
+
+    // wrap around a few times without growing
+    for (int i = 0; i < 20; i++) {
+        buf.push_back(i);
+        buf.push_back(i + 100);
+        EXPECT_EQ(buf.front(), i);
+        buf.pop_front();
+        EXPECT_EQ(buf.front(), i + 100);
+        buf.pop_front();
+    }
+    EXPECT_EQ(buf.capacity(), 8u);
+
+    // grow while wrapped and keep fifo order
+    for (int i = 0; i < 20; i++) buf.push_back(i);
+    ASSERT_EQ(buf.size(), 20u);
+    EXPECT_EQ(buf[19], 19);
+
+    buf.drop_front(5);
+    EXPECT_EQ(buf.front(), 5);
+
+    std::vector<int> out;
+    buf.drain(out);
+    ASSERT_EQ(out.size(), 15u);
+    EXPECT_EQ(out.front(), 5);
+    EXPECT_EQ(out.back(), 19);
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(test_pubsub, queue_size) {
+    sc::NetworkDevice dev("topic", 2, true, nullptr);
+    for (int i = 0; i < 5; i++) {
+        dev.add_msg(std::make_shared<sc::Message<int>>(i));
+    }
+    EXPECT_EQ(dev.msg_list_size(), 5u);
+    dev.enforce_queue_size();
+
+    auto msgs = dev.pop_msgs<sc::Message<int>>();
+    ASSERT_EQ(msgs.size(), 2u);
+    EXPECT_EQ(msgs.front()->data, 3);
+    EXPECT_EQ(msgs.back()->data, 4);
+    EXPECT_EQ(dev.msg_list_size(), 0u);
+}
+
+TEST(test_pubsub, typed_pop) {
+    sc::NetworkDevice dev("topic", 10, false, nullptr);
+    dev.add_msg(std::make_shared<sc::Message<int>>(1));
+    dev.add_msg(std::make_shared<sc::Message<double>>(2.0));
+
+    // a tagless message of the right type is still cast
+    sc::MessageBasePtr untagged = std::make_shared<sc::Message<int>>(3);
+    untagged->type_tag = nullptr;
+    dev.add_msg(untagged);
+
+    std::vector<std::shared_ptr<sc::Message<int>>> msgs = dev.pop_msgs<int>();
+    ASSERT_EQ(msgs.size(), 2u);
+    EXPECT_EQ(msgs[0]->data, 1);
+    EXPECT_EQ(msgs[1]->data, 3);
+    EXPECT_EQ(dev.msg_list_size(), 0u);
+}
+
+TEST(test_pubsub, typed_accept) {
+    int received = 0;
+    auto callback = [&](std::shared_ptr<sc::Message<std::string>> msg) {
+        received++;
+        EXPECT_EQ(msg->data, "hello");
+    };
+    unsigned int queue_size = 10;
+    sc::Subscriber<std::string, decltype(callback)> sub(
+        "topic", queue_size, false, nullptr, callback);
+
+    auto msg = std::make_shared<sc::Message<std::string>>("hello");
+    EXPECT_EQ(msg->type_tag, sub.type_tag());
+    EXPECT_NE(msg->type_tag, sc::message_type_tag<sc::Message<int>>());
+
+    // a tagless message of the right type still takes the checked path
+    sc::MessageBasePtr untagged = std::make_shared<sc::Message<std::string>>("hello");
+    untagged->type_tag = nullptr;
+
+    sub.accept(msg);
+    sub.accept(untagged);
+    EXPECT_EQ(received, 2);
+}
+
+TEST(test_pubsub, topic_table) {
+    sc::PubSub pubsub;
+    pubsub.add_network_name("net");
+    pubsub.add_network_name("other");
+
+    auto callback = [](std::shared_ptr<sc::Message<int>> &msg) {};
+    pubsub.advertise("net", "zulu", 10, false, nullptr);
+    pubsub.advertise("other", "only_other", 10, false, nullptr);
+    pubsub.subscribe<int>("net", "alpha", callback, 10, false, nullptr);
+    pubsub.advertise("net", "alpha", 10, false, nullptr);
+    pubsub.advertise("net", "mike", 10, false, nullptr);
+
+    // ids are shared between networks and stable
+    EXPECT_EQ(pubsub.topic_id("zulu"), 0);
+    EXPECT_EQ(pubsub.topic_id("only_other"), 1);
+    EXPECT_EQ(pubsub.topic_id("alpha"), 2);
+
+    sc::TopicTable &table = pubsub.topic_table("net");
+    std::vector<std::string> names;
+    for (int id : table.topic_order()) {
+        names.push_back(table.topics()[id].name);
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"alpha", "mike", "zulu"}));
+
+    auto &alpha = table.topics()[pubsub.topic_id("alpha")];
+    EXPECT_EQ(alpha.pubs.size(), 1u);
+    EXPECT_EQ(alpha.subs.size(), 1u);
+    EXPECT_TRUE(table.topics()[pubsub.topic_id("only_other")].pubs.empty());
+
+    pubsub.clear();
+    EXPECT_TRUE(pubsub.pubs().empty());
+    EXPECT_TRUE(pubsub.topic_table("net").topics().empty());
+}
+
+namespace {
+// A network written against the name keyed step() overload
+class MapNetwork : public sc::Network {
+ public:
+    using sc::Network::step;
+    bool step(std::map<std::string, std::list<sc::NetworkDevicePtr>> &pubs,
+              std::map<std::string, std::list<sc::NetworkDevicePtr>> &subs) override {
+        for (auto &kv : pubs) pub_names.push_back(kv.first);
+        for (auto &kv : subs) sub_names.push_back(kv.first);
+        return true;
+    }
+    std::vector<std::string> pub_names;
+    std::vector<std::string> sub_names;
+};
+} // namespace
+
+TEST(test_pubsub, network_map_step) {
+    sc::PubSub pubsub;
+    pubsub.add_network_name("net");
+
+    auto callback = [](std::shared_ptr<sc::Message<int>> &msg) {};
+    pubsub.advertise("net", "zulu", 10, false, nullptr);
+    pubsub.advertise("net", "alpha", 10, false, nullptr);
+    pubsub.subscribe<int>("net", "mike", callback, 10, false, nullptr);
+
+    MapNetwork network;
+    EXPECT_TRUE(network.step(pubsub.topic_table("net")));
+    EXPECT_EQ(network.pub_names, (std::vector<std::string>{"alpha", "zulu"}));
+    EXPECT_EQ(network.sub_names, (std::vector<std::string>{"mike"}));
+}
@@ -202,3 +202,70 @@ TEST(rtree_test, nearest_n_neighbors_minus_self)
     rtree.nearest_n_neighbors(c.state()->pos_const(), rtree_neighbors, num_neighbors);
     ASSERT_EQ(rtree_neighbors.size(), num_neighbors);
 }
+
+TEST(rtree_test, team_filter)
+{
+    sc::RTree rtree;
+    std::vector<std::pair<Eigen::Vector3d, sc::ID>> entries;
+    for (int i = 0; i < 100; i++) {
+        entries.emplace_back(Eigen::Vector3d(i, 0, 0), sc::ID(i + 1, 0, i % 2 + 1));
+    }
+    rtree.update(entries);
+    ASSERT_EQ(rtree.size(), entries.size());
+
+    std::vector<sc::ID> neighbors;
+    rtree.neighbors_in_range(Eigen::Vector3d(50, 0, 0), neighbors, 10.5, -1, 1);
+    ASSERT_EQ(neighbors.size(), 11u);
+    for (sc::ID &id : neighbors) {
+        ASSERT_EQ(id.team_id(), 1);
+    }
+
+    rtree.nearest_n_neighbors(Eigen::Vector3d(50, 0, 0), neighbors, 5, -1, 2);
+    ASSERT_EQ(neighbors.size(), 5u);
+    for (sc::ID &id : neighbors) {
+        ASSERT_EQ(id.team_id(), 2);
+        ASSERT_LE(std::abs(id.id() - 1 - 50), 5);
+    }
+
+    rtree.nearest_n_neighbors(Eigen::Vector3d(50, 0, 0), neighbors, 5, -1, 3);
+    ASSERT_TRUE(neighbors.empty());
+}
+
+TEST(rtree_test, move_update_mode)
+{
+    sc::Random rand;
+    rand.seed(1);
+    auto rnd = [&]() {return rand.rng_uniform() * 1000;};
+
+    sc::RTree rebuild;
+    sc::RTree move;
+    move.set_update_mode(sc::RTree::UpdateMode::MOVE);
+
+    std::vector<std::pair<Eigen::Vector3d, sc::ID>> entries;
+    for (int i = 0; i < 1000; i++) {
+        entries.emplace_back(Eigen::Vector3d(rnd(), rnd(), rnd()), sc::ID(i, 0, 0));
+    }
+
+    for (int step = 0; step < 5; step++) {
+        // move some entities and drop the last one
+        for (auto &kv : entries) {
+            if (rand.rng_uniform() < 0.5) {
+                kv.first += Eigen::Vector3d(rnd(), rnd(), rnd()) * 0.01;
+            }
+        }
+        entries.pop_back();
+
+        rebuild.update(entries);
+        move.update(entries);
+        ASSERT_EQ(rebuild.size(), entries.size());
+        ASSERT_EQ(move.size(), entries.size());
+
+        Eigen::Vector3d pos(rnd(), rnd(), rnd());
+        std::vector<sc::ID> n1, n2;
+        rebuild.neighbors_in_range(pos, n1, 200);
+        move.neighbors_in_range(pos, n2, 200);
+        std::sort(n1.begin(), n1.end());
+        std::sort(n2.begin(), n2.end());
+        ASSERT_EQ(n1, n2);
+    }
+}
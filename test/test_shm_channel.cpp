@@ -0,0 +1,115 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <scrimmage/network/ShmChannel.h>
+#include <scrimmage/proto/Frame.pb.h>
+
+#include <unistd.h>
+
+#include <string>
+
+namespace sc = scrimmage;
+using Status = sc::ShmChannel::Status;
+
+namespace {
+std::string channel_name(const std::string &suffix) {
+    return "/scrimmage_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+scrimmage_proto::Frame make_frame(double t) {
+    scrimmage_proto::Frame frame;
+    frame.set_time(t);
+    frame.add_contact()->mutable_id()->set_id(static_cast<int>(t));
+    return frame;
+}
+} // namespace
+
+TEST(test_shm_channel, write_read) {
+    const std::string name = channel_name("rw");
+    sc::ShmChannel writer, reader;
+    ASSERT_TRUE(writer.create(name, 4, 1024));
+    ASSERT_TRUE(reader.open(name));
+    EXPECT_EQ(reader.num_slots(), 4u);
+    EXPECT_EQ(reader.count(), 0u);
+
+    scrimmage_proto::Frame frame;
+    EXPECT_EQ(reader.read(0, frame), Status::NOT_READY);
+    EXPECT_EQ(reader.read_latest(frame), Status::NOT_READY);
+
+    for (int i = 0; i < 3; i++) ASSERT_TRUE(writer.write(make_frame(i)));
+    EXPECT_EQ(reader.count(), 3u);
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(reader.read(i, frame), Status::OK);
+        EXPECT_DOUBLE_EQ(frame.time(), i);
+        EXPECT_EQ(frame.contact(0).id().id(), i);
+    }
+    EXPECT_EQ(reader.read(3, frame), Status::NOT_READY);
+
+    uint64_t n = 0;
+    ASSERT_EQ(reader.read_latest(frame, &n), Status::OK);
+    EXPECT_EQ(n, 2u);
+    EXPECT_DOUBLE_EQ(frame.time(), 2);
+
+    EXPECT_FALSE(reader.closed());
+    writer.close();
+    EXPECT_TRUE(reader.closed());
+    sc::ShmChannel gone;
+    EXPECT_FALSE(gone.open(name));
+}
+
+TEST(test_shm_channel, overwritten) {
+    const std::string name = channel_name("ow");
+    sc::ShmChannel writer, reader;
+    ASSERT_TRUE(writer.create(name, 4, 1024));
+    ASSERT_TRUE(reader.open(name));
+
+    for (int i = 0; i < 10; i++) ASSERT_TRUE(writer.write(make_frame(i)));
+
+    scrimmage_proto::Frame frame;
+    EXPECT_EQ(reader.read(0, frame), Status::OVERWRITTEN);
+    EXPECT_EQ(reader.read(5, frame), Status::OVERWRITTEN);
+    ASSERT_EQ(reader.read(6, frame), Status::OK);
+    EXPECT_DOUBLE_EQ(frame.time(), 6);
+}
+
+TEST(test_shm_channel, too_large) {
+    const std::string name = channel_name("big");
+    sc::ShmChannel writer;
+    ASSERT_TRUE(writer.create(name, 2, 16));
+
+    scrimmage_proto::Frame frame = make_frame(1);
+    for (int i = 0; i < 10; i++) frame.add_contact()->mutable_id()->set_id(i);
+    EXPECT_FALSE(writer.write(frame));
+    EXPECT_EQ(writer.count(), 0u);
+}
@@ -0,0 +1,132 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+#include <map>
+#include <string>
+
+#include <Eigen/Dense>
+
+namespace sc = scrimmage;
+
+namespace {
+std::map<int, Eigen::Vector3d> run_steps(sc::SimControl &simcontrol, int steps) {
+    for (int i = 0; i < steps && simcontrol.run_single_step(i); i++) {}
+
+    std::map<int, Eigen::Vector3d> positions;
+    for (sc::EntityPtr &ent : simcontrol.ents()) {
+        positions[ent->id().id()] = ent->state_truth()->pos();
+    }
+    return positions;
+}
+
+// Run the started mission for warmup steps, snapshot it, run it, and check
+// that restoring the snapshot repeats the run
+void check_restore(sc::SimControl &simcontrol, int warmup, bool collisions) {
+    simcontrol.mp()->set_time_warp(0);
+    simcontrol.mp()->set_enable_gui(false);
+    simcontrol.mp()->params()["display_progress"] = "false";
+    simcontrol.pause(false);
+    ASSERT_TRUE(simcontrol.start());
+
+    EXPECT_FALSE(simcontrol.restore());
+    run_steps(simcontrol, warmup);
+    ASSERT_TRUE(simcontrol.snapshot());
+    const double t0 = simcontrol.t();
+    const size_t num_ents = simcontrol.ents().size();
+
+    auto first = run_steps(simcontrol, 1000);
+    EXPECT_GT(simcontrol.t(), t0);
+    if (collisions) {
+        EXPECT_LT(first.size(), num_ents);
+    }
+
+    for (int episode = 0; episode < 2; episode++) {
+        ASSERT_TRUE(simcontrol.restore());
+        EXPECT_DOUBLE_EQ(simcontrol.t(), t0);
+        EXPECT_EQ(simcontrol.ents().size(), num_ents);
+
+        auto again = run_steps(simcontrol, 1000);
+        ASSERT_EQ(again.size(), first.size());
+        for (auto &kv : first) {
+            ASSERT_EQ(again.count(kv.first), 1u);
+            EXPECT_TRUE(again[kv.first].isApprox(kv.second, 1e-9))
+                << "entity " << kv.first << " at " << again[kv.first].transpose()
+                << " instead of " << kv.second.transpose();
+        }
+    }
+
+    simcontrol.clear_snapshot();
+    EXPECT_FALSE(simcontrol.restore());
+    EXPECT_TRUE(simcontrol.shutdown(false));
+}
+
+void set_plugin(sc::MissionParsePtr &mp, int block, const std::string &tag,
+                const std::string &name) {
+    mp->entity_descriptions()[block][tag] = name;
+    mp->entity_attributes()[block][tag]["ORIGINAL_PLUGIN_NAME"] = name;
+}
+} // namespace
+
+TEST(test_snapshot, restore) {
+    sc::SimControl simcontrol;
+    ASSERT_TRUE(simcontrol.init("straight", false));
+    // entities collide in this mission
+    check_restore(simcontrol, 0, true);
+}
+
+TEST(test_snapshot, restore_rk45) {
+    // The motion model state is written from outside the integrator on
+    // restore, so the rk45 stepper mustn't keep anything from before it.
+    // The snapshot is taken while the entities are turning.
+    sc::SimControl simcontrol;
+    ASSERT_TRUE(simcontrol.init("straight", false));
+    sc::MissionParsePtr mp = simcontrol.mp();
+    set_plugin(mp, 0, "motion_model", "Unicycle");
+    mp->entity_attributes()[0]["motion_model"]["use_pitch"] = "true";
+    mp->entity_attributes()[0]["motion_model"]["integrator"] = "rk45";
+    set_plugin(mp, 0, "controller0", "UnicyclePID");
+    set_plugin(mp, 1, "motion_model", "Unicycle");
+    mp->entity_attributes()[1]["motion_model"]["use_pitch"] = "true";
+    mp->entity_attributes()[1]["motion_model"]["integrator"] = "rk45";
+    mp->entity_attributes()[1]["motion_model"]["vel_max"] = "30";
+    set_plugin(mp, 1, "controller0", "UnicyclePID");
+    // The second block reaches the boundary and turns around after about
+    // 500 steps
+    check_restore(simcontrol, 510, true);
+}
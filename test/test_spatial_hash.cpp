@@ -0,0 +1,187 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono> // NOLINT
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <memory>
+
+#include <scrimmage/common/RTree.h>
+#include <scrimmage/common/SpatialHash.h>
+#include <scrimmage/common/Random.h>
+#include <scrimmage/common/ID.h>
+
+#include <gtest/gtest.h>
+
+using std::cout;
+using std::endl;
+namespace sc = scrimmage;
+
+typedef std::vector<std::pair<Eigen::Vector3d, sc::ID>> Entries;
+
+Entries random_entries(sc::Random &rand, int num, double range, int num_teams) {
+    Entries entries;
+    entries.reserve(num);
+    for (int i = 0; i < num; i++) {
+        Eigen::Vector3d pos(rand.rng_uniform(-range, range),
+                            rand.rng_uniform(-range, range),
+                            rand.rng_uniform(-range / 10, range / 10));
+        entries.emplace_back(pos, sc::ID(i + 1, 0, i % num_teams + 1));
+    }
+    return entries;
+}
+
+std::vector<int> sorted_ids(const std::vector<sc::ID> &ids) {
+    std::vector<int> out;
+    for (const sc::ID &id : ids) out.push_back(id.id());
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+TEST(spatial_hash_test, matches_rtree) {
+    sc::Random rand;
+    rand.seed(7);
+    Entries entries = random_entries(rand, 5000, 1000, 3);
+
+    sc::RTree rtree;
+    rtree.update(entries);
+
+    sc::RTree grid;
+    grid.set_index(std::make_shared<sc::SpatialHash>(50));
+    grid.update(entries);
+    ASSERT_EQ(grid.size(), entries.size());
+
+    std::vector<sc::ID> n1, n2;
+    for (int i = 0; i < 100; i++) {
+        const auto &query = entries[i];
+        for (double dist : {10.0, 50.0, 137.0, 5000.0}) {
+            rtree.neighbors_in_range(query.first, n1, dist, query.second.id());
+            grid.neighbors_in_range(query.first, n2, dist, query.second.id());
+            ASSERT_EQ(sorted_ids(n1), sorted_ids(n2));
+
+            rtree.neighbors_in_range(query.first, n1, dist, -1, 2);
+            grid.neighbors_in_range(query.first, n2, dist, -1, 2);
+            ASSERT_EQ(sorted_ids(n1), sorted_ids(n2));
+        }
+
+        for (unsigned int n : {1u, 10u, 100u}) {
+            rtree.nearest_n_neighbors(query.first, n1, n, query.second.id());
+            grid.nearest_n_neighbors(query.first, n2, n, query.second.id());
+            ASSERT_EQ(n1.size(), n2.size());
+            ASSERT_EQ(sorted_ids(n1), sorted_ids(n2));
+
+            rtree.nearest_n_neighbors(query.first, n1, n, -1, 3);
+            grid.nearest_n_neighbors(query.first, n2, n, -1, 3);
+            ASSERT_EQ(sorted_ids(n1), sorted_ids(n2));
+        }
+    }
+}
+
+TEST(spatial_hash_test, add_remove) {
+    sc::SpatialHash grid(10);
+    grid.add(Eigen::Vector3d(0, 0, 0), sc::ID(1, 0, 1));
+    grid.add(Eigen::Vector3d(5, 0, 0), sc::ID(2, 0, 1));
+    grid.add(Eigen::Vector3d(-25, 0, 0), sc::ID(3, 0, 2));
+    ASSERT_EQ(grid.size(), 3u);
+
+    std::vector<sc::ID> neighbors;
+    grid.neighbors_in_range(Eigen::Vector3d(0, 0, 0), neighbors, 6);
+    ASSERT_EQ(neighbors.size(), 2u);
+
+    // adding an existing ID moves the entity
+    grid.add(Eigen::Vector3d(100, 0, 0), sc::ID(2, 0, 1));
+    grid.neighbors_in_range(Eigen::Vector3d(0, 0, 0), neighbors, 6);
+    ASSERT_EQ(neighbors.size(), 1u);
+    ASSERT_EQ(grid.size(), 3u);
+
+    grid.remove(sc::ID(1, 0, 1));
+    ASSERT_EQ(grid.size(), 2u);
+    grid.nearest_n_neighbors(Eigen::Vector3d(0, 0, 0), neighbors, 1);
+    ASSERT_EQ(neighbors.size(), 1u);
+    ASSERT_EQ(neighbors.front().id(), 3);
+}
+
+// Prints build and query rates of the RTree and the SpatialHash, so it
+// doesn't run by default. Run it with --gtest_also_run_disabled_tests.
+TEST(spatial_hash_test, DISABLED_benchmark) {
+    using clock = std::chrono::high_resolution_clock;
+    auto elapsed = [](clock::time_point start) {
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    const int num_queries = 1000;
+    const double radius = 50;
+
+    cout << std::setw(8) << "entities" << std::setw(10) << "index"
+         << std::setw(16) << "builds/s" << std::setw(16) << "queries/s" << endl;
+
+    for (int num : {1000, 10000, 100000}) {
+        sc::Random rand;
+        rand.seed(num);
+
+        // keep the density constant so every query has a similar number of
+        // neighbors
+        Entries entries = random_entries(rand, num, 10 * std::sqrt(num), 1);
+
+        for (bool use_grid : {false, true}) {
+            sc::RTree rtree;
+            if (use_grid) {
+                rtree.set_index(std::make_shared<sc::SpatialHash>(radius));
+            }
+
+            const int num_builds = std::max(1, 100000 / num);
+            auto start = clock::now();
+            for (int i = 0; i < num_builds; i++) {
+                rtree.update(entries);
+            }
+            double build_rate = num_builds / elapsed(start);
+
+            std::vector<sc::ID> neighbors;
+            size_t found = 0;
+            start = clock::now();
+            for (int i = 0; i < num_queries; i++) {
+                const auto &query = entries[i % num];
+                rtree.neighbors_in_range(query.first, neighbors, radius, query.second.id());
+                found += neighbors.size();
+            }
+            double query_rate = num_queries / elapsed(start);
+
+            cout << std::setw(8) << num << std::setw(10) << (use_grid ? "grid" : "rtree")
+                 << std::setw(16) << build_rate << std::setw(16) << query_rate << endl;
+            ASSERT_EQ(rtree.size(), static_cast<unsigned int>(num));
+            ASSERT_GT(found, 0u);
+        }
+    }
+}
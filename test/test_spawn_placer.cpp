@@ -0,0 +1,136 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <scrimmage/common/ID.h>
+#include <scrimmage/simcontrol/SpawnPlacer.h>
+
+#include <random>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace sc = scrimmage;
+
+namespace {
+// Place num entities of one block and return their positions, or fewer
+// positions if the placer failed.
+std::vector<Eigen::Vector3d> place(sc::SpawnPlacer &placer, int num,
+                                   const Eigen::Vector3d &stddev) {
+    std::default_random_engine gener(1);
+    auto collision = [](const Eigen::Vector3d &) {return false;};
+    auto cancel = []() {return false;};
+    std::vector<Eigen::Vector3d> positions;
+    for (int i = 0; i < num; i++) {
+        Eigen::Vector3d pos;
+        if (!placer.place(0, Eigen::Vector3d::Zero(), stddev, false, gener,
+                          collision, cancel, pos)) {
+            break;
+        }
+        positions.push_back(pos);
+        placer.add(pos, sc::ID(i + 1, 0, 1));
+    }
+    return positions;
+}
+
+double min_distance(const std::vector<Eigen::Vector3d> &positions) {
+    double min_dist = 1e9;
+    for (size_t i = 0; i < positions.size(); i++) {
+        for (size_t j = i + 1; j < positions.size(); j++) {
+            min_dist = std::min(min_dist, (positions[i] - positions[j]).norm());
+        }
+    }
+    return min_dist;
+}
+} // namespace
+
+TEST(test_spawn_placer, variance) {
+    sc::SpawnPlacer placer;
+    placer.set_separation(10);
+    auto positions = place(placer, 200, Eigen::Vector3d(100, 100, 0));
+    ASSERT_EQ(positions.size(), 200u);
+    EXPECT_EQ(positions.front(), Eigen::Vector3d::Zero());
+    EXPECT_GE(min_distance(positions), 10);
+    for (auto &pos : positions) {
+        EXPECT_EQ(pos(2), 0);
+    }
+}
+
+TEST(test_spawn_placer, no_separation) {
+    sc::SpawnPlacer placer;
+    auto positions = place(placer, 10, Eigen::Vector3d(100, 100, 0));
+    ASSERT_EQ(positions.size(), 10u);
+    for (auto &pos : positions) {
+        EXPECT_EQ(pos, Eigen::Vector3d::Zero());
+    }
+}
+
+TEST(test_spawn_placer, poisson_disk) {
+    // A dense block: 60 entities 10 m apart within three standard deviations
+    // (60 m) of the block's position
+    const Eigen::Vector3d stddev(20, 20, 0);
+
+    sc::SpawnPlacer variance;
+    variance.set_separation(10);
+    variance.set_max_attempts(100);
+    EXPECT_LT(place(variance, 60, stddev).size(), 60u);
+
+    sc::SpawnPlacer poisson;
+    poisson.set_method(sc::SpawnPlacer::Method::PoissonDisk);
+    poisson.set_separation(10);
+    poisson.set_max_attempts(100);
+    auto positions = place(poisson, 60, stddev);
+    ASSERT_EQ(positions.size(), 60u);
+    EXPECT_GE(min_distance(positions), 10);
+    for (auto &pos : positions) {
+        EXPECT_LE(pos.norm(), 60 + 1e-9);
+        EXPECT_EQ(pos(2), 0);
+    }
+}
+
+TEST(test_spawn_placer, cancel) {
+    // Every sample collides, so only the cancel predicate ends the search
+    sc::SpawnPlacer placer;
+    std::default_random_engine gener(1);
+    int num_samples = 0;
+    auto collision = [&](const Eigen::Vector3d &) {
+        num_samples++;
+        return true;
+    };
+    auto cancel = [&]() {return num_samples >= 5;};
+    Eigen::Vector3d pos;
+    EXPECT_FALSE(placer.place(0, Eigen::Vector3d::Zero(),
+                              Eigen::Vector3d(100, 100, 0), true, gener,
+                              collision, cancel, pos));
+    EXPECT_EQ(num_samples, 5);
+}
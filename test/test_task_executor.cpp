@@ -0,0 +1,87 @@
+/*!
+ * @file
+ *
+ * @section LICENSE
+ *
+ * Copyright (C) 2017 by the Georgia Tech Research Institute (GTRI)
+ *
+ * This file is part of SCRIMMAGE.
+ *
+ *   SCRIMMAGE is free software: you can redistribute it and/or modify it under
+ *   the terms of the GNU Lesser General Public License as published by the
+ *   Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ *
+ *   SCRIMMAGE is distributed in the hope that it will be useful, but WITHOUT
+ *   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ *   License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with SCRIMMAGE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+ * @author Eric Squires <eric.squires@gtri.gatech.edu>
+ * @date 31 July 2017
+ * @version 0.1.0
+ * @brief Brief file description.
+ * @section DESCRIPTION
+ * A Long description goes here.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+
+#include <scrimmage/common/TaskExecutor.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(test_task_executor, covers_range_once) {
+    sc::TaskExecutor executor(4);
+    EXPECT_EQ(executor.num_threads(), 4);
+
+    // Run many phases back to back to exercise the barrier
+    for (size_t size : {0, 1, 3, 17, 1000, 12345}) {
+        for (int phase = 0; phase < 20; phase++) {
+            std::vector<int> counts(size, 0);
+            executor.parallel_for(size, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    counts[i]++;
+                }
+            });
+            for (size_t i = 0; i < size; i++) {
+                ASSERT_EQ(counts[i], 1) << "size " << size << ", index " << i;
+            }
+        }
+    }
+}
+
+TEST(test_task_executor, grain_and_nesting) {
+    sc::TaskExecutor executor(3);
+
+    std::atomic<int> chunks{0};
+    std::atomic<int> total{0};
+    executor.parallel_for(100, [&](size_t begin, size_t end) {
+        EXPECT_LE(end - begin, 10u);
+        chunks++;
+
+        // nested calls run serially on the calling thread
+        executor.parallel_for(end - begin, [&](size_t b, size_t e) {
+            total += static_cast<int>(e - b);
+        });
+    }, 10);
+    EXPECT_EQ(chunks, 10);
+    EXPECT_EQ(total, 100);
+}
+
+TEST(test_task_executor, single_thread) {
+    sc::TaskExecutor executor(1);
+    int total = 0;
+    executor.parallel_for(10, [&](size_t begin, size_t end) {
+        total += static_cast<int>(end - begin);
+    });
+    EXPECT_EQ(total, 10);
+}